@@ -18,6 +18,7 @@
 #include <ql/cashflows/dividend.hpp>
 #include <ql/cashflows/duration.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/cashflows/flatleg.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
 #include <ql/cashflows/indexedcashflow.hpp>
@@ -30,6 +30,7 @@
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -437,14 +438,29 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Real totalNPV = 0.0;
+        // the discount factors are retrieved from the curve in a
+        // single batch
+        std::vector<Date> dates;
+        std::vector<Real> amounts;
+        dates.reserve(leg.size()+1);
+        amounts.reserve(leg.size());
         for (const auto& i : leg) {
             if (!i->hasOccurred(settlementDate, includeSettlementDateFlows) &&
-                !i->tradingExCoupon(settlementDate))
-                totalNPV += i->amount() * discountCurve.discount(i->date());
+                !i->tradingExCoupon(settlementDate)) {
+                dates.push_back(i->date());
+                amounts.push_back(i->amount());
+            }
         }
+        const Size n = amounts.size();
+        dates.push_back(npvDate);
+        std::vector<DiscountFactor> discounts(n+1);
+        discountCurve.discount(&dates[0], &discounts[0], n+1);
 
-        return totalNPV/discountCurve.discount(npvDate);
+        Real totalNPV = 0.0;
+        for (Size i=0; i<n; ++i)
+            totalNPV += amounts[i] * discounts[i];
+
+        return totalNPV/discounts[n];
     }
 
     Real CashFlows::bps(const Leg& leg,
@@ -484,19 +500,33 @@ namespace QuantLib {
             return;
         }
 
+        std::vector<Date> dates;
+        std::vector<Real> amounts, accruals;
+        dates.reserve(leg.size()+1);
+        amounts.reserve(leg.size());
+        accruals.reserve(leg.size());
         for (const auto& i : leg) {
             CashFlow& cf = *i;
             if (!cf.hasOccurred(settlementDate,
                                 includeSettlementDateFlows) &&
                 !cf.tradingExCoupon(settlementDate)) {
                 ext::shared_ptr<Coupon> cp = ext::dynamic_pointer_cast<Coupon>(i);
-                Real df = discountCurve.discount(cf.date());
-                npv += cf.amount() * df;
-                if (cp != nullptr)
-                    bps += cp->nominal() * cp->accrualPeriod() * df;
+                dates.push_back(cf.date());
+                amounts.push_back(cf.amount());
+                accruals.push_back(cp != nullptr ?
+                                   cp->nominal() * cp->accrualPeriod() : 0.0);
             }
         }
-        DiscountFactor d = discountCurve.discount(npvDate);
+        const Size n = amounts.size();
+        dates.push_back(npvDate);
+        std::vector<DiscountFactor> discounts(n+1);
+        discountCurve.discount(&dates[0], &discounts[0], n+1);
+
+        for (Size i=0; i<n; ++i) {
+            npv += amounts[i] * discounts[i];
+            bps += accruals[i] * discounts[i];
+        }
+        DiscountFactor d = discounts[n];
         npv /= d;
         bps = basisPoint_ * bps / d;
     }
@@ -112,6 +112,7 @@ namespace QuantLib {
         Rate capletRate(Rate effectiveCap) const override;
         Real floorletPrice(Rate effectiveFloor) const override;
         Rate floorletRate(Rate effectiveFloor) const override;
+        TimingAdjustment timingAdjustment() const { return timingAdjustment_; }
 
       protected:
         Real optionletPrice(Option::Type optionType,
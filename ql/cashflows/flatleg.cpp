@@ -0,0 +1,325 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/cashflows/flatleg.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/simplecashflow.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/settings.hpp>
+#include <algorithm>
+#include <typeinfo>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        // cash flows whose amount doesn't depend on market conditions
+        bool hasFixedAmount(const CashFlow& cf) {
+            const std::type_info& type = typeid(cf);
+            return type == typeid(FixedRateCoupon)
+                || type == typeid(SimpleCashFlow)
+                || type == typeid(Redemption)
+                || type == typeid(AmortizingPayment);
+        }
+
+        // Ibor coupons whose rate is gearing times the forecast
+        // fixing plus spread
+        bool hasCompilableRate(const IborCoupon& coupon) {
+            const FloatingRateCouponPricer* pricer = coupon.pricer().get();
+            if (pricer == nullptr
+                || typeid(*pricer) != typeid(BlackIborCouponPricer))
+                return false;
+            const auto* blackPricer =
+                static_cast<const BlackIborCouponPricer*>(pricer);
+            return !coupon.isInArrears()
+                && blackPricer->timingAdjustment()
+                       == BlackIborCouponPricer::Black76;
+        }
+
+    }
+
+    FlatLeg::FlatLeg(Leg leg) : leg_(std::move(leg)) {
+        for (const auto& cf : leg_) {
+            QL_REQUIRE(cf, "null cash flow given");
+            registerWith(cf);
+        }
+    }
+
+    void FlatLeg::update() {
+        notified_ = true;
+    }
+
+    Size FlatLeg::compiledCoupons() const {
+        if (!compiled_)
+            compile();
+        else if (notified_)
+            checkPricers();
+        return fixingDates_.size();
+    }
+
+    Date FlatLeg::startDate() const {
+        QL_REQUIRE(!leg_.empty(), "empty leg");
+        if (!compiled_)
+            compile();
+        return startDate_;
+    }
+
+    Date FlatLeg::maturityDate() const {
+        QL_REQUIRE(!leg_.empty(), "empty leg");
+        if (!compiled_)
+            compile();
+        return maturityDate_;
+    }
+
+    void FlatLeg::compile() const {
+        const Size n = leg_.size();
+        paymentDates_.resize(n);
+        exCouponDates_.resize(n);
+        amounts_.assign(n, Null<Real>());
+        accruals_.assign(n, 0.0);
+        couponIndex_.assign(n, Null<Size>());
+        fixingDates_.clear();
+        fixingValueDates_.clear();
+        fixingEndDates_.clear();
+        spanningTimes_.clear();
+        gearings_.clear();
+        spreads_.clear();
+        indexOf_.clear();
+        pricers_.clear();
+        indexes_.clear();
+        startDate_ = Date::maxDate();
+        maturityDate_ = Date::minDate();
+
+        for (Size i=0; i<n; ++i) {
+            const CashFlow& cf = *leg_[i];
+            paymentDates_[i] = cf.date();
+            exCouponDates_[i] = cf.exCouponDate();
+
+            const auto* coupon = dynamic_cast<const Coupon*>(&cf);
+            if (coupon != nullptr) {
+                accruals_[i] = coupon->nominal() * coupon->accrualPeriod();
+                startDate_ = std::min(startDate_, coupon->accrualStartDate());
+                maturityDate_ = std::max(maturityDate_,
+                                         coupon->accrualEndDate());
+            } else {
+                startDate_ = std::min(startDate_, cf.date());
+                maturityDate_ = std::max(maturityDate_, cf.date());
+            }
+
+            if (hasFixedAmount(cf)) {
+                amounts_[i] = cf.amount();
+            } else if (typeid(cf) == typeid(IborCoupon)) {
+                const auto& iborCoupon = static_cast<const IborCoupon&>(cf);
+                if (hasCompilableRate(iborCoupon)) {
+                    const ext::shared_ptr<IborIndex>& index =
+                        iborCoupon.iborIndex();
+                    Size k = std::find(indexes_.begin(), indexes_.end(),
+                                       index) - indexes_.begin();
+                    if (k == indexes_.size())
+                        indexes_.push_back(index);
+                    couponIndex_[i] = fixingDates_.size();
+                    fixingDates_.push_back(iborCoupon.fixingDate());
+                    fixingValueDates_.push_back(iborCoupon.fixingValueDate());
+                    fixingEndDates_.push_back(iborCoupon.fixingEndDate());
+                    spanningTimes_.push_back(iborCoupon.spanningTime());
+                    gearings_.push_back(iborCoupon.gearing());
+                    spreads_.push_back(iborCoupon.spread());
+                    indexOf_.push_back(k);
+                }
+            }
+        }
+
+        // the pricers of all floating-rate coupons are stored, so
+        // that a change in any of them can be detected
+        floatingCoupons_.clear();
+        for (Size i=0; i<n; ++i) {
+            const auto* coupon =
+                dynamic_cast<const FloatingRateCoupon*>(leg_[i].get());
+            if (coupon != nullptr) {
+                floatingCoupons_.push_back(i);
+                pricers_.push_back(coupon->pricer().get());
+            }
+        }
+
+        compiled_ = true;
+        notified_ = false;
+    }
+
+    void FlatLeg::checkPricers() const {
+        for (Size k=0; k<floatingCoupons_.size(); ++k) {
+            const auto& coupon = static_cast<const FloatingRateCoupon&>(
+                                              *leg_[floatingCoupons_[k]]);
+            if (coupon.pricer().get() != pricers_[k]) {
+                compile();
+                return;
+            }
+        }
+        notified_ = false;
+    }
+
+    void FlatLeg::calculate(const YieldTermStructure& discountCurve,
+                            bool includeSettlementDateFlows,
+                            const Date& settlementDate,
+                            const Date& npvDate,
+                            Real& npv,
+                            Real* bps) const {
+        if (!compiled_)
+            compile();
+        else if (notified_)
+            checkPricers();
+
+        const Size n = leg_.size();
+        const Date refDate = settlementDate != Date() ?
+            settlementDate : Settings::instance().evaluationDate();
+
+        // cash flows still to be paid; as in CashFlow::hasOccurred,
+        // only the ones paid at the reference date need further checks
+        std::vector<Size> alive;
+        alive.reserve(n);
+        for (Size i=0; i<n; ++i) {
+            const Date& d = paymentDates_[i];
+            if (d < refDate)
+                continue;
+            if (d == refDate
+                && leg_[i]->hasOccurred(settlementDate,
+                                        includeSettlementDateFlows))
+                continue;
+            if (exCouponDates_[i] != Date() && exCouponDates_[i] <= refDate)
+                continue;
+            alive.push_back(i);
+        }
+        const Size m = alive.size();
+
+        // amounts; the fixings to be forecast are collected by index
+        std::vector<Real> amounts(m);
+        std::vector<std::vector<Size> > forecast(indexes_.size());
+        std::vector<Date> today(indexes_.size());
+        const bool enforceTodaysFixings =
+            Settings::instance().enforcesTodaysHistoricFixings();
+        for (Size k=0; k<m; ++k) {
+            const Size i = alive[k];
+            const Size j = couponIndex_[i];
+            if (amounts_[i] != Null<Real>()) {
+                amounts[k] = amounts_[i];
+            } else if (j != Null<Size>()) {
+                // same choice as in IborCoupon::indexFixing
+                const Size g = indexOf_[j];
+                if (today[g] == Date())
+                    today[g] = indexes_[g]->forwardingTermStructure()
+                                          ->getHistHorDate();
+                if (fixingDates_[j] > today[g]
+                    || (fixingDates_[j] == today[g] && !enforceTodaysFixings))
+                    forecast[g].push_back(k);
+                else
+                    amounts[k] = leg_[i]->amount();
+            } else {
+                amounts[k] = leg_[i]->amount();
+            }
+        }
+
+        std::vector<Date> dates;
+        std::vector<DiscountFactor> discounts;
+        for (Size g=0; g<indexes_.size(); ++g) {
+            const std::vector<Size>& coupons = forecast[g];
+            const Size p = coupons.size();
+            if (p == 0)
+                continue;
+            const Handle<YieldTermStructure>& forwardingCurve =
+                indexes_[g]->forwardingTermStructure();
+            QL_REQUIRE(!forwardingCurve.empty(),
+                       "null term structure set to this instance of "
+                       << indexes_[g]->name());
+            dates.resize(2*p);
+            discounts.resize(2*p);
+            for (Size q=0; q<p; ++q) {
+                const Size j = couponIndex_[alive[coupons[q]]];
+                dates[q] = fixingValueDates_[j];
+                dates[p+q] = fixingEndDates_[j];
+            }
+            forwardingCurve->discount(&dates[0], &discounts[0], 2*p);
+            for (Size q=0; q<p; ++q) {
+                const Size i = alive[coupons[q]];
+                const Size j = couponIndex_[i];
+                Rate fixing = (discounts[q]/discounts[p+q] - 1.0)
+                            / spanningTimes_[j];
+                Rate rate = gearings_[j] * fixing + spreads_[j];
+                amounts[coupons[q]] = rate * accruals_[i];
+            }
+        }
+
+        // discount factors at the payment dates and at the npv date
+        dates.resize(m+1);
+        discounts.resize(m+1);
+        for (Size k=0; k<m; ++k)
+            dates[k] = paymentDates_[alive[k]];
+        dates[m] = npvDate;
+        discountCurve.discount(&dates[0], &discounts[0], m+1);
+
+        npv = 0.0;
+        for (Size k=0; k<m; ++k)
+            npv += amounts[k] * discounts[k];
+        npv /= discounts[m];
+
+        if (bps != nullptr) {
+            Real result = 0.0;
+            for (Size k=0; k<m; ++k)
+                result += accruals_[alive[k]] * discounts[k];
+            *bps = 1.0e-4 * result / discounts[m];
+        }
+    }
+
+    Real FlatLeg::npv(const YieldTermStructure& discountCurve,
+                      bool includeSettlementDateFlows,
+                      Date settlementDate,
+                      Date npvDate) const {
+        if (leg_.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        Real result;
+        calculate(discountCurve, includeSettlementDateFlows,
+                  settlementDate, npvDate, result, nullptr);
+        return result;
+    }
+
+    void FlatLeg::npvbps(const YieldTermStructure& discountCurve,
+                         bool includeSettlementDateFlows,
+                         Date settlementDate,
+                         Date npvDate,
+                         Real& npv,
+                         Real& bps) const {
+        npv = bps = 0.0;
+        if (leg_.empty())
+            return;
+
+        if (npvDate == Date())
+            npvDate = settlementDate != Date() ?
+                settlementDate : Settings::instance().evaluationDate();
+
+        calculate(discountCurve, includeSettlementDateFlows,
+                  settlementDate, npvDate, npv, &bps);
+    }
+
+}
@@ -0,0 +1,127 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file flatleg.hpp
+    \brief compiled representation of a leg for fast discounting
+*/
+
+#ifndef quantlib_flat_leg_hpp
+#define quantlib_flat_leg_hpp
+
+#include <ql/cashflow.hpp>
+#include <ql/patterns/observable.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class YieldTermStructure;
+    class IborIndex;
+    class FloatingRateCouponPricer;
+
+    //! Leg compiled into arrays for fast discounting
+    /*! The data of the cash flows which don't depend on market
+        conditions (payment dates, ex-coupon dates, accrual periods
+        and nominals, and the amounts of fixed cash flows) are
+        extracted once from the leg and stored as separate arrays.
+
+        Ibor coupons priced by a BlackIborCouponPricer without
+        convexity adjustment are also compiled, together with their
+        fixing dates, index estimation periods, gearings and spreads;
+        their forecast rates are obtained from the forwarding curve in
+        a single batch of discount factors per index.  Their amounts
+        are retrieved from the coupons when their fixing is in the
+        past.  Any other cash flow is also asked for its amount, but
+        its discount factor is still calculated in the batch.
+
+        The results are the same as the ones of the corresponding
+        CashFlows methods.
+
+        The compiled leg observes its cash flows; when notified, it
+        checks at the next evaluation that the compiled coupons still
+        use the same pricers, and recompiles itself otherwise.
+    */
+    class FlatLeg : public Observer {
+      public:
+        explicit FlatLeg(Leg leg);
+        //! \name Inspectors
+        //@{
+        const Leg& leg() const { return leg_; }
+        Size size() const { return leg_.size(); }
+        //! number of Ibor coupons whose rate is compiled
+        Size compiledCoupons() const;
+        //! same as CashFlows::startDate
+        Date startDate() const;
+        //! same as CashFlows::maturityDate
+        Date maturityDate() const;
+        //@}
+        //! \name Calculations
+        //@{
+        //! same as the corresponding CashFlows::npv method
+        Real npv(const YieldTermStructure& discountCurve,
+                 bool includeSettlementDateFlows,
+                 Date settlementDate = Date(),
+                 Date npvDate = Date()) const;
+        //! same as the corresponding CashFlows::npvbps method
+        void npvbps(const YieldTermStructure& discountCurve,
+                    bool includeSettlementDateFlows,
+                    Date settlementDate,
+                    Date npvDate,
+                    Real& npv,
+                    Real& bps) const;
+        //@}
+        //! \name Observer interface
+        //@{
+        void update() override;
+        //@}
+      private:
+        void compile() const;
+        void checkPricers() const;
+        void calculate(const YieldTermStructure& discountCurve,
+                       bool includeSettlementDateFlows,
+                       const Date& settlementDate,
+                       const Date& npvDate,
+                       Real& npv,
+                       Real* bps) const;
+        Leg leg_;
+        mutable bool compiled_ = false, notified_ = false;
+        mutable Date startDate_, maturityDate_;
+        // one element per cash flow
+        mutable std::vector<Date> paymentDates_, exCouponDates_;
+        // amount for fixed cash flows, Null<Real>() otherwise
+        mutable std::vector<Real> amounts_;
+        // nominal times accrual period for coupons, 0 otherwise
+        mutable std::vector<Real> accruals_;
+        // position in the compiled coupons for Ibor coupons,
+        // Null<Size>() otherwise
+        mutable std::vector<Size> couponIndex_;
+        // one element per compiled Ibor coupon
+        mutable std::vector<Date> fixingDates_, fixingValueDates_,
+                                  fixingEndDates_;
+        mutable std::vector<Time> spanningTimes_;
+        mutable std::vector<Real> gearings_, spreads_;
+        mutable std::vector<Size> indexOf_;
+        // pricers of the floating-rate coupons when compiled
+        mutable std::vector<Size> floatingCoupons_;
+        mutable std::vector<const FloatingRateCouponPricer*> pricers_;
+        // distinct indexes of the compiled coupons
+        mutable std::vector<ext::shared_ptr<IborIndex> > indexes_;
+    };
+
+}
+
+
+#endif
@@ -54,8 +54,12 @@ namespace QuantLib {
         //! \name Inspectors
         //@{
         const ext::shared_ptr<IborIndex>& iborIndex() const { return iborIndex_; }
+        //! start of the index estimation period
+        const Date& fixingValueDate() const { return fixingValueDate_; }
         //! this is dependent on usingAtParCoupons()
         const Date& fixingEndDate() const { return fixingEndDate_; }
+        //! length of the index estimation period
+        Time spanningTime() const { return spanningTime_; }
         //@}
         //! \name FloatingRateCoupon interface
         //@{
@@ -4,123 +4,178 @@
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/utilities/vectors.hpp>
-#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <algorithm>
 
 using std::vector;
 
 namespace QuantLib {
 
-    namespace {
+    void OiCouponPricerDS::initialize(const FloatingRateCoupon& coupon) {
+        coupon_ = dynamic_cast<const OiCouponDS*>(&coupon);
+        QL_ENSURE(coupon_, "wrong coupon type");
+    }
+
+    void OiCouponPricerDS::updateFixedPart(const Date& today) const {
+        ext::shared_ptr<OvernightIndex> index = ext::dynamic_pointer_cast<OvernightIndex>(coupon_->index());
+
+        // the history might have been cleared or replaced (e.g., by a
+        // thread-local view) since the last time; in that case, the
+        // notifier is a different one
+        ext::shared_ptr<Observable> notifier =
+            IndexManager::instance().notifier(index->name());
+        if (notifier != coupon_->fixingsNotifier_) {
+            if (!coupon_->fixingsObserver_)
+                coupon_->fixingsObserver_ = ext::make_shared<OiCouponDS::FixingsObserver>();
+            else if (coupon_->fixingsNotifier_)
+                coupon_->fixingsObserver_->unregisterWith(coupon_->fixingsNotifier_);
+            coupon_->fixingsObserver_->registerWith(notifier);
+            coupon_->fixingsNotifier_ = notifier;
+            coupon_->fixingsObserver_->notified = true;
+        }
+        if (!coupon_->fixingsObserver_->notified && coupon_->fixedPartDate_ == today)
+            return;
+
+        Natural rateCutoff = coupon_->rateCutoff();
+        bool isComp = coupon_->typeOI() == OiSwapIndexDS::CompoundingOI;
+        const vector<Date>& fixingDates = coupon_->fixingDates();
+        const vector<Time>& dt = coupon_->dt();
+        const TimeSeries<Real>& history = IndexManager::instance().getHistory(index->name());
+
+        Size n = dt.size(), i = 0;
+        QL_REQUIRE(rateCutoff < n, "rate cutoff (" << rateCutoff << ") must be less than number of fixings in period (" << n << ")");
+        Size nMax = n - rateCutoff - 1;//index of last overnight period that carries its own rate
+
+        Real compoundFactor = 1.0;//used only if isComp = true
+        Real avg = 0.0;//used only if isComp = false
+
+        while (i<n && fixingDates[std::min(i, nMax)]<today) {
+            // rate must have been fixed
+            Rate pastFixing = history[fixingDates[std::min(i, nMax)]];
+            QL_REQUIRE(pastFixing != Null<Real>(),
+                       "Missing " << index->name() <<
+                       " fixing for " << fixingDates[std::min(i, nMax)]);
+            if( isComp )
+                compoundFactor *= (1.0 + pastFixing*dt[i]);
+            else
+                avg += pastFixing*dt[i];
+            ++i;
+        }
 
-        class OiCouponPricerDS : public FloatingRateCouponPricer {
-          public:
-            void initialize(const FloatingRateCoupon& coupon) {
-                coupon_ = dynamic_cast<const OiCouponDS*>(&coupon);
-                QL_ENSURE(coupon_, "wrong coupon type");
+        // today is a border case
+        if (i<n && fixingDates[std::min(i, nMax)] == today) {
+            // might have been fixed
+            Rate pastFixing = history[fixingDates[std::min(i, nMax)]];
+            if (pastFixing != Null<Real>()) {
+                if( isComp )
+                    compoundFactor *= (1.0 + pastFixing*dt[i]);
+                else
+                    avg += pastFixing*dt[i];
+                ++i;
+            } else {
+                ;   // fall through and forecast
             }
-            Rate swapletRate() const {
-				Natural rateCutoff = coupon_->rateCutoff();
-				OiSwapIndexDS::TypeOI typeOI = coupon_->typeOI();
-				OiSwapIndexDS::ApproxOI approxOI = coupon_->approxOI();
-                ext::shared_ptr<OvernightIndex> index = ext::dynamic_pointer_cast<OvernightIndex>(coupon_->index());
-                const vector<Date>& fixingDates = coupon_->fixingDates();
-                const vector<Time>& dt = coupon_->dt();
-
-                Size n = dt.size(), i = 0;
-				QL_REQUIRE(rateCutoff < n, "rate cutoff (" << rateCutoff << ") must be less than number of fixings in period (" << n << ")");
-				Size nMax = n - rateCutoff - 1;//index of last overnight period that carries its own rate
-
-				bool isComp = typeOI == OiSwapIndexDS::CompoundingOI;
-                Real compoundFactor = 1.0;//used only if isComp = true
-                Real avg = 0.0;//used only if isComp = false
-
-                // already fixed part
-                Handle<YieldTermStructure> curve = index->forwardingTermStructure();
-                QL_REQUIRE(!curve.empty(), "null term structure set to this instance of " << index->name());
-				Date const & today = curve->getHistHorDate();
-                while (i<n && fixingDates[std::min(i, nMax)]<today) {
-                    // rate must have been fixed
-                    Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[std::min(i, nMax)]];
-                    QL_REQUIRE(pastFixing != Null<Real>(),
-                               "Missing " << index->name() <<
-                               " fixing for " << fixingDates[std::min(i, nMax)]);
-					if( isComp )
-						compoundFactor *= (1.0 + pastFixing*dt[i]);
-					else
-						avg += pastFixing*dt[i];
-                    ++i;
-                }
+        }
 
-                // today is a border case
-                if (i<n && fixingDates[std::min(i, nMax)] == today) {
-                    // might have been fixed
-                    try {
-                        Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[std::min(i, nMax)]];
-                        if (pastFixing != Null<Real>()) {
-							if( isComp )
-								compoundFactor *= (1.0 + pastFixing*dt[i]);
-							else
-								avg += pastFixing*dt[i];
-                            ++i;
-                        } else {
-                            ;   // fall through and forecast
-                        }
-                    } catch (Error&) {
-                        ;       // fall through and forecast
+        coupon_->fixedPeriods_ = i;
+        coupon_->fixedPart_ = isComp ? compoundFactor : avg;
+        coupon_->fixedPartDate_ = today;
+        coupon_->fixingsObserver_->notified = false;
+    }
+
+    Rate OiCouponPricerDS::swapletRate() const {
+        Natural rateCutoff = coupon_->rateCutoff();
+        OiSwapIndexDS::TypeOI typeOI = coupon_->typeOI();
+        OiSwapIndexDS::ApproxOI approxOI = coupon_->approxOI();
+        ext::shared_ptr<OvernightIndex> index = ext::dynamic_pointer_cast<OvernightIndex>(coupon_->index());
+        const vector<Time>& dt = coupon_->dt();
+
+        Size n = dt.size();
+        QL_REQUIRE(rateCutoff < n, "rate cutoff (" << rateCutoff << ") must be less than number of fixings in period (" << n << ")");
+        Size nMax = n - rateCutoff - 1;//index of last overnight period that carries its own rate
+
+        bool isComp = typeOI == OiSwapIndexDS::CompoundingOI;
+
+        // already fixed part
+        Handle<YieldTermStructure> curve = index->forwardingTermStructure();
+        QL_REQUIRE(!curve.empty(), "null term structure set to this instance of " << index->name());
+        Date const & today = curve->getHistHorDate();
+        updateFixedPart(today);
+        Size i = coupon_->fixedPeriods_;
+        Real compoundFactor = isComp ? coupon_->fixedPart_ : 1.0;//used only if isComp = true
+        Real avg = isComp ? 0.0 : coupon_->fixedPart_;//used only if isComp = false
+
+        // forward part using telescopic property in order
+        // to avoid the evaluation of multiple forward fixings
+        if (i<n) {
+            if( isComp || approxOI == OiSwapIndexDS::TakadaOI ) {
+                const vector<Date>& dates = coupon_->valueDates();//number of value dates = n+1 because the last value date is needed for defining the last overnight accrual period
+                //The dates reflect the approxOI. If the latter is telescopic => there will be only a few date elements as set in the OvernightIndexedCoupon constructor
+                DiscountFactor startDiscount = curve->discount(dates[i]);
+                Date lastFixDate = dates[nMax];
+                DiscountFactor endDiscount = rateCutoff > 0 ? curve->discount(lastFixDate) : curve->discount(dates[n]);
+                QL_REQUIRE(endDiscount != 0.0, "End discount factor cannot be 0");
+                // handle the rate cutoff period (if there is any, i.e. if rateCutoff > 0)
+                if (rateCutoff > 0) {
+                    // forward discount factor for one calendar day on the cutoff date
+                    DiscountFactor fwdDF = curve->discount(dates[nMax] + 1) / endDiscount;
+                    // keep the above forward discount factor constant during the cutoff period
+                    Natural numDays = dates[n] - dates[nMax];
+                    endDiscount *= std::pow(fwdDF, numDays);
+                }
+                if( isComp )
+                    compoundFactor *= startDiscount/endDiscount;
+                else
+                    avg += log(startDiscount / endDiscount);
+            }
+            else {
+                // the index estimation periods don't change, so they
+                // are calculated once; the fixings are then forecast
+                // from a single batch of discount factors
+                const vector<Date>& fixingDates = coupon_->fixingDates();
+                vector<Date>& d1 = coupon_->forecastStartDates_;
+                vector<Date>& d2 = coupon_->forecastEndDates_;
+                vector<Time>& t = coupon_->forecastTimes_;
+                if (t.size() != fixingDates.size()) {
+                    d1.resize(fixingDates.size());
+                    d2.resize(fixingDates.size());
+                    t.resize(fixingDates.size());
+                    for (Size k=0; k<fixingDates.size(); ++k) {
+                        d1[k] = index->valueDate(fixingDates[k]);
+                        d2[k] = index->maturityDate(d1[k]);
+                        t[k] = index->dayCounter().yearFraction(d1[k], d2[k]);
+                        QL_REQUIRE(t[k] > 0.0,
+                                   "cannot calculate forward rate between " <<
+                                   d1[k] << " and " << d2[k]);
                     }
                 }
-
-                // forward part using telescopic property in order
-                // to avoid the evaluation of multiple forward fixings
-                if (i<n) {
-					if( isComp || approxOI == OiSwapIndexDS::TakadaOI ) {
-						const vector<Date>& dates = coupon_->valueDates();//number of value dates = n+1 because the last value date is needed for defining the last overnight accrual period
-						//The dates reflect the approxOI. If the latter is telescopic => there will be only a few date elements as set in the OvernightIndexedCoupon constructor
-						DiscountFactor startDiscount = curve->discount(dates[i]);
-						Date lastFixDate = dates[nMax];
-						DiscountFactor endDiscount = rateCutoff > 0 ? curve->discount(lastFixDate) : curve->discount(dates[n]);
-						QL_REQUIRE(endDiscount != 0.0, "End discount factor cannot be 0");
-						// handle the rate cutoff period (if there is any, i.e. if rateCutoff > 0)
-						if (rateCutoff > 0) {
-							// forward discount factor for one calendar day on the cutoff date
-							DiscountFactor fwdDF = curve->discount(dates[nMax] + 1) / endDiscount;
-							// keep the above forward discount factor constant during the cutoff period
-							Natural numDays = dates[n] - dates[nMax];
-							endDiscount *= std::pow(fwdDF, numDays);
-						}
-						if( isComp )
-							compoundFactor *= startDiscount/endDiscount;
-						else
-							avg += log(startDiscount / endDiscount);
-					}
-					else {
-						const vector<Rate>& fixings = coupon_->indexFixings();
-						const std::vector<Time>& dts = coupon_->dt();
-						while (i<n) {
-							avg += fixings[std::min(i, nMax)] * dts[i];
-							++i;
-						}
-					}
+                Size first = std::min(i, nMax), m = nMax - first + 1;
+                vector<Date> dates(2*m);
+                std::copy(d1.begin()+first, d1.begin()+first+m, dates.begin());
+                std::copy(d2.begin()+first, d2.begin()+first+m, dates.begin()+m);
+                vector<DiscountFactor> discounts(2*m);
+                curve->discount(&dates[0], &discounts[0], 2*m);
+                while (i<n) {
+                    Size k = std::min(i, nMax) - first;
+                    Rate fixing = (discounts[k]/discounts[m+k] - 1.0) / t[first+k];
+                    avg += fixing * dt[i];
+                    ++i;
                 }
-				Time t = coupon_->accrualPeriod();
-				QL_REQUIRE(t > 0.0, "Coupon accrual period should be positive");
-				Real amt = isComp ? (compoundFactor - 1.0) : avg;
-                Rate rate = amt / t;
-                return coupon_->gearing() * rate + coupon_->spread();
             }
-
-            Real swapletPrice() const { QL_FAIL("swapletPrice not available");  }
-            Real capletPrice(Rate) const { QL_FAIL("capletPrice not available"); }
-            Rate capletRate(Rate) const { QL_FAIL("capletRate not available"); }
-            Real floorletPrice(Rate) const { QL_FAIL("floorletPrice not available"); }
-            Rate floorletRate(Rate) const { QL_FAIL("floorletRate not available"); }
-          protected:
-            const OiCouponDS* coupon_;
-        };
+        }
+        Time t = coupon_->accrualPeriod();
+        QL_REQUIRE(t > 0.0, "Coupon accrual period should be positive");
+        Real amt = isComp ? (compoundFactor - 1.0) : avg;
+        Rate rate = amt / t;
+        return coupon_->gearing() * rate + coupon_->spread();
     }
 
+    Real OiCouponPricerDS::swapletPrice() const { QL_FAIL("swapletPrice not available");  }
+    Real OiCouponPricerDS::capletPrice(Rate) const { QL_FAIL("capletPrice not available"); }
+    Rate OiCouponPricerDS::capletRate(Rate) const { QL_FAIL("capletRate not available"); }
+    Real OiCouponPricerDS::floorletPrice(Rate) const { QL_FAIL("floorletPrice not available"); }
+    Rate OiCouponPricerDS::floorletRate(Rate) const { QL_FAIL("floorletRate not available"); }
+
     OiCouponDS::OiCouponDS(
 		const Date& paymentDate,
 		Real nominal,
@@ -4,6 +4,7 @@
 #define quantlib_oicouponds_hpp
 
 #include <ql/cashflows/overnightindexedcoupon.hpp>
+#include <ql/cashflows/couponpricer.hpp>
 #include <ql/indexes/oiswapindexds.hpp>
 #include <ql/time/schedule.hpp>
 
@@ -37,6 +38,55 @@ namespace QuantLib {
 		Natural rateCutoff_;
         OiSwapIndexDS::TypeOI typeOI_;
 		OiSwapIndexDS::ApproxOI approxOI_;
+        // already-fixed part of the coupon, cached by the pricer
+        // until new fixings are added or the historical horizon moves
+        friend class OiCouponPricerDS;
+        class FixingsObserver : public Observer {
+          public:
+            void update() override { notified = true; }
+            bool notified = true;
+        };
+        mutable ext::shared_ptr<Observable> fixingsNotifier_;
+        mutable ext::shared_ptr<FixingsObserver> fixingsObserver_;
+        mutable Date fixedPartDate_;
+        mutable Size fixedPeriods_ = 0;
+        mutable Real fixedPart_ = 0.0;
+        // index estimation periods of the forecast fixings
+        mutable std::vector<Date> forecastStartDates_, forecastEndDates_;
+        mutable std::vector<Time> forecastTimes_;
+    };
+
+
+    //! pricer for OiCouponDS
+    /*! Compounded coupons (and averaged ones with the Takada
+        approximation) use the telescoping property of the discount
+        factors over the unfixed part of the period, which requires
+        two discount factors (three with a rate cutoff) instead of
+        one forecast per overnight period.  The remaining averaged
+        coupons forecast their fixings from a single batch of
+        discount factors.
+
+        The compounded factor (or the sum) of the past fixings is
+        cached in the coupon.  It is calculated again only when
+        fixings are added to the index history or when the historical
+        horizon of the forwarding curve moves; therefore, a change of
+        the curve only causes the unfixed part to be calculated.
+
+        This is the pricer set on OiCouponDS instances by their
+        constructor.
+    */
+    class OiCouponPricerDS : public FloatingRateCouponPricer {
+      public:
+        void initialize(const FloatingRateCoupon& coupon) override;
+        Rate swapletRate() const override;
+        Real swapletPrice() const override;
+        Real capletPrice(Rate) const override;
+        Rate capletRate(Rate) const override;
+        Real floorletPrice(Rate) const override;
+        Rate floorletRate(Rate) const override;
+      private:
+        void updateFixedPart(const Date& today) const;
+        const OiCouponDS* coupon_ = nullptr;
     };
 
 
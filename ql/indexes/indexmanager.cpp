@@ -27,41 +27,98 @@
 #    pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
+
 using boost::algorithm::to_upper_copy;
 using std::string;
 
 namespace QuantLib {
 
+    IndexManager::history_map::iterator
+    IndexManager::find(const string& name) const {
+        auto i = data_.find(name);
+        if (i == data_.end() && base_ != nullptr && cleared_.count(name) == 0) {
+            TimeSeries<Real> history;
+            if (base_->copyHistory(name, history))
+                i = data_.insert(std::make_pair(
+                    name, ObservableValue<TimeSeries<Real> >(history))).first;
+        }
+        return i;
+    }
+
+    bool IndexManager::copyHistory(const string& name,
+                                   TimeSeries<Real>& history) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto i = find(name);
+        if (i == data_.end())
+            return false;
+        history = i->second.value();
+        return true;
+    }
+
     bool IndexManager::hasHistory(const string& name) const {
-        return data_.find(to_upper_copy(name)) != data_.end();
+        string upperName = to_upper_copy(name);
+        std::lock_guard<std::mutex> lock(mutex_);
+        return find(upperName) != data_.end();
     }
 
     const TimeSeries<Real>& IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        string upperName = to_upper_copy(name);
+        std::lock_guard<std::mutex> lock(mutex_);
+        find(upperName);
+        return data_[upperName].value();
     }
 
     void IndexManager::setHistory(const string& name, const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+        string upperName = to_upper_copy(name);
+        std::lock_guard<std::mutex> lock(mutex_);
+        find(upperName);
+        data_[upperName] = history;
     }
 
     ext::shared_ptr<Observable> IndexManager::notifier(const string& name) const {
-        return data_[to_upper_copy(name)];
+        string upperName = to_upper_copy(name);
+        std::lock_guard<std::mutex> lock(mutex_);
+        find(upperName);
+        return data_[upperName];
     }
 
     std::vector<string> IndexManager::histories() const {
         std::vector<string> temp;
+        std::lock_guard<std::mutex> lock(mutex_);
         temp.reserve(data_.size());
         for (history_map::const_iterator i = data_.begin(); i != data_.end(); ++i)
             temp.push_back(i->first);
+        if (base_ != nullptr) {
+            std::vector<string> viewed = base_->histories();
+            for (auto& name : viewed) {
+                if (data_.count(name) == 0 && cleared_.count(name) == 0)
+                    temp.push_back(name);
+            }
+            std::sort(temp.begin(), temp.end());
+        }
         return temp;
     }
 
-    void IndexManager::clearHistory(const string& name) { data_.erase(to_upper_copy(name)); }
+    void IndexManager::clearHistory(const string& name) {
+        string upperName = to_upper_copy(name);
+        std::lock_guard<std::mutex> lock(mutex_);
+        data_.erase(upperName);
+        if (base_ != nullptr)
+            cleared_.insert(upperName);
+    }
 
-    void IndexManager::clearHistories() { data_.clear(); }
+    void IndexManager::clearHistories() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        data_.clear();
+        cleared_.clear();
+        base_ = nullptr;
+    }
 
     bool IndexManager::hasHistoricalFixing(const std::string& name, const Date& fixingDate) const {
-        auto const& indexIter = data_.find(to_upper_copy(name));
+        string upperName = to_upper_copy(name);
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto const& indexIter = find(upperName);
         return (indexIter != data_.end()) &&
                ((*indexIter).second.value()[fixingDate] != Null<Real>());
     }
@@ -27,14 +27,27 @@
 #include <ql/patterns/singleton.hpp>
 #include <ql/timeseries.hpp>
 #include <ql/utilities/observablevalue.hpp>
+#include <mutex>
+#include <set>
 
 
 namespace QuantLib {
 
+    class ThreadLocalSettings;
+
     //! global repository for past index fixings
-    /*! \note index names are case insensitive */
+    /*! \note index names are case insensitive
+
+        \note a thread can own a view of the fixings by means of the
+              ThreadLocalSettings class.  The fixings of the viewed
+              manager are copied when first accessed, and changes
+              are not propagated back.  Lookups and copies are
+              serialized by a mutex, so that a view can be shared by
+              worker threads by means of the SharedSettings class.
+    */
     class IndexManager : public Singleton<IndexManager> {
         friend class Singleton<IndexManager>;
+        friend class ThreadLocalSettings;
 
       private:
         IndexManager() = default;
@@ -59,7 +72,17 @@ namespace QuantLib {
 
       private:
         typedef std::map<std::string, ObservableValue<TimeSeries<Real> > > history_map;
+        // looks up the fixings, copying them from the viewed manager
+        // if needed; the name must be in upper case and the mutex
+        // must be held by the caller
+        history_map::iterator find(const std::string& name) const;
+        // copies the fixings, if any, while holding the mutex
+        bool copyHistory(const std::string& name, TimeSeries<Real>&) const;
         mutable history_map data_;
+        mutable std::mutex mutex_;
+        // viewed manager, if any, and histories cleared from the view
+        const IndexManager* base_ = nullptr;
+        std::set<std::string> cleared_;
     };
 
 }
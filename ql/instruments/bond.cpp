@@ -287,6 +287,9 @@ namespace QuantLib {
 
         arguments->settlementDate = settlementDate();
         arguments->cashflows = cashflows_;
+        if (!flatCashflows_ || flatCashflows_->leg() != cashflows_)
+            flatCashflows_ = ext::make_shared<FlatLeg>(cashflows_);
+        arguments->flatCashflows = flatCashflows_;
         arguments->calendar = calendar_;
     }
 
@@ -33,6 +33,7 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/cashflow.hpp>
+#include <ql/cashflows/flatleg.hpp>
 #include <ql/compounding.hpp>
 
 #include <vector>
@@ -290,12 +291,15 @@ namespace QuantLib {
 
         Date maturityDate_, issueDate_;
         mutable Real settlementValue_;
+        mutable ext::shared_ptr<FlatLeg> flatCashflows_;
     };
 
     class Bond::arguments : public PricingEngine::arguments {
       public:
         Date settlementDate;
         Leg cashflows;
+        //! compiled cash flows, if available; see FlatLeg
+        ext::shared_ptr<FlatLeg> flatCashflows;
         Calendar calendar;
         void validate() const override;
     };
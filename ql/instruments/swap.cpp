@@ -90,6 +90,13 @@ namespace QuantLib {
 
         arguments->legs = legs_;
         arguments->payer = payer_;
+
+        flatLegs_.resize(legs_.size());
+        for (Size j=0; j<legs_.size(); ++j) {
+            if (!flatLegs_[j] || flatLegs_[j]->leg() != legs_[j])
+                flatLegs_[j] = ext::make_shared<FlatLeg>(legs_[j]);
+        }
+        arguments->flatLegs = flatLegs_;
     }
 
     void Swap::fetchResults(const PricingEngine::results* r) const {
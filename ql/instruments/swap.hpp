@@ -28,6 +28,7 @@
 
 #include <ql/instrument.hpp>
 #include <ql/cashflow.hpp>
+#include <ql/cashflows/flatleg.hpp>
 
 namespace QuantLib {
 
@@ -125,6 +126,9 @@ namespace QuantLib {
         mutable std::vector<Real> legBPS_;
         mutable std::vector<DiscountFactor> startDiscounts_, endDiscounts_;
         mutable DiscountFactor npvDateDiscount_;
+        // compiled when first needed, since derived classes build
+        // legs_ after the base-class constructor
+        mutable std::vector<ext::shared_ptr<FlatLeg> > flatLegs_;
     };
 
 
@@ -132,6 +136,8 @@ namespace QuantLib {
       public:
         std::vector<Leg> legs;
         std::vector<Real> payer;
+        //! compiled legs, if available; see FlatLeg
+        std::vector<ext::shared_ptr<FlatLeg> > flatLegs;
         void validate() const override;
     };
 
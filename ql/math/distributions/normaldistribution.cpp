@@ -97,6 +97,37 @@ namespace QuantLib {
     const Real InverseCumulativeNormal::x_low_ = 0.02425;
     const Real InverseCumulativeNormal::x_high_= 1.0 - x_low_;
 
+    void InverseCumulativeNormal::operator()(const Real* x, Real* y,
+                                             Size n) const {
+        // central region for all values; the loop has no branches
+        // so that it can be vectorized.
+        #pragma omp simd
+        for (Size i=0; i<n; ++i) {
+            Real z = x[i] - 0.5;
+            Real r = z*z;
+            y[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+        }
+
+        // the tails overwrite the above where needed
+        for (Size i=0; i<n; ++i) {
+            if (x[i] < x_low_ || x_high_ < x[i])
+                y[i] = tail_value(x[i]);
+        }
+
+        #ifdef REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+        for (Size i=0; i<n; ++i) {
+            const Real r =
+                (f_(y[i]) - x[i]) * M_SQRT2 * M_SQRTPI * exp(0.5*y[i]*y[i]);
+            y[i] -= r/(1+0.5*y[i]*r);
+        }
+        #endif
+
+        #pragma omp simd
+        for (Size i=0; i<n; ++i)
+            y[i] = average_ + sigma_*y[i];
+    }
+
     Real InverseCumulativeNormal::tail_value(Real x) {
         if (x <= 0.0 || x >= 1.0) {
             // try to recover if due to numerical error
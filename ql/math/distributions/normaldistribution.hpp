@@ -114,6 +114,16 @@ namespace QuantLib {
         Real operator()(Real x) const {
             return average_ + sigma_*standard_value(x);
         }
+        //! applies the function to the n values starting at \p x
+        /*! The results, which are the same as returned by the
+            scalar version, are written starting at \p y.  The
+            central region is calculated in a branch-free loop that
+            the compiler can vectorize; the tails, which are reached
+            rarely, are handled afterwards.
+
+            \pre the input and output ranges must not overlap.
+        */
+        void operator()(const Real* x, Real* y, Size n) const;
         // value for average=0, sigma=1
         /* Compared to operator(), this method avoids 2 floating point
            operations (we use average=0 and sigma=1 most of the
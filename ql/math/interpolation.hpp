@@ -65,6 +65,10 @@ namespace QuantLib {
             virtual std::vector<Real> yValues() const = 0;
             virtual bool isInRange(Real) const = 0;
             virtual Real value(Real) const = 0;
+            virtual void values(const Real* x, Real* y, Size n) const {
+                for (Size i=0; i<n; ++i)
+                    y[i] = value(x[i]);
+            }
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
@@ -113,6 +117,44 @@ namespace QuantLib {
                 else
                     return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
             }
+            /*! Hunts for the interval containing x starting from the
+                given one, as described in Numerical Recipes, 3rd
+                edition, section 3.1.1.  This should be used by
+                implementations of the values() method, which can
+                pass the interval located for the previous point;
+                queries at increasing (or decreasing) points then
+                take constant time on average.
+            */
+            Size locate(Real x, Size guess) const {
+                const Size last = xEnd_-xBegin_-2;
+                if (x < *xBegin_)
+                    return 0;
+                else if (x > *(xEnd_-1))
+                    return last;
+                // the interval is between lo and hi, with x[lo] <= x
+                // and either hi == last+1 or x < x[hi]
+                Size lo, hi, step = 1;
+                if (guess > last)
+                    guess = last;
+                if (xBegin_[guess] <= x) {
+                    lo = guess;
+                    hi = lo+1;
+                    while (hi <= last && xBegin_[hi] <= x) {
+                        lo = hi;
+                        step *= 2;
+                        hi = std::min(lo+step, last+1);
+                    }
+                } else {
+                    hi = guess;
+                    lo = hi-1;
+                    while (xBegin_[lo] > x) {
+                        hi = lo;
+                        step *= 2;
+                        lo = hi > step ? hi-step : 0;
+                    }
+                }
+                return std::upper_bound(xBegin_+lo, xBegin_+hi, x)-xBegin_-1;
+            }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
         };
@@ -124,6 +166,25 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        /*! interpolated values at the \f$ n \f$ points x, written
+            in y.  The points can be given in any order, but the
+            lookup of the intervals is fastest if they are sorted.
+        */
+        void values(const Real* x, Real* y, Size n,
+                    bool allowExtrapolation = false) const {
+            if (n == 0)
+                return;
+            if (!allowExtrapolation && !allowsExtrapolation()) {
+                Real xMin = x[0], xMax = x[0];
+                for (Size i=1; i<n; ++i) {
+                    xMin = std::min(xMin, x[i]);
+                    xMax = std::max(xMax, x[i]);
+                }
+                checkRange(xMin, false);
+                checkRange(xMax, false);
+            }
+            impl_->values(x, y, n);
+        }
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
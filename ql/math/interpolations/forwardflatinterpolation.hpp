@@ -89,6 +89,17 @@ namespace QuantLib {
                 Size i = this->locate(x);
                 return this->yBegin_[i];
             }
+            void values(const Real* x, Real* y, Size n) const override {
+                Size i = 0;
+                for (Size k=0; k<n; ++k) {
+                    if (x[k] >= this->xBegin_[n_-1]) {
+                        y[k] = this->yBegin_[n_-1];
+                    } else {
+                        i = this->locate(x[k], i);
+                        y[k] = this->yBegin_[i];
+                    }
+                }
+            }
             Real primitive(Real x) const override {
                 Size i = this->locate(x);
                 Real dx = x-this->xBegin_[i];
@@ -377,6 +377,11 @@ namespace QuantLib {
                 interpolation_.update();
             }
             Real value(Real x) const override { return std::exp(interpolation_(x, true)); }
+            void values(const Real* x, Real* y, Size n) const override {
+                interpolation_.values(x, y, n, true);
+                for (Size k=0; k<n; ++k)
+                    y[k] = std::exp(y[k]);
+            }
             Real primitive(Real) const override {
                 QL_FAIL("LogInterpolation primitive not implemented");
             }
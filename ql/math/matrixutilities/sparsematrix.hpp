@@ -69,8 +69,10 @@ namespace QuantLib {
     typedef boost::numeric::ublas::matrix_reference<SparseMatrix>
         SparseMatrixReference;
 
-    inline Disposable<Array> prod(const SparseMatrix& A, const Array& x) {
-        Array b(x.size(), 0.0);
+    inline void prod(const SparseMatrix& A, const Array& x, Array& b) {
+        QL_REQUIRE(&x != &b, "result must not overwrite the argument");
+        b.resize(x.size());
+        std::fill(b.begin(), b.end(), 0.0);
 
         for (Size i=0; i < A.filled1()-1; ++i) {
             const Size begin = A.index1_data()[i];
@@ -82,6 +84,11 @@ namespace QuantLib {
 
             b[i]=t;
         }
+    }
+
+    inline Disposable<Array> prod(const SparseMatrix& A, const Array& x) {
+        Array b(x.size());
+        prod(A, x, b);
         return b;
     }
 }
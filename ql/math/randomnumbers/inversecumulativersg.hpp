@@ -26,11 +26,31 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <boost/cstdint.hpp>
 #include <utility>
 #include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // transforms a whole sequence; distributions providing a
+        // batch version of operator() are dispatched to it.
+        template <class IC>
+        inline void applyInverseCumulative(const IC& ic, const Real* x,
+                                           Real* y, Size n) {
+            for (Size i=0; i<n; ++i)
+                y[i] = ic(x[i]);
+        }
+
+        inline void applyInverseCumulative(const InverseCumulativeNormal& ic,
+                                           const Real* x, Real* y, Size n) {
+            ic(x, y, n);
+        }
+
+    }
+
     //! Inverse cumulative random sequence generator
     /*! It uses a sequence of uniform deviate in (0, 1) as the
         source of cumulative distribution values.
@@ -44,6 +64,10 @@ namespace QuantLib {
             USG::sample_type USG::nextSequence() const;
             Size USG::dimension() const;
         \endcode
+        and, if the skip method is used,
+        \code
+            void USG::skip(boost::uint_least64_t n);
+        \endcode
 
         The inverse cumulative distribution is supplied by IC.
 
@@ -62,6 +86,10 @@ namespace QuantLib {
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return x_; }
+        //! skips the next n samples
+        void skip(boost::uint_least64_t n) {
+            uniformSequenceGenerator_.skip(n);
+        }
         Size dimension() const { return dimension_; }
 		//********************************************************************************************************************************************************
 		//DERISCOPE: Added accessor to the USG object in order to allow access to the SobolRsg inside it (if applicable) and call its setDigitalShift() method.
@@ -87,12 +115,11 @@ namespace QuantLib {
     template <class USG, class IC>
     inline const typename InverseCumulativeRsg<USG, IC>::sample_type&
     InverseCumulativeRsg<USG, IC>::nextSequence() const {
-        typename USG::sample_type sample =
+        const typename USG::sample_type& sample =
             uniformSequenceGenerator_.nextSequence();
         x_.weight = sample.weight;
-        for (Size i = 0; i < dimension_; i++) {
-            x_.value[i] = ICD_(sample.value[i]);
-        }
+        detail::applyInverseCumulative(ICD_, sample.value.data(),
+                                       x_.value.data(), dimension_);
         return x_;
     }
 
@@ -68,9 +68,199 @@
 
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        // polynomials over GF(2) are stored as bit vectors, the
+        // coefficient of x^i being bit i%64 of word i/64.
+        typedef boost::uint64_t word;
+        typedef std::vector<word> polynomial;
+
+        // degree of the characteristic polynomial, i.e., the
+        // number of bits in the state of the generator
+        const Size degree = 19937;
+        const Size polynomialWords = degree/64 + 1;
+
+        const Size stateSize = 624, shiftSize = 397;
+        const unsigned long matrixA = 0x9908b0dfUL,
+                            upperMask = 0x80000000UL,
+                            lowerMask = 0x7fffffffUL;
+
+        bool testBit(const polynomial& p, Size i) {
+            return ((p[i/64] >> (i%64)) & 1) != 0;
+        }
+
+        void flipBit(polynomial& p, Size i) {
+            p[i/64] ^= word(1) << (i%64);
+        }
+
+        bool parity(word x) {
+            x ^= x >> 32;
+            x ^= x >> 16;
+            x ^= x >> 8;
+            x ^= x >> 4;
+            x ^= x >> 2;
+            x ^= x >> 1;
+            return (x & 1) != 0;
+        }
+
+        /* Advances by one step the state stored as a circular
+           buffer of the last stateSize raw outputs; the oldest
+           output is at position i, where the new one is stored.
+           This is the same recurrence implemented by twist(). */
+        void advance(unsigned long* x, Size& i) {
+            Size i1 = (i+1 == stateSize ? 0 : i+1);
+            Size im = (i+shiftSize >= stateSize ?
+                       i+shiftSize-stateSize : i+shiftSize);
+            unsigned long y = (x[i]&upperMask) | (x[i1]&lowerMask);
+            x[i] = x[im] ^ (y >> 1) ^ ((y & 0x1UL) != 0U ? matrixA : 0UL);
+            i = i1;
+        }
+
+        /* The characteristic polynomial of the recurrence is
+           obtained as the minimal polynomial of the sequence of the
+           most significant bits of the outputs, which is calculated
+           by means of the Berlekamp-Massey algorithm. */
+        polynomial characteristicPolynomial() {
+            const Size n = 2*degree;
+            const Size words = n/64 + 2;
+
+            unsigned long x[stateSize];
+            Size i = 0;
+            x[0] = 5489UL;
+            for (Size k=1; k<stateSize; ++k)
+                x[k] = (1812433253UL * (x[k-1] ^ (x[k-1] >> 30)) + k)
+                    & 0xffffffffUL;
+
+            // bit k of the sequence is stored in position n-1-k, so
+            // that the discrepancy at each step is the parity of the
+            // product of the current connection polynomial and of a
+            // contiguous block of bits.
+            polynomial s(words+1, 0);
+            for (Size k=0; k<n; ++k) {
+                Size j = i;
+                advance(x, i);
+                if (((x[j] >> 31) & 0x1UL) != 0U)
+                    flipBit(s, n-1-k);
+            }
+
+            polynomial c(words, 0), b(words, 0), t;
+            c[0] = b[0] = 1;
+            Size l = 0, m = 1;
+            for (Size k=0; k<n; ++k) {
+                Size offset = n-1-k, ws = offset/64, bs = offset%64;
+                word d = 0;
+                for (Size q=0; q<=l/64; ++q) {
+                    word v = s[ws+q] >> bs;
+                    if (bs != 0)
+                        v |= s[ws+q+1] << (64-bs);
+                    d ^= c[q] & v;
+                }
+                if (!parity(d)) {
+                    ++m;
+                    continue;
+                }
+                t = c;
+                // c += x^m b
+                Size wm = m/64, bm = m%64;
+                for (Size q=0; q+wm<words; ++q) {
+                    c[q+wm] ^= b[q] << bm;
+                    if (bm != 0 && q+wm+1 < words)
+                        c[q+wm+1] ^= b[q] >> (64-bm);
+                }
+                if (2*l <= k) {
+                    l = k+1-l;
+                    b.swap(t);
+                    m = 1;
+                } else {
+                    ++m;
+                }
+            }
+
+            QL_ENSURE(l == degree,
+                      "unexpected degree (" << l << ") of the "
+                      "characteristic polynomial");
+
+            // the characteristic polynomial is the reciprocal of
+            // the connection polynomial
+            polynomial p(polynomialWords, 0);
+            for (Size k=0; k<=l; ++k)
+                if (testBit(c, k))
+                    flipBit(p, l-k);
+            return p;
+        }
+
+        const polynomial& mersenneTwisterPolynomial() {
+            static const polynomial p = characteristicPolynomial();
+            return p;
+        }
+
+        // returns x^n mod p
+        polynomial powerOfX(boost::uint_least64_t n, const polynomial& p) {
+            // p shifted by 0 to 63 bits, used for the reduction
+            std::vector<polynomial> shifted(64,
+                                            polynomial(polynomialWords+1, 0));
+            for (Size s=0; s<64; ++s) {
+                for (Size q=0; q<polynomialWords; ++q) {
+                    shifted[s][q] ^= p[q] << s;
+                    if (s != 0)
+                        shifted[s][q+1] ^= p[q] >> (64-s);
+                }
+            }
+
+            // squaring a polynomial over GF(2) interleaves its bits
+            // with zeros; this table does it for a single byte.
+            word spread[256];
+            for (Size b=0; b<256; ++b) {
+                spread[b] = 0;
+                for (Size k=0; k<8; ++k)
+                    if (((b >> k) & 1) != 0)
+                        spread[b] |= word(1) << (2*k);
+            }
+
+            polynomial r(polynomialWords, 0), t(2*polynomialWords+1, 0);
+            r[0] = 1;
+            int top = 63;
+            while (top >= 0 && ((n >> top) & 1) == 0)
+                --top;
+            for (int bit=top; bit>=0; --bit) {
+                // t = r^2
+                for (Size q=0; q<polynomialWords; ++q) {
+                    word lo = 0, hi = 0;
+                    for (Size k=0; k<4; ++k) {
+                        lo |= spread[(r[q] >> (8*k)) & 0xff] << (16*k);
+                        hi |= spread[(r[q] >> (8*k+32)) & 0xff] << (16*k);
+                    }
+                    t[2*q] = lo;
+                    t[2*q+1] = hi;
+                }
+                t[2*polynomialWords] = 0;
+                // t = t*x if needed
+                if (((n >> bit) & 1) != 0) {
+                    for (Size q=t.size()-1; q>0; --q)
+                        t[q] = (t[q] << 1) | (t[q-1] >> 63);
+                    t[0] <<= 1;
+                }
+                // t = t mod p
+                for (Size d=2*degree; d>=degree; --d) {
+                    if (testBit(t, d)) {
+                        Size shift = d-degree;
+                        const polynomial& ps = shifted[shift%64];
+                        for (Size q=0; q<=polynomialWords; ++q)
+                            t[shift/64+q] ^= ps[q];
+                    }
+                }
+                std::copy(t.begin(), t.begin()+polynomialWords, r.begin());
+            }
+            return r;
+        }
+
+    }
+
     // constant vector a
     const unsigned long MersenneTwisterUniformRng::MATRIX_A = 0x9908b0dfUL;
     // most significant w-r bits
@@ -142,4 +332,40 @@ namespace QuantLib {
         mti = 0;
     }
 
+    void MersenneTwisterUniformRng::skip(boost::uint_least64_t n) {
+        // below this threshold, drawing the numbers is faster
+        static const boost::uint_least64_t threshold = 1 << 22;
+
+        // complete the current block; afterwards, the state array
+        // contains the last N raw outputs, which is the form used
+        // by the jump-ahead algorithm.
+        for (; n > 0 && mti != N; --n)
+            ++mti;
+        if (n < threshold) {
+            for (; n > 0; --n)
+                nextInt32();
+            return;
+        }
+
+        // if x^n = q(x) mod p(x), where p is the characteristic
+        // polynomial, the state after n steps is the combination
+        // of the states after i steps, for all i such that q_i = 1.
+        const polynomial q = powerOfX(n, mersenneTwisterPolynomial());
+        unsigned long x[N], y[N];
+        std::copy(mt, mt+N, x);
+        std::fill(y, y+N, 0UL);
+        Size i = 0;
+        for (Size k=0; k<degree; ++k) {
+            if (testBit(q, k)) {
+                for (Size j=0; j<N-i; ++j)
+                    y[j] ^= x[i+j];
+                for (Size j=N-i; j<N; ++j)
+                    y[j] ^= x[i+j-N];
+            }
+            advance(x, i);
+        }
+        std::copy(y, y+N, mt);
+        mti = N;
+    }
+
 }
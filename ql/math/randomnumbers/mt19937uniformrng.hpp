@@ -26,6 +26,7 @@
 #define quantlib_mersennetwister_uniform_rng_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <boost/cstdint.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -35,8 +36,17 @@ namespace QuantLib {
 
         For more details see http://www.math.keio.ac.jp/matumoto/emt.html
 
-        \test the correctness of the returned values is tested by
-              checking them against known good results.
+        The generator can be advanced by an arbitrary number of
+        draws in O(log n) operations by means of the skip() method;
+        this allows one to split a single sequence into
+        non-overlapping blocks, e.g., one for each thread of a
+        multithreaded simulation.
+
+        \test
+        - the correctness of the returned values is tested by
+          checking them against known good results.
+        - the correctness of skip() is tested by comparing its
+          results with those obtained by drawing the skipped numbers.
     */
     class MersenneTwisterUniformRng {
       private:
@@ -70,6 +80,16 @@ namespace QuantLib {
             y ^= (y >> 18);
             return y;
         }
+        //! skips the next n random integers
+        /*! For large n, this uses the jump-ahead algorithm based on
+            the characteristic polynomial of the generator; see
+            Haramoto, Matsumoto, Nishimura, Panneton, L'Ecuyer,
+            "Efficient jump ahead for F2-linear random number
+            generators", INFORMS Journal on Computing 20(3), 2008.
+            The cost is O(log n) polynomial multiplications plus a
+            fixed cost independent of n.
+        */
+        void skip(boost::uint_least64_t n);
       private:
         void seedInitialization(unsigned long seed);
         void twist() const;
@@ -0,0 +1,72 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/randomnumbers/philoxuniformrng.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        const boost::uint32_t multiplier0 = 0xD2511F53UL;
+        const boost::uint32_t multiplier1 = 0xCD9E8D57UL;
+        const boost::uint32_t weyl0 = 0x9E3779B9UL;
+        const boost::uint32_t weyl1 = 0xBB67AE85UL;
+        const Size rounds = 10;
+
+    }
+
+    PhiloxUniformRng::PhiloxUniformRng(boost::uint_least64_t seed,
+                                       boost::uint_least64_t stream)
+    : stream_(stream), block_(0), index_(0), valid_(false) {
+        boost::uint_least64_t s =
+            (seed != 0 ? seed : SeedGenerator::instance().get());
+        key_[0] = static_cast<boost::uint32_t>(s & 0xffffffffUL);
+        key_[1] = static_cast<boost::uint32_t>((s >> 16) >> 16);
+    }
+
+    void PhiloxUniformRng::generate() const {
+        valid_ = true;
+
+        boost::uint32_t c[4] = {
+            static_cast<boost::uint32_t>(block_ & 0xffffffffUL),
+            static_cast<boost::uint32_t>((block_ >> 32) & 0xffffffffUL),
+            static_cast<boost::uint32_t>(stream_ & 0xffffffffUL),
+            static_cast<boost::uint32_t>((stream_ >> 32) & 0xffffffffUL)
+        };
+        boost::uint32_t k0 = key_[0], k1 = key_[1];
+
+        for (Size i=0; i<rounds; ++i) {
+            boost::uint64_t p0 = boost::uint64_t(multiplier0) * c[0];
+            boost::uint64_t p1 = boost::uint64_t(multiplier1) * c[2];
+            boost::uint32_t hi0 = static_cast<boost::uint32_t>(p0 >> 32),
+                            lo0 = static_cast<boost::uint32_t>(p0),
+                            hi1 = static_cast<boost::uint32_t>(p1 >> 32),
+                            lo1 = static_cast<boost::uint32_t>(p1);
+            c[0] = hi1 ^ c[1] ^ k0;
+            c[1] = lo1;
+            c[2] = hi0 ^ c[3] ^ k1;
+            c[3] = lo0;
+            k0 += weyl0;
+            k1 += weyl1;
+        }
+
+        for (Size i=0; i<4; ++i)
+            buffer_[i] = c[i];
+    }
+
+}
@@ -0,0 +1,96 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file philoxuniformrng.hpp
+    \brief Philox counter-based uniform random number generator
+*/
+
+#ifndef quantlib_philox_uniform_rng_hpp
+#define quantlib_philox_uniform_rng_hpp
+
+#include <ql/methods/montecarlo/sample.hpp>
+#include <boost/cstdint.hpp>
+
+namespace QuantLib {
+
+    //! Counter-based uniform random number generator
+    /*! Philox-4x32-10 generator; see J.K. Salmon, M.A. Moraes,
+        R.O. Dror, D.E. Shaw, "Parallel random numbers: as easy as
+        1, 2, 3", Proceedings of the International Conference for
+        High Performance Computing, Networking, Storage and Analysis
+        (SC11), 2011.
+
+        The n-th block of four random integers is obtained by
+        applying a keyed bijection to the 128-bit counter (n, s),
+        where the key is given by the seed and s is the number of
+        the stream.  Therefore, the 2^64 streams available for a
+        given seed do not overlap, and
+        skipping ahead by any number of draws is an O(1)
+        operation.  Each stream has a period of 2^66 draws.
+
+        \test the correctness of the returned values is tested by
+              checking them against known good results.
+    */
+    class PhiloxUniformRng {
+      public:
+        typedef Sample<Real> sample_type;
+        /*! if the given seed is 0, a random seed will be chosen
+            based on clock() */
+        explicit PhiloxUniformRng(boost::uint_least64_t seed = 0,
+                                  boost::uint_least64_t stream = 0);
+        /*! returns a sample with weight 1.0 containing a random number
+            in the (0.0, 1.0) interval  */
+        sample_type next() const { return {nextReal(), 1.0}; }
+        //! return a random number in the (0.0, 1.0)-interval
+        Real nextReal() const {
+            return (Real(nextInt32()) + 0.5)/4294967296.0;
+        }
+        //! return a random integer in the [0,0xffffffff]-interval
+        unsigned long nextInt32() const {
+            if (!valid_)
+                generate();
+            unsigned long y = buffer_[index_];
+            if (++index_ == 4) {
+                index_ = 0;
+                ++block_;
+                valid_ = false;
+            }
+            return y;
+        }
+        //! skips the next n random integers
+        void skip(boost::uint_least64_t n) {
+            Size i = index_ + Size(n & 3);
+            block_ += (n >> 2) + (i >> 2);
+            index_ = i & 3;
+            valid_ = false;
+        }
+        //! stream from which the random integers are drawn
+        boost::uint_least64_t stream() const { return stream_; }
+      private:
+        void generate() const;
+        boost::uint32_t key_[2];
+        boost::uint_least64_t stream_;
+        mutable boost::uint_least64_t block_;
+        mutable Size index_;
+        mutable bool valid_;
+        mutable boost::uint32_t buffer_[4];
+    };
+
+}
+
+
+#endif
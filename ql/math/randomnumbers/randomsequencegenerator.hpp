@@ -26,6 +26,7 @@
 
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/errors.hpp>
+#include <boost/cstdint.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -43,6 +44,10 @@ namespace QuantLib {
         \code
             unsigned long RNG::nextInt32() const;
         \endcode
+        and if it wants to use the skip method, it must implement
+        \code
+            void RNG::skip(boost::uint_least64_t n);
+        \endcode
 
         \warning do not use with low-discrepancy sequence generator.
     */
@@ -83,6 +88,10 @@ namespace QuantLib {
         const sample_type& lastSequence() const {
             return sequence_;
         }
+        //! skips the next n sequences
+        void skip(boost::uint_least64_t n) {
+            rng_.skip(n*dimensionality_);
+        }
         Size dimension() const {return dimensionality_;}
       private:
         Size dimensionality_;
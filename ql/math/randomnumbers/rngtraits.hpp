@@ -28,15 +28,47 @@
 
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/philoxuniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/distributions/poissondistribution.hpp>
+#include <ql/utilities/null.hpp>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        /* builds the uniform generator for one of several streams;
+           by default, it is seeded with a value deterministically
+           derived from the given seed and stream number. */
+        template <class URNG>
+        struct StreamFactory {
+            static URNG make(BigNatural seed, Size stream) {
+                std::vector<unsigned long> keys(2);
+                keys[0] = static_cast<unsigned long>(seed);
+                keys[1] = static_cast<unsigned long>(stream);
+                MersenneTwisterUniformRng seeder(keys);
+                unsigned long streamSeed;
+                do {
+                    streamSeed = seeder.nextInt32();
+                } while (streamSeed == 0);
+                return URNG(streamSeed);
+            }
+        };
+
+        // counter-based generators provide streams natively
+        template <>
+        struct StreamFactory<PhiloxUniformRng> {
+            static PhiloxUniformRng make(BigNatural seed, Size stream) {
+                return PhiloxUniformRng(seed, stream);
+            }
+        };
+
+    }
+
     // random number traits
 
     template <class URNG, class IC>
@@ -54,6 +86,22 @@ namespace QuantLib {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /* factory for one of several independent streams, as used
+           by multithreaded simulations; stream 0 returns the same
+           sequence as the factory above, while the others are built
+           by detail::StreamFactory: they are either seeded with
+           values deterministically derived from the given seed and
+           stream number or, for counter-based generators, use the
+           native substreams of the generator. */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                Size stream) {
+            if (stream == 0 || seed == 0)
+                return make_sequence_generator(dimension, seed);
+            ursg_type g(dimension,
+                        detail::StreamFactory<URNG>::make(seed, stream));
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
         // data
         static ext::shared_ptr<IC> icInstance;
     };
@@ -77,6 +125,14 @@ namespace QuantLib {
     typedef GenericPseudoRandom<MersenneTwisterUniformRng,
                                 InverseCumulativePoisson> PoissonPseudoRandom;
 
+    //! traits for counter-based pseudo-random number generation
+    /*! Streams for multithreaded simulations are the native
+        substreams of the Philox generator, which are guaranteed
+        not to overlap.
+    */
+    typedef GenericPseudoRandom<PhiloxUniformRng,
+                                InverseCumulativeNormal> PhiloxPseudoRandom;
+
 
     template <class URSG, class IC>
     struct GenericLowDiscrepancy {
@@ -85,12 +141,29 @@ namespace QuantLib {
         typedef InverseCumulativeRsg<ursg_type,IC> rsg_type;
         // more traits
         enum { allowsErrorEstimate = 0 };
+        enum { streamLength = 1 << 24, maxStreams = 1 << 8 };
         // factory
         static rsg_type make_sequence_generator(Size dimension,
                                                 BigNatural seed) {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /* factory for one of several non-overlapping streams, as
+           used by multithreaded simulations; stream i starts at
+           draw i*streamLength of the sequence, so that streams do
+           not overlap as long as each of them provides at most
+           streamLength draws. */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                Size stream) {
+            QL_REQUIRE(stream < Size(maxStreams),
+                       "stream number (" << stream << ") out of range: "
+                       "at most " << Size(maxStreams) << " streams available");
+            ursg_type g(dimension, seed);
+            if (stream != 0)
+                g.skip(boost::uint_least64_t(stream) * streamLength);
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
         // data
         static ext::shared_ptr<IC> icInstance;
     };
@@ -104,6 +177,55 @@ namespace QuantLib {
     typedef GenericLowDiscrepancy<SobolRsg,
                                   InverseCumulativeNormal> LowDiscrepancy;
 
+
+    namespace detail {
+
+        /* number of sequences that each stream of the given traits
+           can provide without overlapping the next one; Null<Size>()
+           if unlimited. */
+        template <class RNG, class = void>
+        struct SequenceStreamLength {
+            static Size value() { return Null<Size>(); }
+        };
+
+        template <class RNG>
+        struct SequenceStreamLength<RNG, decltype(void(RNG::streamLength))> {
+            static Size value() { return Size(RNG::streamLength); }
+        };
+
+        /* dispatches to the stream-based factory of the given traits,
+           if they provide one.  Otherwise, only stream 0 is available
+           and multithreaded simulations fall back to serial sampling;
+           this allows engines to be instantiated with traits such as
+           Ziggurat that only provide the two-argument factory. */
+        template <class RNG, class = void>
+        struct SequenceStreams {
+            enum { available = 0 };
+            static typename RNG::rsg_type make(Size dimension,
+                                               BigNatural seed,
+                                               Size stream) {
+                QL_REQUIRE(stream == 0,
+                           "random-number traits do not provide "
+                           "independent streams");
+                return RNG::make_sequence_generator(dimension, seed);
+            }
+        };
+
+        template <class RNG>
+        struct SequenceStreams<
+            RNG,
+            decltype(void(RNG::make_sequence_generator(Size(), BigNatural(),
+                                                       Size())))> {
+            enum { available = 1 };
+            static typename RNG::rsg_type make(Size dimension,
+                                               BigNatural seed,
+                                               Size stream) {
+                return RNG::make_sequence_generator(dimension, seed, stream);
+            }
+        };
+
+    }
+
 }
 
 
@@ -32,16 +32,16 @@ namespace QuantLib {
         SobolRsg::DirectionIntegers directionIntegers)
     : factors_(factors), steps_(steps), dim_(factors*steps),
       seq_(sample_type::value_type(factors*steps), 1.0),
-      gen_(factors, steps, ordering, seed, directionIntegers) {
+      gen_(factors, steps, ordering, seed, directionIntegers),
+      output_(factors) {
     }
 
     const SobolBrownianBridgeRsg::sample_type&
     SobolBrownianBridgeRsg::nextSequence() const {
         gen_.nextPath();
-        std::vector<Real> output(factors_);
         for (Size i=0; i < steps_; ++i) {
-            gen_.nextStep(output);
-            std::copy(output.begin(), output.end(),
+            gen_.nextStep(output_);
+            std::copy(output_.begin(), output_.end(),
                       seq_.value.begin()+i*factors_);
         }
 
@@ -48,6 +48,7 @@ namespace QuantLib {
         const Size factors_, steps_, dim_;
         mutable sample_type seq_;
         mutable SobolBrownianGenerator gen_;
+        mutable std::vector<Real> output_;
     };
 }
 
@@ -27,6 +27,7 @@
 #define quantlib_sobol_ld_rsg_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/errors.hpp>
 #include <boost/cstdint.hpp>
 #include <vector>
 
@@ -120,6 +121,20 @@ namespace QuantLib {
                           DirectionIntegers directionIntegers = Jaeckel);
         /*! skip to the n-th sample in the low-discrepancy sequence */
         void skipTo(boost::uint_least32_t n);
+        /*! skips the next n samples in the low-discrepancy sequence.
+
+            \pre the resulting position must be within the period
+                 (2^32 samples) of the sequence.
+        */
+        void skip(boost::uint_least64_t n) {
+            // skipTo() preserves the first-draw flag, so this works
+            // whether or not the current sample was already drawn.
+            const boost::uint_least64_t last = 0xffffffffUL;
+            QL_REQUIRE(n <= last - sequenceCounter_,
+                       "cannot skip " << n << " samples: the sequence "
+                       "period would be exceeded");
+            skipTo(static_cast<boost::uint_least32_t>(sequenceCounter_ + n));
+        }
         const std::vector<boost::uint_least32_t>& nextInt32Sequence() const;
 
         const SobolRsg::sample_type& nextSequence() const {
@@ -127,11 +142,10 @@ namespace QuantLib {
 			//********************************************************************************************************************************************************
 			//DERISCOPE: Added the technique of digital shift as explained in the comments by the digitalShift_ below
 			if( digitalShift_ != 0 ) {
-				std::vector<boost::uint_least32_t> shifted_v(v);//use a separate copy so that v is not modified
-				for (Size k=0; k<dimensionality_; ++k) {
-					shifted_v[k] ^= digitalShift_;
-					sequence_.value[k] = shifted_v[k] * normalizationFactor_;
-				}
+				//the shifted integers are computed on the fly so that v is not modified and no copy is needed
+				const boost::uint_least32_t shift = static_cast<boost::uint_least32_t>(digitalShift_);
+				for (Size k=0; k<dimensionality_; ++k)
+					sequence_.value[k] = boost::uint_least32_t(v[k] ^ shift) * normalizationFactor_;
 			}
 			else {
 			//********************************************************************************************************************************************************
@@ -98,7 +98,7 @@ namespace QuantLib {
 
                 }
             }
-            corrMapT_ = corrMapTemplate_.mult(vol1*vol2);
+            corrMapTemplate_.mult(vol1*vol2, corrMapT_);
         } else {
             const Real vol1 = p1_
                     ->blackVolatility()->blackForwardVol(t1, t2, p1_->x0());
@@ -106,8 +106,8 @@ namespace QuantLib {
             const Real vol2 = p2_
                     ->blackVolatility()->blackForwardVol(t1, t2, p2_->x0());
             
-            corrMapT_ = corrMapTemplate_
-                      .mult(Array(mesher_->layout()->size(), vol1*vol2));
+            corrMapTemplate_.mult(
+                Array(mesher_->layout()->size(), vol1*vol2), corrMapT_);
         }
 
         currentForwardRate_ = p1_->riskFreeRate()
@@ -115,20 +115,43 @@ namespace QuantLib {
     }
 
     Disposable<Array> Fdm2dBlackScholesOp::apply(const Array& x) const {
-        return opX_.apply(x) + opY_.apply(x) + apply_mixed(x);
+        Array retVal(x.size());
+        applyTo(x, retVal);
+        return retVal;
+    }
+
+    void Fdm2dBlackScholesOp::applyTo(const Array& x, Array& out) const {
+        apply_mixedTo(x, out);
+        opX_.getMap().apply_add(x, out);
+        opY_.getMap().apply_add(x, out);
     }
     
     Disposable<Array> Fdm2dBlackScholesOp::apply_mixed(const Array& x) const {
-        return corrMapT_.apply(x) + currentForwardRate_*x;
+        Array retVal(x.size());
+        apply_mixedTo(x, retVal);
+        return retVal;
+    }
+
+    void Fdm2dBlackScholesOp::apply_mixedTo(const Array& x, Array& out) const {
+        corrMapT_.applyTo(x, out);
+        for (Size i=0; i < out.size(); ++i)
+            out[i] += currentForwardRate_*x[i];
     }
     
     Disposable<Array> Fdm2dBlackScholesOp::apply_direction(
                                        Size direction, const Array& x) const {
+        Array retVal(x.size());
+        apply_directionTo(direction, x, retVal);
+        return retVal;
+    }
+
+    void Fdm2dBlackScholesOp::apply_directionTo(
+                          Size direction, const Array& x, Array& out) const {
         if (direction == 0) {
-            return opX_.apply(x);
+            opX_.applyTo(x, out);
         }
         else if (direction == 1) {
-            return opY_.apply(x);
+            opY_.applyTo(x, out);
         }
         else {
             QL_FAIL("direction is too large");
@@ -137,11 +160,18 @@ namespace QuantLib {
     
     Disposable<Array> Fdm2dBlackScholesOp::solve_splitting(Size direction,
                                                const Array& x, Real s) const {
+        Array retVal(x.size());
+        solve_splittingTo(direction, x, s, retVal);
+        return retVal;
+    }
+
+    void Fdm2dBlackScholesOp::solve_splittingTo(Size direction, const Array& x,
+                                                Real s, Array& out) const {
         if (direction == 0) {
-            return opX_.solve_splitting(direction, x, s);
+            opX_.solve_splittingTo(direction, x, s, out);
         }
         else if (direction == 1) {
-            return opY_.solve_splitting(direction, x, s);
+            opY_.solve_splittingTo(direction, x, s, out);
         }
         else
             QL_FAIL("direction is too large");
@@ -54,6 +54,13 @@ namespace QuantLib {
         Disposable<Array> solve_splitting(Size direction, const Array& x, Real s) const override;
         Disposable<Array> preconditioner(const Array& r, Real s) const override;
 
+        void applyTo(const Array& x, Array& out) const override;
+        void apply_mixedTo(const Array& x, Array& out) const override;
+        void apply_directionTo(Size direction,
+                               const Array& x, Array& out) const override;
+        void solve_splittingTo(Size direction, const Array& x,
+                               Real s, Array& out) const override;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const override;
 #endif
@@ -52,6 +52,13 @@ namespace QuantLib {
         Disposable<Array> solve_splitting(Size direction, const Array& r, Real s) const override;
         Disposable<Array> preconditioner(const Array& r, Real s) const override;
 
+        void applyTo(const Array& r, Array& out) const override;
+        void apply_mixedTo(const Array& r, Array& out) const override;
+        void apply_directionTo(Size direction,
+                               const Array& r, Array& out) const override;
+        void solve_splittingTo(Size direction, const Array& r,
+                               Real s, Array& out) const override;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const override;
 #endif
@@ -114,6 +121,28 @@ namespace QuantLib {
                                                  Real s) const {
         return hestonOp_->preconditioner(r, s);
     }
+
+    inline void FdmBatesOp::applyTo(const Array& r, Array& out) const {
+        hestonOp_->applyTo(r, out);
+        out += integro(r);
+    }
+
+    inline void FdmBatesOp::apply_mixedTo(const Array& r, Array& out) const {
+        hestonOp_->apply_mixedTo(r, out);
+        out += integro(r);
+    }
+
+    inline void FdmBatesOp::apply_directionTo(Size direction,
+                                              const Array& r,
+                                              Array& out) const {
+        hestonOp_->apply_directionTo(direction, r, out);
+    }
+
+    inline void FdmBatesOp::solve_splittingTo(Size direction,
+                                              const Array& r, Real s,
+                                              Array& out) const {
+        hestonOp_->solve_splittingTo(direction, r, s, out);
+    }
     
 }
 
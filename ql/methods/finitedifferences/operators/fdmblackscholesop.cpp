@@ -76,30 +76,30 @@ namespace QuantLib {
                 }
             }
 
+            // mapT_ first holds the second-derivative part, so that no
+            // temporary operator is needed
+            dxxMap_.mult(0.5*v, mapT_);
             if (quantoHelper_ != nullptr) {
                 mapT_.axpyb(r - q - 0.5*v
                     - quantoHelper_->quantoAdjustment(Sqrt(v), t1, t2),
-                    dxMap_, dxxMap_.mult(0.5*v), Array(1, -r));
+                    dxMap_, mapT_, Array(1, -r));
             } else {
-                mapT_.axpyb(r - q - 0.5*v, dxMap_,
-                            dxxMap_.mult(0.5*v), Array(1, -r));
+                mapT_.axpyb(r - q - 0.5*v, dxMap_, mapT_, Array(1, -r));
             }
         } else {
             const Real v
                 = volTS_->blackForwardVariance(t1, t2, strike_)/(t2-t1);
 
+            dxxMap_.mult(0.5*Array(mesher_->layout()->size(), v), mapT_);
             if (quantoHelper_ != nullptr) {
                 mapT_.axpyb(
                     Array(1, r - q - 0.5*v)
                         - quantoHelper_->quantoAdjustment(
                             Array(1, std::sqrt(v)), t1, t2),
-                    dxMap_,
-                    dxxMap_.mult(0.5*Array(mesher_->layout()->size(), v)),
-                    Array(1, -r));
+                    dxMap_, mapT_, Array(1, -r));
             } else {
-                mapT_.axpyb(Array(1, r - q - 0.5*v), dxMap_,
-                    dxxMap_.mult(0.5*Array(mesher_->layout()->size(), v)),
-                    Array(1, -r));
+                mapT_.axpyb(Array(1, r - q - 0.5*v), dxMap_, mapT_,
+                            Array(1, -r));
             }
         }
     }
@@ -110,13 +110,25 @@ namespace QuantLib {
         return mapT_.apply(u);
     }
 
+    void FdmBlackScholesOp::applyTo(const Array& u, Array& out) const {
+        mapT_.applyTo(u, out);
+    }
+
     Disposable<Array> FdmBlackScholesOp::apply_direction(Size direction,
                                                     const Array& r) const {
+        Array retVal(r.size());
+        apply_directionTo(direction, r, retVal);
+        return retVal;
+    }
+
+    void FdmBlackScholesOp::apply_directionTo(Size direction,
+                                              const Array& r,
+                                              Array& out) const {
         if (direction == direction_)
-            return mapT_.apply(r);
+            mapT_.applyTo(r, out);
         else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
         }
     }
 
@@ -125,13 +137,26 @@ namespace QuantLib {
         return retVal;
     }
 
+    void FdmBlackScholesOp::apply_mixedTo(const Array& r, Array& out) const {
+        out.resize(r.size());
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
     Disposable<Array> FdmBlackScholesOp::solve_splitting(Size direction,
                                                 const Array& r, Real dt) const {
+        Array retVal(r.size());
+        solve_splittingTo(direction, r, dt, retVal);
+        return retVal;
+    }
+
+    void FdmBlackScholesOp::solve_splittingTo(Size direction,
+                                              const Array& r, Real dt,
+                                              Array& out) const {
         if (direction == direction_)
-            return mapT_.solve_splitting(r, dt, 1.0);
+            mapT_.solve_splittingTo(r, dt, 1.0, out);
         else {
-            Array retVal(r);
-            return retVal;
+            out.resize(r.size());
+            std::copy(r.begin(), r.end(), out.begin());
         }
     }
 
@@ -60,24 +60,16 @@ namespace QuantLib {
 
     Disposable<Array>
     FdmCEVOp::apply_direction(Size direction, const Array& r) const {
-        if (direction == direction_) {
-            return mapT_.apply(r);
-        }
-        else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
-        }
+        Array retVal(r.size());
+        apply_directionTo(direction, r, retVal);
+        return retVal;
     }
 
     Disposable<Array>
     FdmCEVOp::solve_splitting(Size direction, const Array& r, Real a) const {
-        if (direction == direction_) {
-            return mapT_.solve_splitting(r, a, 1.0);
-        }
-        else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
-        }
+        Array retVal(r.size());
+        solve_splittingTo(direction, r, a, retVal);
+        return retVal;
     }
 
     Disposable<Array>
@@ -85,6 +77,35 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmCEVOp::applyTo(const Array& r, Array& out) const {
+        mapT_.applyTo(r, out);
+    }
+
+    void FdmCEVOp::apply_mixedTo(const Array& r, Array& out) const {
+        out.resize(r.size());
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmCEVOp::apply_directionTo(Size direction,
+                                     const Array& r, Array& out) const {
+        if (direction == direction_)
+            mapT_.applyTo(r, out);
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmCEVOp::solve_splittingTo(Size direction, const Array& r,
+                                     Real a, Array& out) const {
+        if (direction == direction_)
+            mapT_.solve_splittingTo(r, a, 1.0, out);
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> > FdmCEVOp::toMatrixDecomp() const {
         std::vector<SparseMatrix> retVal(1, mapT_.toMatrix());
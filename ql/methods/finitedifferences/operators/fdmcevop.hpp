@@ -57,6 +57,13 @@ namespace QuantLib {
         Disposable<Array> solve_splitting(Size direction, const Array& r, Real s) const override;
         Disposable<Array> preconditioner(const Array& r, Real s) const override;
 
+        void applyTo(const Array& r, Array& out) const override;
+        void apply_mixedTo(const Array& r, Array& out) const override;
+        void apply_directionTo(Size direction,
+                               const Array& r, Array& out) const override;
+        void solve_splittingTo(Size direction, const Array& r,
+                               Real s, Array& out) const override;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const override;
 #endif
@@ -44,8 +44,9 @@ namespace QuantLib {
 
         const Real v = sigma1_->blackForwardVariance(t1, t2, strike_)/(t2-t1);
 
+        dxxMap_.mult(Array(mesher_->layout()->size(), v/2), mapT_);
         mapT_.axpyb(mesher_->locations(1) - q - 0.5*v, dxMap_,
-                        dxxMap_.mult(Array(mesher_->layout()->size(), v/2)), -0.5*mesher_->locations(1));
+                        mapT_, -0.5*mesher_->locations(1));
     }
 
     const TripleBandLinearOp& FdmCIREquityPart::getMap() const {
@@ -87,8 +88,7 @@ namespace QuantLib {
 
     void FdmCIRMixedPart::setTime(Time t1, Time t2) {
         const Real v = std::sqrt(sigma1_->blackForwardVariance(t1, t2, strike_)/(t2-t1));
-        NinePointLinearOp op(dyMap_.mult(Array(mesher_->layout()->size(), v)));
-        mapT_.swap(op);
+        dyMap_.mult(Array(mesher_->layout()->size(), v), mapT_);
     }
 
     const NinePointLinearOp& FdmCIRMixedPart::getMap() const {
@@ -127,19 +127,30 @@ namespace QuantLib {
     }
 
     Disposable<Array> FdmCIROp::apply(const Array& u) const {
-        Array dx = dxMap_.getMap().apply(u);
-        Array dy = dyMap_.getMap().apply(u);
-        Array dz = dzMap_.getMap().apply(u);
+        Array retVal(u.size());
+        applyTo(u, retVal);
+        return retVal;
+    }
 
-        return (dy + dx + dz);
+    void FdmCIROp::applyTo(const Array& u, Array& out) const {
+        dyMap_.getMap().applyTo(u, out);
+        dxMap_.getMap().apply_add(u, out);
+        dzMap_.getMap().apply_add(u, out);
     }
 
     Disposable<Array> FdmCIROp::apply_direction(Size direction,
                                                    const Array& r) const {
+        Array retVal(r.size());
+        apply_directionTo(direction, r, retVal);
+        return retVal;
+    }
+
+    void FdmCIROp::apply_directionTo(Size direction,
+                                     const Array& r, Array& out) const {
         if (direction == 0)
-            return dxMap_.getMap().apply(r);
+            dxMap_.getMap().applyTo(r, out);
         else if (direction == 1)
-            return dyMap_.getMap().apply(r);
+            dyMap_.getMap().applyTo(r, out);
         else
             QL_FAIL("direction too large");
     }
@@ -148,15 +159,25 @@ namespace QuantLib {
         return dzMap_.getMap().apply(r);
     }
 
+    void FdmCIROp::apply_mixedTo(const Array& r, Array& out) const {
+        dzMap_.getMap().applyTo(r, out);
+    }
+
     Disposable<Array>
         FdmCIROp::solve_splitting(Size direction,
                                      const Array& r, Real a) const {
+        Array retVal(r.size());
+        solve_splittingTo(direction, r, a, retVal);
+        return retVal;
+    }
 
+    void FdmCIROp::solve_splittingTo(Size direction, const Array& r,
+                                     Real a, Array& out) const {
         if (direction == 0) {
-            return dxMap_.getMap().solve_splitting(r, a, 1.0);
+            dxMap_.getMap().solve_splittingTo(r, a, 1.0, out);
         }
         else if (direction == 1) {
-            return dyMap_.getMap().solve_splitting(r, a, 1.0);
+            dyMap_.getMap().solve_splittingTo(r, a, 1.0, out);
         }
         else
             QL_FAIL("direction too large");
@@ -71,38 +71,64 @@ namespace QuantLib {
     }
 
     Disposable<Array> FdmG2Op::apply(const Array& r) const {
-        return mapX_.apply(r) + mapY_.apply(r) + apply_mixed(r);
+        Array retVal(r.size());
+        applyTo(r, retVal);
+        return retVal;
+    }
+
+    void FdmG2Op::applyTo(const Array& r, Array& out) const {
+        mapX_.applyTo(r, out);
+        mapY_.apply_add(r, out);
+        corrMap_.apply_add(r, out);
     }
 
     Disposable<Array> FdmG2Op::apply_mixed(const Array& r) const {
         return corrMap_.apply(r);
     }
 
+    void FdmG2Op::apply_mixedTo(const Array& r, Array& out) const {
+        corrMap_.applyTo(r, out);
+    }
+
     Disposable<Array>
     FdmG2Op::apply_direction(Size direction, const Array& r) const {
+        Array retVal(r.size());
+        apply_directionTo(direction, r, retVal);
+        return retVal;
+    }
+
+    void FdmG2Op::apply_directionTo(Size direction,
+                                    const Array& r, Array& out) const {
         if (direction == direction1_) {
-            return mapX_.apply(r);
+            mapX_.applyTo(r, out);
         }
         else if (direction == direction2_) {
-            return mapY_.apply(r);
+            mapY_.applyTo(r, out);
         }
         else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
         }
     }
 
     Disposable<Array>
     FdmG2Op::solve_splitting(Size direction, const Array& r, Real a) const {
+        Array retVal(r.size());
+        solve_splittingTo(direction, r, a, retVal);
+        return retVal;
+    }
+
+    void FdmG2Op::solve_splittingTo(Size direction, const Array& r,
+                                    Real a, Array& out) const {
         if (direction == direction1_) {
-            return mapX_.solve_splitting(r, a, 1.0);
+            mapX_.solve_splittingTo(r, a, 1.0, out);
         }
         else if (direction == direction2_) {
-            return mapY_.solve_splitting(r, a, 1.0);
+            mapY_.solve_splittingTo(r, a, 1.0, out);
         }
         else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
         }
     }
 
@@ -103,39 +103,70 @@ namespace QuantLib {
     }
 
     Disposable<Array> FdmHestonHullWhiteOp::apply(const Array& u) const {
-        return  dyMap_.apply(u) + dxMap_.getMap().apply(u)
-              + hullWhiteOp_.apply(u)
-              + hestonCorrMap_.apply(u) + equityIrCorrMap_.apply(u);
+        Array retVal(u.size());
+        applyTo(u, retVal);
+        return retVal;
+    }
+
+    void FdmHestonHullWhiteOp::applyTo(const Array& u, Array& out) const {
+        dyMap_.applyTo(u, out);
+        dxMap_.getMap().apply_add(u, out);
+        hullWhiteOp_.getMap().apply_add(u, out);
+        hestonCorrMap_.apply_add(u, out);
+        equityIrCorrMap_.apply_add(u, out);
     }
 
     Disposable<Array>
     FdmHestonHullWhiteOp::apply_direction(Size direction,
                                           const Array& r) const {
+        Array retVal(r.size());
+        apply_directionTo(direction, r, retVal);
+        return retVal;
+    }
+
+    void FdmHestonHullWhiteOp::apply_directionTo(Size direction,
+                                                 const Array& r,
+                                                 Array& out) const {
         if (direction == 0)
-            return dxMap_.getMap().apply(r);
+            dxMap_.getMap().applyTo(r, out);
         else if (direction == 1)
-            return dyMap_.apply(r);
+            dyMap_.applyTo(r, out);
         else if (direction == 2)
-            return hullWhiteOp_.apply(r);
+            hullWhiteOp_.applyTo(r, out);
         else
             QL_FAIL("direction too large");
     }
 
     Disposable<Array> FdmHestonHullWhiteOp::apply_mixed(const Array& r) const {
-        return hestonCorrMap_.apply(r) + equityIrCorrMap_.apply(r);
+        Array retVal(r.size());
+        apply_mixedTo(r, retVal);
+        return retVal;
+    }
+
+    void FdmHestonHullWhiteOp::apply_mixedTo(const Array& r, Array& out) const {
+        hestonCorrMap_.applyTo(r, out);
+        equityIrCorrMap_.apply_add(r, out);
     }
 
     Disposable<Array>
     FdmHestonHullWhiteOp::solve_splitting(Size direction, const Array& r,
                                           Real a) const {
+        Array retVal(r.size());
+        solve_splittingTo(direction, r, a, retVal);
+        return retVal;
+    }
+
+    void FdmHestonHullWhiteOp::solve_splittingTo(Size direction,
+                                                 const Array& r, Real a,
+                                                 Array& out) const {
         if (direction == 0) {
-            return dxMap_.getMap().solve_splitting(r, a, 1.0);
+            dxMap_.getMap().solve_splittingTo(r, a, 1.0, out);
         }
         else if (direction == 1) {
-            return dyMap_.solve_splitting(r, a, 1.0);
+            dyMap_.solve_splittingTo(r, a, 1.0, out);
         }
         else if (direction == 2) {
-            return hullWhiteOp_.solve_splitting(2, r, a);
+            hullWhiteOp_.solve_splittingTo(2, r, a, out);
         }
         else
             QL_FAIL("direction too large");
@@ -61,14 +61,17 @@ namespace QuantLib {
         L_ = getLeverageFctSlice(t1, t2);
         const Array Lsquare = L_*L_;
 
+        // mapT_ first holds the second-derivative part, so that no
+        // temporary operator is needed
+        dxxMap_.mult(Lsquare, mapT_);
         if (quantoHelper_ != nullptr) {
             mapT_.axpyb(r - q - varianceValues_*Lsquare
                 - quantoHelper_->quantoAdjustment(
                     volatilityValues_*L_, t1, t2),
-                dxMap_, dxxMap_.mult(Lsquare), Array(1, -0.5*r));
+                dxMap_, mapT_, Array(1, -0.5*r));
         } else {
             mapT_.axpyb(r - q - varianceValues_*Lsquare, dxMap_,
-                        dxxMap_.mult(Lsquare), Array(1, -0.5*r));
+                        mapT_, Array(1, -0.5*r));
         }
     }
 
@@ -156,33 +159,60 @@ namespace QuantLib {
     }
 
     Disposable<Array> FdmHestonOp::apply(const Array& u) const {
-        return dyMap_.getMap().apply(u) + dxMap_.getMap().apply(u)
-              + dxMap_.getL()*correlationMap_.apply(u);
+        Array retVal(u.size());
+        applyTo(u, retVal);
+        return retVal;
+    }
+
+    void FdmHestonOp::applyTo(const Array& u, Array& out) const {
+        apply_mixedTo(u, out);
+        dxMap_.getMap().apply_add(u, out);
+        dyMap_.getMap().apply_add(u, out);
     }
 
     Disposable<Array> FdmHestonOp::apply_direction(Size direction,
                                                    const Array& r) const {
+        Array retVal(r.size());
+        apply_directionTo(direction, r, retVal);
+        return retVal;
+    }
+
+    void FdmHestonOp::apply_directionTo(Size direction,
+                                        const Array& r, Array& out) const {
         if (direction == 0)
-            return dxMap_.getMap().apply(r);
+            dxMap_.getMap().applyTo(r, out);
         else if (direction == 1)
-            return dyMap_.getMap().apply(r);
+            dyMap_.getMap().applyTo(r, out);
         else
             QL_FAIL("direction too large");
     }
 
     Disposable<Array> FdmHestonOp::apply_mixed(const Array& r) const {
-        return dxMap_.getL()*correlationMap_.apply(r);
+        Array retVal(r.size());
+        apply_mixedTo(r, retVal);
+        return retVal;
+    }
+
+    void FdmHestonOp::apply_mixedTo(const Array& r, Array& out) const {
+        correlationMap_.applyTo(r, out);
+        out *= dxMap_.getL();
     }
 
     Disposable<Array>
         FdmHestonOp::solve_splitting(Size direction,
                                      const Array& r, Real a) const {
+        Array retVal(r.size());
+        solve_splittingTo(direction, r, a, retVal);
+        return retVal;
+    }
 
+    void FdmHestonOp::solve_splittingTo(Size direction, const Array& r,
+                                        Real a, Array& out) const {
         if (direction == 0) {
-            return dxMap_.getMap().solve_splitting(r, a, 1.0);
+            dxMap_.getMap().solve_splittingTo(r, a, 1.0, out);
         }
         else if (direction == 1) {
-            return dyMap_.getMap().solve_splitting(r, a, 1.0);
+            dyMap_.getMap().solve_splittingTo(r, a, 1.0, out);
         }
         else
             QL_FAIL("direction too large");
@@ -67,24 +67,16 @@ namespace QuantLib {
 
     Disposable<Array>
     FdmHullWhiteOp::apply_direction(Size direction, const Array& r) const {
-        if (direction == direction_)
-            return mapT_.apply(r);
-        else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
-        }
+        Array retVal(r.size());
+        apply_directionTo(direction, r, retVal);
+        return retVal;
     }
 
     Disposable<Array> FdmHullWhiteOp::solve_splitting(
         Size direction, const Array& r, Real a) const {
-
-        if (direction == direction_) {
-            return mapT_.solve_splitting(r, a, 1.0);
-        }
-        else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
-        }
+        Array retVal(r.size());
+        solve_splittingTo(direction, r, a, retVal);
+        return retVal;
     }
 
     Disposable<Array>
@@ -92,6 +84,35 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmHullWhiteOp::applyTo(const Array& r, Array& out) const {
+        mapT_.applyTo(r, out);
+    }
+
+    void FdmHullWhiteOp::apply_mixedTo(const Array& r, Array& out) const {
+        out.resize(r.size());
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::apply_directionTo(Size direction,
+                                           const Array& r, Array& out) const {
+        if (direction == direction_)
+            mapT_.applyTo(r, out);
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmHullWhiteOp::solve_splittingTo(Size direction, const Array& r,
+                                           Real a, Array& out) const {
+        if (direction == direction_)
+            mapT_.solve_splittingTo(r, a, 1.0, out);
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHullWhiteOp::toMatrixDecomp() const {
@@ -36,6 +36,12 @@ namespace QuantLib {
         typedef Array array_type;
         virtual ~FdmLinearOp() = default;
         virtual Disposable<array_type> apply(const array_type& r) const = 0;
+        /*! writes apply(r) into out, reusing its storage; r and out
+            must be different arrays.
+        */
+        virtual void applyTo(const array_type& r, array_type& out) const {
+            out = apply(r);
+        }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<SparseMatrix> toMatrix() const = 0;
@@ -51,6 +51,26 @@ namespace QuantLib {
         virtual Disposable<Array> 
             preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name Out-parameter versions
+            The results are written into the given array, which is
+            resized if needed and whose storage is reused otherwise;
+            the input and output arrays must be different.  The
+            default implementations fall back on the methods above.
+        */
+        //@{
+        virtual void apply_mixedTo(const Array& r, Array& out) const {
+            out = apply_mixed(r);
+        }
+        virtual void apply_directionTo(Size direction,
+                                       const Array& r, Array& out) const {
+            out = apply_direction(direction, r);
+        }
+        virtual void solve_splittingTo(Size direction, const Array& r,
+                                       Real s, Array& out) const {
+            out = solve_splitting(direction, r, s);
+        }
+        //@}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const {
             QL_FAIL(" ublas representation is not implemented");
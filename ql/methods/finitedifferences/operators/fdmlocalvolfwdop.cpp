@@ -65,12 +65,9 @@ namespace QuantLib {
 
     Disposable<Array> FdmLocalVolFwdOp::apply_direction(
         Size direction, const Array& r) const {
-        if (direction == direction_)
-            return mapT_.apply(r);
-        else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
-        }
+        Array retVal(r.size());
+        apply_directionTo(direction, r, retVal);
+        return retVal;
     }
 
     Disposable<Array> FdmLocalVolFwdOp::apply_mixed(const Array& r) const {
@@ -80,12 +77,9 @@ namespace QuantLib {
 
     Disposable<Array> FdmLocalVolFwdOp::solve_splitting(
         Size direction, const Array& r, Real dt) const {
-        if (direction == direction_)
-            return mapT_.solve_splitting(r, dt, 1.0);
-        else {
-            Array retVal(r);
-            return retVal;
-        }
+        Array retVal(r.size());
+        solve_splittingTo(direction, r, dt, retVal);
+        return retVal;
     }
 
     Disposable<Array> FdmLocalVolFwdOp::preconditioner(
@@ -93,6 +87,35 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmLocalVolFwdOp::applyTo(const Array& r, Array& out) const {
+        mapT_.applyTo(r, out);
+    }
+
+    void FdmLocalVolFwdOp::apply_mixedTo(const Array& r, Array& out) const {
+        out.resize(r.size());
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmLocalVolFwdOp::apply_directionTo(Size direction,
+                                             const Array& r, Array& out) const {
+        if (direction == direction_)
+            mapT_.applyTo(r, out);
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmLocalVolFwdOp::solve_splittingTo(Size direction, const Array& r,
+                                             Real dt, Array& out) const {
+        if (direction == direction_)
+            mapT_.solve_splittingTo(r, dt, 1.0, out);
+        else {
+            out.resize(r.size());
+            std::copy(r.begin(), r.end(), out.begin());
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmLocalVolFwdOp::toMatrixDecomp() const {
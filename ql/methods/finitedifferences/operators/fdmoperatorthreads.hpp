@@ -0,0 +1,70 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmoperatorthreads.hpp
+    \brief number of threads used by finite-difference operators
+*/
+
+#ifndef quantlib_fdm_operator_threads_hpp
+#define quantlib_fdm_operator_threads_hpp
+
+#include <ql/errors.hpp>
+#include <ql/types.hpp>
+
+namespace QuantLib {
+
+    //! number of threads used by finite-difference operators
+    /*! While an instance of this class is alive, TripleBandLinearOp
+        and NinePointLinearOp called from the thread that created it
+        distribute their grid lines (or grid points) over the given
+        number of threads if the library is compiled with OpenMP.
+        Each line is processed exactly as in the serial case, so that
+        the results don't depend on the number of threads.
+
+        The ADI schemes create an instance for the duration of each
+        step, and FdmKrylovSolver for the duration of each solve, in
+        which it also distributes its sparse matrix-vector products;
+        composite operators don't need to be aware of it.
+
+        Instances can be nested, and must be destroyed in the thread
+        that created them in reverse order of creation.
+    */
+    class FdmOperatorThreads {
+      public:
+        explicit FdmOperatorThreads(Size threads)
+        : previous_(current()) {
+            QL_REQUIRE(threads > 0, "at least one thread required");
+            value() = threads;
+        }
+        ~FdmOperatorThreads() { value() = previous_; }
+        FdmOperatorThreads(const FdmOperatorThreads&) = delete;
+        FdmOperatorThreads& operator=(const FdmOperatorThreads&) = delete;
+
+        //! number of threads for the calling thread; 1 by default
+        static Size current() { return value(); }
+      private:
+        static Size& value() {
+            static thread_local Size threads = 1;
+            return threads;
+        }
+        Size previous_;
+    };
+
+}
+
+
+#endif
@@ -79,26 +79,16 @@ namespace QuantLib {
 
     Disposable<Array> FdmOrnsteinUhlenbeckOp::apply_direction(
         Size direction, const Array& r) const {
-
-        if (direction == direction_) {
-            return mapX_.apply(r);
-        }
-        else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
-        }
+        Array retVal(r.size());
+        apply_directionTo(direction, r, retVal);
+        return retVal;
     }
 
     Disposable<Array> FdmOrnsteinUhlenbeckOp::solve_splitting(
         Size direction, const Array& r, Real a) const {
-
-        if (direction == direction_) {
-            return mapX_.solve_splitting(r, a, 1.0);
-        }
-        else {
-            Array retVal(r);
-            return retVal;
-        }
+        Array retVal(r.size());
+        solve_splittingTo(direction, r, a, retVal);
+        return retVal;
     }
 
     Disposable<Array> FdmOrnsteinUhlenbeckOp::preconditioner(
@@ -106,6 +96,38 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmOrnsteinUhlenbeckOp::applyTo(const Array& r, Array& out) const {
+        mapX_.applyTo(r, out);
+    }
+
+    void FdmOrnsteinUhlenbeckOp::apply_mixedTo(const Array& r,
+                                               Array& out) const {
+        out.resize(r.size());
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmOrnsteinUhlenbeckOp::apply_directionTo(Size direction,
+                                                   const Array& r,
+                                                   Array& out) const {
+        if (direction == direction_)
+            mapX_.applyTo(r, out);
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmOrnsteinUhlenbeckOp::solve_splittingTo(Size direction,
+                                                   const Array& r, Real a,
+                                                   Array& out) const {
+        if (direction == direction_)
+            mapX_.solve_splittingTo(r, a, 1.0, out);
+        else {
+            out.resize(r.size());
+            std::copy(r.begin(), r.end(), out.begin());
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmOrnsteinUhlenbeckOp::toMatrixDecomp() const {
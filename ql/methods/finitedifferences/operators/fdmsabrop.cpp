@@ -60,31 +60,57 @@ namespace QuantLib {
     }
 
     Disposable<Array> FdmSabrOp::apply(const Array& u) const {
-        return mapF_.apply(u) + mapA_.apply(u) + correlationMap_.apply(u);
+        Array retVal(u.size());
+        applyTo(u, retVal);
+        return retVal;
+    }
+
+    void FdmSabrOp::applyTo(const Array& u, Array& out) const {
+        mapF_.applyTo(u, out);
+        mapA_.apply_add(u, out);
+        correlationMap_.apply_add(u, out);
     }
 
     Disposable<Array> FdmSabrOp::apply_mixed(const Array& r) const {
         return correlationMap_.apply(r);
     }
 
+    void FdmSabrOp::apply_mixedTo(const Array& r, Array& out) const {
+        correlationMap_.applyTo(r, out);
+    }
+
     Disposable<Array> FdmSabrOp::apply_direction(
         Size direction, const Array& r) const {
+        Array retVal(r.size());
+        apply_directionTo(direction, r, retVal);
+        return retVal;
+    }
+
+    void FdmSabrOp::apply_directionTo(
+        Size direction, const Array& r, Array& out) const {
         if (direction == 0)
-            return mapF_.apply(r);
+            mapF_.applyTo(r, out);
         else if (direction == 1)
-            return mapA_.apply(r);
+            mapA_.applyTo(r, out);
         else
             QL_FAIL("direction too large");
     }
 
     Disposable<Array> FdmSabrOp::solve_splitting(
        Size direction, const Array& r, Real a) const {
+        Array retVal(r.size());
+        solve_splittingTo(direction, r, a, retVal);
+        return retVal;
+    }
+
+    void FdmSabrOp::solve_splittingTo(
+       Size direction, const Array& r, Real a, Array& out) const {
 
         if (direction == 0) {
-            return mapF_.solve_splitting(r, a, 1.0);
+            mapF_.solve_splittingTo(r, a, 1.0, out);
         }
         else if (direction == 1) {
-            return mapA_.solve_splitting(r, a, 1.0);
+            mapA_.solve_splittingTo(r, a, 1.0, out);
         }
         else
             QL_FAIL("direction too large");
@@ -21,6 +21,7 @@
 
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/fdmoperatorthreads.hpp>
 #include <ql/methods/finitedifferences/operators/ninepointlinearop.hpp>
 
 namespace QuantLib {
@@ -125,12 +126,19 @@ namespace QuantLib {
 
     Disposable<Array> NinePointLinearOp::apply(const Array& u)
         const {
+        Array retVal(u.size());
+        applyTo(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::applyTo(const Array& u, Array& out) const {
 
         const ext::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
         QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
                     << u.size() << " vs " << index->size());
+        QL_REQUIRE(&u != &out, "result must not overwrite the argument");
+        out.resize(u.size());
 
-        Array retVal(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -139,19 +147,50 @@ namespace QuantLib {
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
 
-        //#pragma omp parallel for
-        for (Size i=0; i < retVal.size(); ++i) {
-            retVal[i] =   a00[i]*u[i00[i]]
-                        + a01[i]*u[i01[i]]
-                        + a02[i]*u[i02[i]]
-                        + a10[i]*u[i10[i]]
-                        + a11[i]*u[i]
-                        + a12[i]*u[i12[i]]
-                        + a20[i]*u[i20[i]]
-                        + a21[i]*u[i21[i]]
-                        + a22[i]*u[i22[i]];
+        #pragma omp parallel for if(FdmOperatorThreads::current() > 1) \
+                                 num_threads(FdmOperatorThreads::current())
+        for (long i=0; i < (long)out.size(); ++i) {
+            out[i] =   a00[i]*u[i00[i]]
+                     + a01[i]*u[i01[i]]
+                     + a02[i]*u[i02[i]]
+                     + a10[i]*u[i10[i]]
+                     + a11[i]*u[i]
+                     + a12[i]*u[i12[i]]
+                     + a20[i]*u[i20[i]]
+                     + a21[i]*u[i21[i]]
+                     + a22[i]*u[i22[i]];
+        }
+    }
+
+    void NinePointLinearOp::apply_add(const Array& u, Array& out) const {
+
+        const ext::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
+        QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
+                    << u.size() << " vs " << index->size());
+        QL_REQUIRE(out.size() == u.size(), "inconsistent length of result");
+        QL_REQUIRE(&u != &out, "result must not overwrite the argument");
+
+        // direct access to make the following code faster.
+        const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
+        const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
+        const Real *a20(a20_.get()), *a21(a21_.get()), *a22(a22_.get());
+        const Size *i00(i00_.get()), *i01(i01_.get()), *i02(i02_.get());
+        const Size *i10(i10_.get()),                   *i12(i12_.get());
+        const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
+
+        #pragma omp parallel for if(FdmOperatorThreads::current() > 1) \
+                                 num_threads(FdmOperatorThreads::current())
+        for (long i=0; i < (long)out.size(); ++i) {
+            out[i] +=   a00[i]*u[i00[i]]
+                      + a01[i]*u[i01[i]]
+                      + a02[i]*u[i02[i]]
+                      + a10[i]*u[i10[i]]
+                      + a11[i]*u[i]
+                      + a12[i]*u[i12[i]]
+                      + a20[i]*u[i20[i]]
+                      + a21[i]*u[i21[i]]
+                      + a22[i]*u[i22[i]];
         }
-        return retVal;
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -181,19 +220,28 @@ namespace QuantLib {
         NinePointLinearOp::mult(const Array & u) const {
 
         NinePointLinearOp retVal(d0_, d1_, mesher_);
+        mult(u, retVal);
+
+        return retVal;
+    }
+
+    void NinePointLinearOp::mult(const Array& u,
+                                 NinePointLinearOp& out) const {
+        QL_REQUIRE(out.mesher_ == mesher_
+                   && out.d0_ == d0_ && out.d1_ == d1_,
+                   "inconsistent mesher or directions of result");
+
         const Size size = mesher_->layout()->size();
 
         //#pragma omp parallel for
         for (Size i=0; i < size; ++i) {
             const Real s = u[i];
-            retVal.a11_[i]=a11_[i]*s; retVal.a00_[i]=a00_[i]*s;
-            retVal.a01_[i]=a01_[i]*s; retVal.a02_[i]=a02_[i]*s;
-            retVal.a10_[i]=a10_[i]*s; retVal.a20_[i]=a20_[i]*s;
-            retVal.a21_[i]=a21_[i]*s; retVal.a12_[i]=a12_[i]*s;
-            retVal.a22_[i]=a22_[i]*s;
+            out.a11_[i]=a11_[i]*s; out.a00_[i]=a00_[i]*s;
+            out.a01_[i]=a01_[i]*s; out.a02_[i]=a02_[i]*s;
+            out.a10_[i]=a10_[i]*s; out.a20_[i]=a20_[i]*s;
+            out.a21_[i]=a21_[i]*s; out.a12_[i]=a12_[i]*s;
+            out.a22_[i]=a22_[i]*s;
         }
-
-        return retVal;
     }
 
     void NinePointLinearOp::swap(NinePointLinearOp& m) {
@@ -55,6 +55,20 @@ namespace QuantLib {
         Disposable<Array> apply(const Array& r) const override;
         Disposable<NinePointLinearOp> mult(const Array& u) const;
 
+        /*! \name Out-parameter versions
+            The results are written into the given array or operator
+            instead of a new one.  Arrays are resized if needed;
+            operators must be built on the same mesher and directions
+            as this one, and can be this one itself.  The input and
+            output arrays must be different.
+        */
+        //@{
+        void applyTo(const Array& r, Array& out) const override;
+        //! adds the result of apply(r) to out
+        void apply_add(const Array& r, Array& out) const;
+        void mult(const Array& u, NinePointLinearOp& out) const;
+        //@}
+
         void swap(NinePointLinearOp& m);
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -87,6 +87,11 @@ namespace QuantLib {
         return prod(m_, r);
     }
 
+    void NthOrderDerivativeOp::applyTo(const array_type& r,
+                                       array_type& out) const {
+        prod(m_, r, out);
+    }
+
 
     Disposable<SparseMatrix> NthOrderDerivativeOp::toMatrix() const {
         SparseMatrix tmp(m_);
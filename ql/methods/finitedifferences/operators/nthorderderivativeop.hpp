@@ -39,6 +39,7 @@ namespace QuantLib {
             const ext::shared_ptr<FdmMesher>& mesher);
 
         Disposable<array_type> apply(const array_type& r) const override;
+        void applyTo(const array_type& r, array_type& out) const override;
         Disposable<SparseMatrix> toMatrix() const override;
 
       private:
@@ -23,58 +23,107 @@
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/methods/finitedifferences/tridiagonaloperator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/fdmoperatorthreads.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <algorithm>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace {
+
+        // number of neighbouring lines solved together when the
+        // lines are not contiguous in memory
+        const Size tileSize = 32;
+
+        // scratch space for the elimination along grid lines, kept
+        // by each thread across calls
+        Real* lineBuffer(Size n) {
+            static thread_local std::vector<Real> buffer;
+            if (buffer.size() < n)
+                buffer.resize(n);
+            return &buffer[0];
+        }
+
+        struct Assign {
+            void operator()(Real& x, Real y) const { x = y; }
+        };
+
+        struct Accumulate {
+            void operator()(Real& x, Real y) const { x += y; }
+        };
+
+        /* Applies the band to r along lines of n points at the given
+           stride.  Contiguous lines (stride 1) are traversed one by
+           one; otherwise the layout is traversed as rows of stride
+           contiguous points, each combined with the previous and the
+           next row, so that the inner loop is a plain vector
+           operation.  The operations on each point are the same in
+           both cases.
+        */
+        template <class Store>
+        void applyBand(const Real* l, const Real* d, const Real* u,
+                       const Real* r, Real* out,
+                       Size size, Size n, Size stride, Store store) {
+            if (n == 1) {
+                for (Size i=0; i < size; ++i)
+                    store(out[i], r[i]*d[i]);
+            }
+            else if (stride == 1) {
+                const Size lines = size/n;
+                #pragma omp parallel for if(FdmOperatorThreads::current() > 1) \
+                                         num_threads(FdmOperatorThreads::current())
+                for (long k=0; k < (long)lines; ++k) {
+                    const Size first = Size(k)*n, last = first + n - 1;
+                    store(out[first], r[first+1]*l[first] + r[first]*d[first]
+                                      + r[first+1]*u[first]);
+                    for (Size i=first+1; i < last; ++i)
+                        store(out[i], r[i-1]*l[i] + r[i]*d[i] + r[i+1]*u[i]);
+                    store(out[last], r[last-1]*l[last] + r[last]*d[last]
+                                     + r[last-1]*u[last]);
+                }
+            }
+            else {
+                const Size rows = size/stride;
+                #pragma omp parallel for if(FdmOperatorThreads::current() > 1) \
+                                         num_threads(FdmOperatorThreads::current())
+                for (long k=0; k < (long)rows; ++k) {
+                    const Size c = Size(k) % n;
+                    const Size first = Size(k)*stride;
+                    const Real* rm = r + (c > 0 ? first-stride : first+stride);
+                    const Real* rp = r + (c < n-1 ? first+stride : first-stride);
+                    const Real* r0 = r + first;
+                    const Real* lk = l + first;
+                    const Real* dk = d + first;
+                    const Real* uk = u + first;
+                    Real* ok = out + first;
+                    for (Size j=0; j < stride; ++j)
+                        store(ok[j], rm[j]*lk[j] + r0[j]*dk[j] + rp[j]*uk[j]);
+                }
+            }
+        }
+
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const ext::shared_ptr<FdmMesher>& mesher)
     : direction_(direction),
-      i0_       (new Size[mesher->layout()->size()]),
-      i2_       (new Size[mesher->layout()->size()]),
-      reverseIndex_ (new Size[mesher->layout()->size()]),
+      stride_   (mesher->layout()->spacing()[direction]),
+      lineSize_ (mesher->layout()->dim()[direction]),
       lower_    (new Real[mesher->layout()->size()]),
       diag_     (new Real[mesher->layout()->size()]),
       upper_    (new Real[mesher->layout()->size()]),
-      mesher_(mesher) {
-
-        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-        const FdmLinearOpIterator endIter = layout->end();
-
-        std::vector<Size> newDim(layout->dim());
-        std::iter_swap(newDim.begin(), newDim.begin()+direction_);
-        std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
-        std::iter_swap(newSpacing.begin(), newSpacing.begin()+direction_);
-
-        for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.index();
-
-            i0_[i] = layout->neighbourhood(iter, direction, -1);
-            i2_[i] = layout->neighbourhood(iter, direction,  1);
-
-            const std::vector<Size>& coordinates = iter.coordinates();
-            const Size newIndex =
-                  std::inner_product(coordinates.begin(), coordinates.end(),
-                                     newSpacing.begin(), Size(0));
-            reverseIndex_[newIndex] = i;
-        }
-    }
+      mesher_(mesher) {}
 
     TripleBandLinearOp::TripleBandLinearOp(const TripleBandLinearOp& m)
     : direction_(m.direction_),
-      i0_   (new Size[m.mesher_->layout()->size()]),
-      i2_   (new Size[m.mesher_->layout()->size()]),
-      reverseIndex_(new Size[m.mesher_->layout()->size()]),
+      stride_(m.stride_), lineSize_(m.lineSize_),
       lower_(new Real[m.mesher_->layout()->size()]),
       diag_ (new Real[m.mesher_->layout()->size()]),
       upper_(new Real[m.mesher_->layout()->size()]),
       mesher_(m.mesher_) {
         const Size len = m.mesher_->layout()->size();
-        std::copy(m.i0_.get(), m.i0_.get() + len, i0_.get());
-        std::copy(m.i2_.get(), m.i2_.get() + len, i2_.get());
-        std::copy(m.reverseIndex_.get(), m.reverseIndex_.get()+len,
-                  reverseIndex_.get());
         std::copy(m.lower_.get(), m.lower_.get() + len, lower_.get());
         std::copy(m.diag_.get(),  m.diag_.get() + len,  diag_.get());
         std::copy(m.upper_.get(), m.upper_.get() + len, upper_.get());
@@ -97,9 +146,9 @@ namespace QuantLib {
     void TripleBandLinearOp::swap(TripleBandLinearOp& m) {
         std::swap(mesher_, m.mesher_);
         std::swap(direction_, m.direction_);
+        std::swap(stride_, m.stride_);
+        std::swap(lineSize_, m.lineSize_);
 
-        i0_.swap(m.i0_); i2_.swap(m.i2_);
-        reverseIndex_.swap(m.reverseIndex_);
         lower_.swap(m.lower_); diag_.swap(m.diag_); upper_.swap(m.upper_);
     }
 
@@ -178,86 +227,126 @@ namespace QuantLib {
     TripleBandLinearOp::add(const TripleBandLinearOp& m) const {
 
         TripleBandLinearOp retVal(direction_, mesher_);
+        add(m, retVal);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::add(const TripleBandLinearOp& m,
+                                 TripleBandLinearOp& out) const {
+        QL_REQUIRE(out.mesher_ == mesher_ && out.direction_ == direction_,
+                   "inconsistent mesher or direction of result");
+
         const Size size = mesher_->layout()->size();
         //#pragma omp parallel for
         for (Size i=0; i < size; ++i) {
-            retVal.lower_[i]= lower_[i] + m.lower_[i];
-            retVal.diag_[i] = diag_[i]  + m.diag_[i];
-            retVal.upper_[i]= upper_[i] + m.upper_[i];
+            out.lower_[i]= lower_[i] + m.lower_[i];
+            out.diag_[i] = diag_[i]  + m.diag_[i];
+            out.upper_[i]= upper_[i] + m.upper_[i];
         }
-
-        return retVal;
     }
 
 
     Disposable<TripleBandLinearOp> TripleBandLinearOp::mult(const Array& u) const {
 
         TripleBandLinearOp retVal(direction_, mesher_);
+        mult(u, retVal);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::mult(const Array& u,
+                                  TripleBandLinearOp& out) const {
+        QL_REQUIRE(out.mesher_ == mesher_ && out.direction_ == direction_,
+                   "inconsistent mesher or direction of result");
 
         const Size size = mesher_->layout()->size();
         //#pragma omp parallel for
         for (Size i=0; i < size; ++i) {
             const Real s = u[i];
-            retVal.lower_[i]= lower_[i]*s;
-            retVal.diag_[i] = diag_[i]*s;
-            retVal.upper_[i]= upper_[i]*s;
+            out.lower_[i]= lower_[i]*s;
+            out.diag_[i] = diag_[i]*s;
+            out.upper_[i]= upper_[i]*s;
         }
+    }
+
+    Disposable<TripleBandLinearOp> TripleBandLinearOp::multR(const Array& u) const {
+        TripleBandLinearOp retVal(direction_, mesher_);
+        multR(u, retVal);
 
         return retVal;
     }
 
-    Disposable<TripleBandLinearOp> TripleBandLinearOp::multR(const Array& u) const {
+    void TripleBandLinearOp::multR(const Array& u,
+                                   TripleBandLinearOp& out) const {
         const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         const Size size = layout->size();
         QL_REQUIRE(u.size() == size, "inconsistent size of rhs");
-        TripleBandLinearOp retVal(direction_, mesher_);
+        QL_REQUIRE(out.mesher_ == mesher_ && out.direction_ == direction_,
+                   "inconsistent mesher or direction of result");
 
         #pragma omp parallel for
         for (long i=0; i < (long)size; ++i) {
             const Real sm1 = i > 0? u[i-1] : 1.0;
             const Real s0 = u[i];
             const Real sp1 = i < (long)size-1? u[i+1] : 1.0;
-            retVal.lower_[i]= lower_[i]*sm1;
-            retVal.diag_[i] = diag_[i]*s0;
-            retVal.upper_[i]= upper_[i]*sp1;
+            out.lower_[i]= lower_[i]*sm1;
+            out.diag_[i] = diag_[i]*s0;
+            out.upper_[i]= upper_[i]*sp1;
         }
-
-        return retVal;
     }
 
     Disposable<TripleBandLinearOp> TripleBandLinearOp::add(const Array& u) const {
 
         TripleBandLinearOp retVal(direction_, mesher_);
+        add(u, retVal);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::add(const Array& u,
+                                 TripleBandLinearOp& out) const {
+        QL_REQUIRE(out.mesher_ == mesher_ && out.direction_ == direction_,
+                   "inconsistent mesher or direction of result");
 
         const Size size = mesher_->layout()->size();
         //#pragma omp parallel for
         for (Size i=0; i < size; ++i) {
-            retVal.lower_[i]= lower_[i];
-            retVal.upper_[i]= upper_[i];
-            retVal.diag_[i] = diag_[i]+u[i];
+            out.lower_[i]= lower_[i];
+            out.upper_[i]= upper_[i];
+            out.diag_[i] = diag_[i]+u[i];
         }
+    }
+
+    Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
+        Array retVal(r.size());
+        applyTo(r, retVal);
 
         return retVal;
     }
 
-    Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
+    void TripleBandLinearOp::applyTo(const Array& r, Array& out) const {
         const ext::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
 
         QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(&r != &out, "result must not overwrite the argument");
+        out.resize(r.size());
 
-        const Real* lptr = lower_.get();
-        const Real* dptr = diag_.get();
-        const Real* uptr = upper_.get();
-        const Size* i0ptr = i0_.get();
-        const Size* i2ptr = i2_.get();
+        applyBand(lower_.get(), diag_.get(), upper_.get(),
+                  r.begin(), out.begin(), index->size(),
+                  lineSize_, stride_, Assign());
+    }
 
-        array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < index->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
-        }
+    void TripleBandLinearOp::apply_add(const Array& r, Array& out) const {
+        const ext::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
 
-        return retVal;
+        QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(out.size() == r.size(), "inconsistent length of result");
+        QL_REQUIRE(&r != &out, "result must not overwrite the argument");
+
+        applyBand(lower_.get(), diag_.get(), upper_.get(),
+                  r.begin(), out.begin(), index->size(),
+                  lineSize_, stride_, Accumulate());
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -267,9 +356,14 @@ namespace QuantLib {
 
         SparseMatrix retVal(n, n, 3*n);
         for (Size i=0; i < n; ++i) {
-            retVal(i, i0_[i]) += lower_[i];
-            retVal(i, i     ) += diag_[i];
-            retVal(i, i2_[i]) += upper_[i];
+            retVal(i, i) += diag_[i];
+            if (lineSize_ > 1) {
+                const Size c = (i/stride_) % lineSize_;
+                const Size i0 = c > 0 ? i-stride_ : i+stride_;
+                const Size i2 = c < lineSize_-1 ? i+stride_ : i-stride_;
+                retVal(i, i0) += lower_[i];
+                retVal(i, i2) += upper_[i];
+            }
         }
 
         return retVal;
@@ -279,8 +373,17 @@ namespace QuantLib {
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+        Array retVal(r.size());
+        solve_splittingTo(r, a, b, retVal);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splittingTo(const Array& r, Real a, Real b,
+                                               Array& out) const {
         const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
+        QL_REQUIRE(&r != &out, "result must not overwrite the argument");
 
 #ifdef QL_EXTRA_SAFETY_CHECKS
         for (FdmLinearOpIterator iter = layout->begin();
@@ -293,36 +396,102 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
+        out.resize(r.size());
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
+        Real* optr = out.begin();
+
+        // As the lower band vanishes at the beginning of each line
+        // and the upper band at its end, each line is an independent
+        // tridiagonal system, solved by the Thomas algorithm (example
+        // code taken from TridiagonalOperator and changed to fit for
+        // the triple band operator).
+        const Size n = lineSize_, stride = stride_, size = layout->size();
+        bool singular = false;
+
+        if (stride == 1) {
+            // contiguous lines, solved one by one
+            const Size lines = size/n;
+            #pragma omp parallel for if(FdmOperatorThreads::current() > 1) \
+                                     num_threads(FdmOperatorThreads::current()) \
+                                     reduction(||:singular)
+            for (long l=0; l < (long)lines; ++l) {
+                const Size first = Size(l)*n, last = first + n - 1;
+                Real* tmp = lineBuffer(n);
+
+                Real bet=1.0/(a*dptr[first]+b);
+                if (bet == 0.0) {
+                    singular = true;
+                    continue;
+                }
+                optr[first] = r[first]*bet;
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
-
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+                for (Size j=first+1; j<=last; j++){
+                    tmp[j-first] = a*uptr[j-1]*bet;
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+                    bet=b+a*(dptr[j]-tmp[j-first]*lptr[j]);
+                    if (bet == 0.0) {
+                        singular = true;
+                        break;
+                    }
+                    bet=1.0/bet;
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+                    optr[j] = (r[j]-a*lptr[j]*optr[j-1])*bet;
+                }
+                for (Size j=last; j>first; --j)
+                    optr[j-1] -= tmp[j-first]*optr[j];
+            }
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+        else {
+            // the lines starting at neighbouring points are solved
+            // together, one tile of up to tileSize lines at a time;
+            // each step of the elimination is a vector operation
+            // over the tile
+            const Size tiles = (stride + tileSize - 1)/tileSize;
+            const Size blocks = size/(stride*n);
+            #pragma omp parallel for if(FdmOperatorThreads::current() > 1) \
+                                     num_threads(FdmOperatorThreads::current()) \
+                                     reduction(||:singular)
+            for (long t=0; t < (long)(blocks*tiles); ++t) {
+                const Size offset = (Size(t) % tiles)*tileSize;
+                const Size first = (Size(t) / tiles)*stride*n + offset;
+                const Size w = std::min(tileSize, stride - offset);
+                Real* bet = lineBuffer((n+1)*tileSize);
+                Real* tmp = bet + tileSize;
+
+                for (Size k=0; k < w; ++k) {
+                    bet[k] = 1.0/(a*dptr[first+k]+b);
+                    if (bet[k] == 0.0)
+                        singular = true;
+                    optr[first+k] = r[first+k]*bet[k];
+                }
 
-        return retVal;
+                for (Size c=1; c < n; ++c) {
+                    const Size row = first + c*stride, prev = row - stride;
+                    Real* tc = tmp + c*tileSize;
+                    for (Size k=0; k < w; ++k) {
+                        tc[k] = a*uptr[prev+k]*bet[k];
+
+                        const Real x = b+a*(dptr[row+k]-tc[k]*lptr[row+k]);
+                        if (x == 0.0)
+                            singular = true;
+                        bet[k] = 1.0/x;
+
+                        optr[row+k] =
+                            (r[row+k]-a*lptr[row+k]*optr[prev+k])*bet[k];
+                    }
+                }
+                for (Size c=n-1; c > 0; --c) {
+                    const Size row = first + c*stride, prev = row - stride;
+                    const Real* tc = tmp + c*tileSize;
+                    for (Size k=0; k < w; ++k)
+                        optr[prev+k] -= tc[k]*optr[row+k];
+                }
+            }
+        }
+        // exceptions can't be thrown out of the parallel loop
+        QL_ENSURE(!singular, "division by zero");
     }
 }
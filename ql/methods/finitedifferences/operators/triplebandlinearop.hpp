@@ -64,6 +64,26 @@ namespace QuantLib {
         Disposable<TripleBandLinearOp> add(const TripleBandLinearOp& m) const;
         Disposable<TripleBandLinearOp> add(const Array& u) const;
 
+        /*! \name Out-parameter versions
+            The results are written into the given array or operator
+            instead of a new one.  Arrays are resized if needed;
+            operators must be built on the same mesher and direction
+            as this one, and can be this one itself.  The input and
+            output arrays must be different.
+        */
+        //@{
+        void applyTo(const Array& r, Array& out) const override;
+        //! adds the result of apply(r) to out
+        void apply_add(const Array& r, Array& out) const;
+        void solve_splittingTo(const Array& r, Real a, Real b,
+                               Array& out) const;
+
+        void mult(const Array& u, TripleBandLinearOp& out) const;
+        void multR(const Array& u, TripleBandLinearOp& out) const;
+        void add(const TripleBandLinearOp& m, TripleBandLinearOp& out) const;
+        void add(const Array& u, TripleBandLinearOp& out) const;
+        //@}
+
         // some very basic linear algebra routines
         void axpyb(const Array& a, const TripleBandLinearOp& x,
                    const TripleBandLinearOp& y, const Array& b);
@@ -78,13 +98,13 @@ namespace QuantLib {
         TripleBandLinearOp() = default;
 
         Size direction_;
+        // distance in the layout between neighbours in the given
+        // direction, and number of points along it; the neighbours
+        // of the first and last point of a line are reflected
+        Size stride_, lineSize_;
         #if !defined(QL_USE_STD_UNIQUE_PTR)
-        boost::shared_array<Size> i0_, i2_;
-        boost::shared_array<Size> reverseIndex_;
         boost::shared_array<Real> lower_, diag_, upper_;
         #else
-        std::unique_ptr<Size[]> i0_, i2_;
-        std::unique_ptr<Size[]> reverseIndex_;
         std::unique_ptr<Real[]> lower_, diag_, upper_;
         #endif
 
@@ -45,7 +45,8 @@ namespace QuantLib {
         CraigSneydScheme(Real theta,
                          Real mu,
                          ext::shared_ptr<FdmLinearOpComposite> map,
-                         const bc_set& bcSet = bc_set());
+                         const bc_set& bcSet = bc_set(),
+                         Size threads = 1);
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
@@ -56,6 +57,10 @@ namespace QuantLib {
         const Real mu_;
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        const Size threads_;
+
+        // scratch arrays, reused across the steps
+        array_type y_, yt_, rhs_;
     };
 }
 
@@ -19,6 +19,7 @@
 
 #include <ql/methods/finitedifferences/schemes/expliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/cranknicolsonscheme.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmkrylovsolver.hpp>
 
 namespace QuantLib {
     CrankNicolsonScheme::CrankNicolsonScheme(
@@ -34,6 +35,18 @@ namespace QuantLib {
           map, bcSet, relTol, solverType)) {
     }
 
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    CrankNicolsonScheme::CrankNicolsonScheme(
+        Real theta,
+        const ext::shared_ptr<FdmKrylovSolver>& solver,
+        const bc_set& bcSet)
+    : dt_(Null<Real>()),
+      theta_(theta),
+      explicit_(ext::make_shared<ExplicitEulerScheme>(solver->map(), bcSet)),
+      implicit_(ext::make_shared<ImplicitEulerScheme>(solver, bcSet)) {
+    }
+#endif
+
     void CrankNicolsonScheme::step(array_type& a, Time t) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
 
@@ -51,6 +51,13 @@ namespace QuantLib {
             Real relTol = 1e-8,
             ImplicitEulerScheme::SolverType solverType
                 = ImplicitEulerScheme::BiCGstab);
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        //! the implicit part is solved by the given solver
+        CrankNicolsonScheme(
+            Real theta,
+            const ext::shared_ptr<FdmKrylovSolver>& solver,
+            const bc_set& bcSet = bc_set());
+#endif
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
@@ -19,31 +19,39 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/methods/finitedifferences/operators/fdmoperatorthreads.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <utility>
 
 namespace QuantLib {
     DouglasScheme::DouglasScheme(Real theta,
                                  ext::shared_ptr<FdmLinearOpComposite> map,
-                                 const bc_set& bcSet)
-    : dt_(Null<Real>()), theta_(theta), map_(std::move(map)), bcSet_(bcSet) {}
+                                 const bc_set& bcSet,
+                                 Size threads)
+    : dt_(Null<Real>()), theta_(theta), map_(std::move(map)), bcSet_(bcSet),
+      threads_(threads) {}
 
     void DouglasScheme::step(array_type& a, Time t) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
+        FdmOperatorThreads threads(threads_);
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->applyTo(a, y_);
+        y_ *= dt_;
+        y_ += a;
+        bcSet_.applyAfterApplying(y_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_directionTo(i, a, rhs_);
+            rhs_ *= -theta_*dt_;
+            rhs_ += y_;
+            map_->solve_splittingTo(i, rhs_, -theta_*dt_, y_);
         }
-        bcSet_.applyAfterSolving(y);
+        bcSet_.applyAfterSolving(y_);
 
-        a = y;
+        a.swap(y_);
     }
 
     void DouglasScheme::setStep(Time dt) {
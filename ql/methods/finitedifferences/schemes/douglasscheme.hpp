@@ -44,7 +44,8 @@ namespace QuantLib {
         // constructors
         DouglasScheme(Real theta,
                       ext::shared_ptr<FdmLinearOpComposite> map,
-                      const bc_set& bcSet = bc_set());
+                      const bc_set& bcSet = bc_set(),
+                      Size threads = 1);
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
@@ -54,6 +55,10 @@ namespace QuantLib {
         const Real theta_;
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        const Size threads_;
+
+        // scratch arrays, reused across the steps
+        array_type y_, rhs_;
     };
 }
 
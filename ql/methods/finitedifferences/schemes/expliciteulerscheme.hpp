@@ -55,6 +55,9 @@ namespace QuantLib {
         Time dt_;
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // scratch arrays, reused across the steps
+        array_type tmp_;
     };
 }
 
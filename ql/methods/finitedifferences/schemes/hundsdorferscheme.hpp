@@ -48,7 +48,8 @@ namespace QuantLib {
         HundsdorferScheme(Real theta,
                           Real mu,
                           ext::shared_ptr<FdmLinearOpComposite> map,
-                          const bc_set& bcSet = bc_set());
+                          const bc_set& bcSet = bc_set(),
+                          Size threads = 1);
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
@@ -60,6 +61,10 @@ namespace QuantLib {
 
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        const Size threads_;
+
+        // scratch arrays, reused across the steps
+        array_type y_, yt_, rhs_, tmp_;
     };
 }
 
@@ -23,6 +23,7 @@
 #include <ql/math/matrixutilities/bicgstab.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmkrylovsolver.hpp>
 #include <utility>
 
 namespace QuantLib {
@@ -34,6 +35,14 @@ namespace QuantLib {
     : dt_(Null<Real>()), iterations_(ext::make_shared<Size>(0U)), relTol_(relTol),
       map_(std::move(map)), bcSet_(bcSet), solverType_(solverType) {}
 
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    ImplicitEulerScheme::ImplicitEulerScheme(
+        ext::shared_ptr<FdmKrylovSolver> solver, const bc_set& bcSet)
+    : dt_(Null<Real>()), iterations_(ext::make_shared<Size>(0U)),
+      relTol_(Null<Real>()), map_(solver->map()), bcSet_(bcSet),
+      solverType_(BiCGstab), solver_(std::move(solver)) {}
+#endif
+
     Disposable<Array> ImplicitEulerScheme::apply(const Array& r, Real theta) const {
         return r - (theta*dt_)*map_->apply(r);
     }
@@ -52,6 +61,13 @@ namespace QuantLib {
         if (map_->size() == 1) {
             a = map_->solve_splitting(0, a, -theta*dt_);
         }
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        else if (solver_ != nullptr) {
+            const Size iterations = solver_->numberOfIterations();
+            a = solver_->solve(a, -theta*dt_, a);
+            (*iterations_) += solver_->numberOfIterations() - iterations;
+        }
+#endif
         else {
             auto preconditioner = [&](const Array& _a){ return map_->preconditioner(_a, -theta*dt_); };
             auto applyF = [&](const Array& _a){ return apply(_a, theta); };
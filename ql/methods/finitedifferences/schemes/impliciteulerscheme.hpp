@@ -32,6 +32,8 @@
 
 namespace QuantLib {
 
+    class FdmKrylovSolver;
+
     class ImplicitEulerScheme {
       public:
         enum SolverType { BiCGstab, GMRES };
@@ -48,6 +50,13 @@ namespace QuantLib {
                                      const bc_set& bcSet = bc_set(),
                                      Real relTol = 1e-8,
                                      SolverType solverType = BiCGstab);
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        /*! the implicit steps are solved by the given solver, with
+            its operator, unless the latter has a single dimension.
+        */
+        explicit ImplicitEulerScheme(ext::shared_ptr<FdmKrylovSolver> solver,
+                                     const bc_set& bcSet = bc_set());
+#endif
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
@@ -66,6 +75,7 @@ namespace QuantLib {
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
         const SolverType solverType_;
+        const ext::shared_ptr<FdmKrylovSolver> solver_;
     };
 }
 
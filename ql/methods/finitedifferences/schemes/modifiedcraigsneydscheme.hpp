@@ -50,7 +50,8 @@ namespace QuantLib {
         ModifiedCraigSneydScheme(Real theta,
                                  Real mu,
                                  ext::shared_ptr<FdmLinearOpComposite> map,
-                                 const bc_set& bcSet = bc_set());
+                                 const bc_set& bcSet = bc_set(),
+                                 Size threads = 1);
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
@@ -61,6 +62,10 @@ namespace QuantLib {
         const Real mu_;
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        const Size threads_;
+
+        // scratch arrays, reused across the steps
+        array_type y_, yt_, rhs_;
     };
 }
 
@@ -56,6 +56,12 @@ namespace QuantLib {
     }
 
 
+    void Fdm1DimSolver::setOperator(
+                              ext::shared_ptr<FdmLinearOpComposite> op) {
+        op_ = std::move(op);
+        update();
+    }
+
     void Fdm1DimSolver::performCalculations() const {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
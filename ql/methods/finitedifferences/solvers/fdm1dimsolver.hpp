@@ -41,6 +41,12 @@ namespace QuantLib {
                       const FdmSchemeDesc& schemeDesc,
                       ext::shared_ptr<FdmLinearOpComposite> op);
 
+        /*! replaces the operator, e.g., after a change of the market
+            data; the mesher, the initial values and the step
+            conditions are kept.
+        */
+        void setOperator(ext::shared_ptr<FdmLinearOpComposite> op);
+
         Real interpolateAt(Real x) const;
         Real thetaAt(Real x) const;
 
@@ -53,7 +59,7 @@ namespace QuantLib {
       private:
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
-        const ext::shared_ptr<FdmLinearOpComposite> op_;
+        ext::shared_ptr<FdmLinearOpComposite> op_;
 
         const ext::shared_ptr<FdmSnapshotCondition> thetaCondition_;
         const ext::shared_ptr<FdmStepConditionComposite> conditions_;
@@ -65,6 +65,12 @@ namespace QuantLib {
     }
 
 
+    void Fdm2DimSolver::setOperator(
+                              ext::shared_ptr<FdmLinearOpComposite> op) {
+        op_ = std::move(op);
+        update();
+    }
+
     void Fdm2DimSolver::performCalculations() const {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
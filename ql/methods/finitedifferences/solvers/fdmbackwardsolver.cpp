@@ -40,8 +40,15 @@
 
 namespace QuantLib {
     
-    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
-    : type(aType), theta(aTheta), mu(aMu) { }
+    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu,
+                                 Size aThreads)
+    : type(aType), theta(aTheta), mu(aMu), threads(aThreads) {
+        QL_REQUIRE(threads > 0, "at least one thread required");
+    }
+
+    FdmSchemeDesc FdmSchemeDesc::withThreads(Size threads) const {
+        return {type, theta, mu, threads};
+    }
 
     FdmSchemeDesc FdmSchemeDesc::Douglas() { return {FdmSchemeDesc::DouglasType, 0.5, 0.0}; }
 
@@ -109,7 +116,7 @@ namespace QuantLib {
           case FdmSchemeDesc::HundsdorferType:
             {
                 HundsdorferScheme hsEvolver(schemeDesc_.theta, schemeDesc_.mu, 
-                                            map_, bcSet_);
+                                            map_, bcSet_, schemeDesc_.threads);
                 FiniteDifferenceModel<HundsdorferScheme> 
                                hsModel(hsEvolver, condition_->stoppingTimes());
                 hsModel.rollback(rhs, dampingTo, to, steps, *condition_);
@@ -117,7 +124,8 @@ namespace QuantLib {
             break;
           case FdmSchemeDesc::DouglasType:
             {
-                DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_);
+                DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_,
+                                        schemeDesc_.threads);
                 FiniteDifferenceModel<DouglasScheme> 
                                dsModel(dsEvolver, condition_->stoppingTimes());
                 dsModel.rollback(rhs, dampingTo, to, steps, *condition_);
@@ -135,7 +143,7 @@ namespace QuantLib {
           case FdmSchemeDesc::CraigSneydType:
             {
                 CraigSneydScheme csEvolver(schemeDesc_.theta, schemeDesc_.mu, 
-                                           map_, bcSet_);
+                                           map_, bcSet_, schemeDesc_.threads);
                 FiniteDifferenceModel<CraigSneydScheme> 
                                csModel(csEvolver, condition_->stoppingTimes());
                 csModel.rollback(rhs, dampingTo, to, steps, *condition_);
@@ -145,7 +153,8 @@ namespace QuantLib {
             {
                 ModifiedCraigSneydScheme csEvolver(schemeDesc_.theta, 
                                                    schemeDesc_.mu,
-                                                   map_, bcSet_);
+                                                   map_, bcSet_,
+                                                   schemeDesc_.threads);
                 FiniteDifferenceModel<ModifiedCraigSneydScheme> 
                               mcsModel(csEvolver, condition_->stoppingTimes());
                 mcsModel.rollback(rhs, dampingTo, to, steps, *condition_);
@@ -183,7 +192,8 @@ namespace QuantLib {
 
                 const ext::shared_ptr<CraigSneydScheme> hsEvolver(
                     ext::make_shared<CraigSneydScheme>(
-                        trDesc.theta, trDesc.mu, map_, bcSet_));
+                        trDesc.theta, trDesc.mu, map_, bcSet_,
+                        schemeDesc_.threads));
 
                 TrBDF2Scheme<CraigSneydScheme> trBDF2(
                     schemeDesc_.theta, map_, hsEvolver, bcSet_,schemeDesc_.mu);
@@ -39,10 +39,20 @@ namespace QuantLib {
                              MethodOfLinesType, TrBDF2Type,
                              CrankNicolsonType };
 
-        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
+        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu,
+                      Size threads = 1);
 
         const FdmSchemeType type;
         const Real theta, mu;
+        /*! number of threads over which the ADI schemes (Douglas,
+            Craig-Sneyd, modified Craig-Sneyd and Hundsdorfer, also
+            within TR-BDF2) distribute the grid lines of the operators;
+            see FdmOperatorThreads.  The results don't depend on it.
+        */
+        const Size threads;
+
+        //! same scheme using the given number of threads
+        FdmSchemeDesc withThreads(Size threads) const;
 
         // some default scheme descriptions
         static FdmSchemeDesc Douglas(); //same as Crank-Nicolson in 1 dimension
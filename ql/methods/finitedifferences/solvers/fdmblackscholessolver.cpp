@@ -43,7 +43,7 @@ namespace QuantLib {
     }
 
     void FdmBlackScholesSolver::performCalculations() const {
-            const ext::shared_ptr<FdmBlackScholesOp> op(
+        const ext::shared_ptr<FdmBlackScholesOp> op(
             ext::make_shared<FdmBlackScholesOp>(
                 solverDesc_.mesher, process_.currentLink(), strike_,
                 localVol_, illegalLocalVolOverwrite_, 0,
@@ -51,7 +51,13 @@ namespace QuantLib {
                     ? ext::shared_ptr<FdmQuantoHelper>()
                     : quantoHelper_.currentLink()));
 
-        solver_ = ext::make_shared<Fdm1DimSolver>(solverDesc_, schemeDesc_, op);
+        // the mesher, the initial values and the step conditions
+        // don't depend on the market data and are kept
+        if (solver_ != nullptr)
+            solver_->setOperator(op);
+        else
+            solver_ = ext::make_shared<Fdm1DimSolver>(
+                solverDesc_, schemeDesc_, op);
     }
 
     Real FdmBlackScholesSolver::valueAt(Real s) const {
@@ -71,6 +77,7 @@ namespace QuantLib {
     }
 
     Real FdmBlackScholesSolver::thetaAt(Real s) const {
+        calculate();
         return solver_->thetaAt(std::log(s));
     }
 }
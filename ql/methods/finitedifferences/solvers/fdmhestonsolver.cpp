@@ -50,7 +50,13 @@ namespace QuantLib {
                              : ext::shared_ptr<FdmQuantoHelper>(),
                 leverageFct_, mixingFactor_));
 
-        solver_ = ext::make_shared<Fdm2DimSolver>(solverDesc_, schemeDesc_, op);
+        // the mesher, the initial values and the step conditions
+        // don't depend on the market data and are kept
+        if (solver_ != nullptr)
+            solver_->setOperator(op);
+        else
+            solver_ = ext::make_shared<Fdm2DimSolver>(
+                solverDesc_, schemeDesc_, op);
     }
 
     Real FdmHestonSolver::valueAt(Real s, Real v) const {
@@ -0,0 +1,213 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/qldefines.hpp>
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+
+#include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+#include <ql/methods/finitedifferences/operators/fdmoperatorthreads.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmkrylovsolver.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    FdmKrylovSolver::FdmKrylovSolver(ext::shared_ptr<FdmLinearOpComposite> map,
+                                     bool timeHomogeneous,
+                                     Real relTol,
+                                     SolverType solverType,
+                                     Size threads,
+                                     Monitor monitor)
+    : map_(std::move(map)), timeHomogeneous_(timeHomogeneous),
+      relTol_(relTol), solverType_(solverType), threads_(threads),
+      monitor_(std::move(monitor)), a_(Null<Real>()) {
+        QL_REQUIRE(map_, "null operator given");
+        QL_REQUIRE(threads_ > 0, "at least one thread required");
+    }
+
+    const ext::shared_ptr<FdmLinearOpComposite>& FdmKrylovSolver::map() const {
+        return map_;
+    }
+
+    Size FdmKrylovSolver::numberOfIterations() const {
+        return iterations_;
+    }
+
+    Size FdmKrylovSolver::numberOfFactorizations() const {
+        return factorizations_;
+    }
+
+    void FdmKrylovSolver::factorize(Real a) {
+        SparseMatrix m = map_->toMatrix();
+        m.complete_index1_data();
+        const Size n = m.size1();
+        const SparseMatrix::index_array_type& rows = m.index1_data();
+        const SparseMatrix::index_array_type& cols = m.index2_data();
+        const SparseMatrix::value_array_type& vals = m.value_data();
+
+        // 1 + a L, with the diagonal element stored even if L has none
+        rowStart_.resize(n+1);
+        diagonal_.resize(n);
+        columns_.clear();
+        values_.clear();
+        columns_.reserve(m.nnz() + n);
+        values_.reserve(m.nnz() + n);
+        for (Size i=0; i < n; ++i) {
+            rowStart_[i] = columns_.size();
+            diagonal_[i] = Null<Size>();
+            for (Size p=rows[i]; p < rows[i+1]; ++p) {
+                const Size j = cols[p];
+                if (diagonal_[i] == Null<Size>() && j >= i) {
+                    diagonal_[i] = columns_.size();
+                    columns_.push_back(i);
+                    values_.push_back(1.0);
+                    if (j == i) {
+                        values_.back() += a*vals[p];
+                        continue;
+                    }
+                }
+                columns_.push_back(j);
+                values_.push_back(a*vals[p]);
+            }
+            if (diagonal_[i] == Null<Size>()) {
+                diagonal_[i] = columns_.size();
+                columns_.push_back(i);
+                values_.push_back(1.0);
+            }
+        }
+        rowStart_[n] = columns_.size();
+
+        // incomplete LU without fill-in, row by row (Saad, Iterative
+        // methods for sparse linear systems, algorithm 10.4)
+        lu_ = values_;
+        std::vector<Size> position(n, Null<Size>());
+        for (Size i=0; i < n; ++i) {
+            for (Size p=rowStart_[i]; p < rowStart_[i+1]; ++p)
+                position[columns_[p]] = p;
+
+            for (Size p=rowStart_[i]; p < diagonal_[i]; ++p) {
+                const Size k = columns_[p];
+                lu_[p] /= lu_[diagonal_[k]];
+                for (Size q=diagonal_[k]+1; q < rowStart_[k+1]; ++q) {
+                    const Size r = position[columns_[q]];
+                    if (r != Null<Size>())
+                        lu_[r] -= lu_[p]*lu_[q];
+                }
+            }
+            QL_REQUIRE(lu_[diagonal_[i]] != 0.0,
+                       "zero pivot in incomplete LU factorization");
+
+            for (Size p=rowStart_[i]; p < rowStart_[i+1]; ++p)
+                position[columns_[p]] = Null<Size>();
+        }
+
+        a_ = a;
+        ++factorizations_;
+    }
+
+    void FdmKrylovSolver::multiply(const Array& x, Array& y) const {
+        const Size n = diagonal_.size();
+        y.resize(n);
+
+        if (!timeHomogeneous_) {
+            map_->applyTo(x, y);
+            for (Size i=0; i < n; ++i)
+                y[i] = x[i] + a_*y[i];
+            return;
+        }
+
+        #pragma omp parallel for if(FdmOperatorThreads::current() > 1) \
+            num_threads(FdmOperatorThreads::current())
+        for (long i=0; i < long(n); ++i) {
+            Real s = 0.0;
+            for (Size p=rowStart_[i]; p < rowStart_[i+1]; ++p)
+                s += values_[p]*x[columns_[p]];
+            y[i] = s;
+        }
+    }
+
+    void FdmKrylovSolver::precondition(const Array& b, Array& x) const {
+        const Size n = diagonal_.size();
+        x = b;
+
+        for (Size i=0; i < n; ++i) {
+            Real s = x[i];
+            for (Size p=rowStart_[i]; p < diagonal_[i]; ++p)
+                s -= lu_[p]*x[columns_[p]];
+            x[i] = s;
+        }
+        for (Size i=n; i > 0; --i) {
+            const Size d = diagonal_[i-1];
+            Real s = x[i-1];
+            for (Size p=d+1; p < rowStart_[i]; ++p)
+                s -= lu_[p]*x[columns_[p]];
+            x[i-1] = s/lu_[d];
+        }
+    }
+
+    Disposable<Array> FdmKrylovSolver::solve(const Array& b, Real a,
+                                             const Array& x0) {
+        const FdmOperatorThreads threads(threads_);
+
+        if (!timeHomogeneous_ || a != a_)
+            factorize(a);
+        QL_REQUIRE(b.size() == diagonal_.size(),
+                   "inconsistent array dimensions");
+
+        const auto applyF = [&](const Array& x) -> Disposable<Array> {
+            Array y(x.size());
+            multiply(x, y);
+            return y;
+        };
+        const auto preconditioner = [&](const Array& x) -> Disposable<Array> {
+            Array y(x.size());
+            precondition(x, y);
+            return y;
+        };
+
+        Array x;
+        Size iterations;
+        Real error;
+        if (solverType_ == BiCGstab) {
+            BiCGStabResult result =
+                QuantLib::BiCGstab(applyF, std::max(Size(10), b.size()),
+                                   relTol_, preconditioner).solve(b, x0);
+            iterations = result.iterations;
+            error = result.error;
+            x.swap(result.x);
+        } else if (solverType_ == GMRES) {
+            GMRESResult result =
+                QuantLib::GMRES(applyF, std::max(Size(10), b.size() / 10U),
+                                relTol_, preconditioner).solve(b, x0);
+            iterations = result.errors.size();
+            error = result.errors.empty() ? 0.0 : result.errors.back();
+            x.swap(result.x);
+        } else
+            QL_FAIL("unknown/illegal solver type");
+
+        iterations_ += iterations;
+        if (monitor_)
+            monitor_(iterations, error);
+
+        return x;
+    }
+
+}
+
+#endif
@@ -0,0 +1,112 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmkrylovsolver.hpp
+    \brief ILU-preconditioned Krylov solver for implicit finite-difference steps
+*/
+
+#ifndef quantlib_fdm_krylov_solver_hpp
+#define quantlib_fdm_krylov_solver_hpp
+
+#include <ql/qldefines.hpp>
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+
+#include <ql/functional.hpp>
+#include <ql/math/array.hpp>
+#include <ql/shared_ptr.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class FdmLinearOpComposite;
+
+    //! ILU-preconditioned Krylov solver for implicit finite-difference steps
+    /*! Solves \f$ (1 + a L) x = b \f$ with BiCGstab or GMRES, where
+        \f$ L \f$ is the operator at the time given to its last
+        setTime call.
+
+        The system matrix is assembled in compressed-row storage from
+        the sparse representation of the operator, and preconditioned
+        by its incomplete LU factorization without fill-in, stored in
+        the same pattern.  The matrix-vector products are distributed
+        over the given number of threads if the library is compiled
+        with OpenMP; see FdmOperatorThreads.
+
+        If the operator is declared time-homogeneous, the matrix and
+        its factorization are kept as long as \f$ a \f$ doesn't change,
+        and the products use the stored matrix.  Otherwise, they are
+        built again at each solve and the products use the operator.
+
+        \warning Declaring as time-homogeneous an operator whose
+                 coefficients change with time gives wrong results,
+                 since the changes are not seen by the solver.
+
+        \test the results are compared with the ones of the
+              operator-splitting preconditioner on the Heston
+              Hull-White and two-dimensional Black-Scholes operators.
+    */
+    class FdmKrylovSolver {
+      public:
+        enum SolverType { BiCGstab, GMRES };
+        /*! called after each solve with the number of iterations and
+            the relative residual.
+        */
+        typedef ext::function<void(Size, Real)> Monitor;
+
+        explicit FdmKrylovSolver(ext::shared_ptr<FdmLinearOpComposite> map,
+                                 bool timeHomogeneous = false,
+                                 Real relTol = 1e-8,
+                                 SolverType solverType = BiCGstab,
+                                 Size threads = 1,
+                                 Monitor monitor = Monitor());
+
+        const ext::shared_ptr<FdmLinearOpComposite>& map() const;
+
+        //! solves (1 + a L) x = b starting from x0
+        Disposable<Array> solve(const Array& b, Real a, const Array& x0);
+
+        Size numberOfIterations() const;
+        Size numberOfFactorizations() const;
+
+      private:
+        void factorize(Real a);
+        void multiply(const Array& x, Array& y) const;
+        void precondition(const Array& b, Array& x) const;
+
+        const ext::shared_ptr<FdmLinearOpComposite> map_;
+        const bool timeHomogeneous_;
+        const Real relTol_;
+        const SolverType solverType_;
+        const Size threads_;
+        const Monitor monitor_;
+
+        // 1 + a L in compressed-row storage; diagonal_ holds the
+        // position of the diagonal element of each row
+        std::vector<Size> rowStart_, columns_, diagonal_;
+        std::vector<Real> values_;
+        // incomplete LU factors in the same pattern, the unit
+        // diagonal of the lower factor being implied
+        std::vector<Real> lu_;
+        Real a_;
+        Size iterations_ = 0, factorizations_ = 0;
+    };
+
+}
+
+#endif
+#endif
@@ -0,0 +1,127 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchmontecarlomodel.hpp
+    \brief Monte Carlo model working on batches of paths
+*/
+
+#ifndef quantlib_batch_montecarlo_model_hpp
+#define quantlib_batch_montecarlo_model_hpp
+
+#include <ql/math/statistics/statistics.hpp>
+#include <ql/methods/montecarlo/multipathbatchgenerator.hpp>
+#include <ql/shared_ptr.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! base class for pricers of path batches
+    /*! \ingroup mcarlo */
+    class BatchPathPricer {
+      public:
+        virtual ~BatchPathPricer() = default;
+        //! writes the value of the k-th path of the batch in values[k]
+        virtual void operator()(const MultiPathBatch& paths,
+                                Real* values) const = 0;
+    };
+
+
+    //! Monte Carlo model for batches of multi-asset paths
+    /*! This is the counterpart of MonteCarloModel for engines that
+        price whole batches of paths at once (see
+        MultiPathBatchGenerator).  Samples are added to the
+        accumulator in the same order in which the generator draws
+        them; paths drawn but not yet used are kept for the next
+        call to addSamples().  Thus, the accumulated statistics are
+        the same as those of a MonteCarloModel using the equivalent
+        path generator and pricer, regardless of the batch size.
+
+        \ingroup mcarlo
+    */
+    template <class GSG, class S = Statistics>
+    class BatchMonteCarloModel {
+      public:
+        typedef MultiPathBatchGenerator<GSG> path_generator_type;
+        typedef BatchPathPricer path_pricer_type;
+        typedef S stats_type;
+        BatchMonteCarloModel(
+            ext::shared_ptr<path_generator_type> pathGenerator,
+            ext::shared_ptr<path_pricer_type> pathPricer,
+            stats_type sampleAccumulator,
+            bool antitheticVariate)
+        : pathGenerator_(std::move(pathGenerator)),
+          pathPricer_(std::move(pathPricer)),
+          sampleAccumulator_(std::move(sampleAccumulator)),
+          isAntitheticVariate_(antitheticVariate),
+          values_(pathGenerator_->batchSize()),
+          antitheticValues_(isAntitheticVariate_ ?
+                            pathGenerator_->batchSize() : 0),
+          weights_(pathGenerator_->batchSize()),
+          next_(pathGenerator_->batchSize()) {}
+        void addSamples(Size samples);
+        const stats_type& sampleAccumulator() const;
+      private:
+        void nextBatch();
+        ext::shared_ptr<path_generator_type> pathGenerator_;
+        ext::shared_ptr<path_pricer_type> pathPricer_;
+        stats_type sampleAccumulator_;
+        bool isAntitheticVariate_;
+        std::vector<Real> values_, antitheticValues_, weights_;
+        // index of the first sample of the current batch not yet used
+        Size next_;
+    };
+
+    // inline definitions
+    template <class GSG, class S>
+    inline void BatchMonteCarloModel<GSG,S>::addSamples(Size samples) {
+        while (samples > 0) {
+            if (next_ == values_.size())
+                nextBatch();
+            Size n = std::min(samples, values_.size()-next_);
+            for (Size k=next_; k<next_+n; ++k)
+                sampleAccumulator_.add(values_[k], weights_[k]);
+            next_ += n;
+            samples -= n;
+        }
+    }
+
+    template <class GSG, class S>
+    inline void BatchMonteCarloModel<GSG,S>::nextBatch() {
+        const MultiPathBatch& paths = pathGenerator_->next();
+        weights_ = paths.weights();
+        (*pathPricer_)(paths, &values_[0]);
+        if (isAntitheticVariate_) {
+            (*pathPricer_)(pathGenerator_->antithetic(),
+                           &antitheticValues_[0]);
+            for (Size k=0; k<values_.size(); ++k)
+                values_[k] = (values_[k]+antitheticValues_[k])/2.0;
+        }
+        next_ = 0;
+    }
+
+    template <class GSG, class S>
+    inline const typename BatchMonteCarloModel<GSG,S>::stats_type&
+    BatchMonteCarloModel<GSG,S>::sampleAccumulator() const {
+        return sampleAccumulator_;
+    }
+
+}
+
+
+#endif
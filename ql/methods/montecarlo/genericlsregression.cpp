@@ -18,61 +18,74 @@
 */
 
 #include <ql/methods/montecarlo/genericlsregression.hpp>
-#include <ql/math/statistics/sequencestatistics.hpp>
-#include <ql/math/matrixutilities/svd.hpp>
+#include <ql/methods/montecarlo/normalequationsregression.hpp>
+#include <ql/math/statistics/statistics.hpp>
+#include <exception>
 
 namespace QuantLib {
 
     Real genericLongstaffSchwartzRegression(
                 std::vector<std::vector<NodeData> >& simulationData,
-                std::vector<std::vector<Real> >& basisCoefficients) {
+                std::vector<std::vector<Real> >& basisCoefficients,
+                Size threads) {
 
+        QL_REQUIRE(threads > 0, "at least one thread required");
         Size steps = simulationData.size();
         basisCoefficients.resize(steps-1);
 
+        // the workspace is reused across exercise dates
+        NormalEquationsRegression regression(threads);
+        std::vector<Size> validPaths;
+        // exceptions can't leave the parallel loops; the first one
+        // is stored and rethrown after the loop.
+        std::exception_ptr error;
+
         for (Size i=steps-1; i!=0; --i) {
 
             std::vector<NodeData>& exerciseData = simulationData[i];
 
-            // 1) find the covariance matrix of basis function values and
-            //    deflated cash-flows
+            // 1) collect basis function values and deflated cash-flows
+            //    of valid paths
             Size N = exerciseData.front().values.size();
-            std::vector<Real> temp(N+1);
-            SequenceStatistics stats(N+1);
-
-            Size j;
-            for (j=0; j<exerciseData.size(); ++j) {
-                if (exerciseData[j].isValid) {
-                    std::copy(exerciseData[j].values.begin(),
-                              exerciseData[j].values.end(),
-                              temp.begin());
-                    temp.back() = exerciseData[j].cumulatedCashFlows
-                                - exerciseData[j].controlValue;
-
-                    stats.add(temp);
-                }
+            validPaths.clear();
+            for (Size j=0; j<exerciseData.size(); ++j) {
+                if (exerciseData[j].isValid)
+                    validPaths.push_back(j);
             }
-
-            std::vector<Real> means = stats.mean();
-            Matrix covariance = stats.covariance();
-
-            Matrix C(N,N);
-            Array target(N);
-            for (Size k=0; k<N; ++k) {
-                target[k] = covariance[k][N] + means[k]*means[N];
-                for (Size l=0; l<=k; ++l)
-                    C[k][l] = C[l][k] = covariance[k][l] + means[k]*means[l];
+            QL_REQUIRE(!validPaths.empty(), "empty sample set");
+
+            regression.resize(validPaths.size(), N);
+            Real* design = regression.design();
+            Real* targets = regression.targets();
+
+            #pragma omp parallel for if(threads > 1) num_threads(threads)
+            for (long k=0; k<(long)validPaths.size(); ++k) {
+                try {
+                    const NodeData& data = exerciseData[validPaths[k]];
+                    QL_REQUIRE(data.values.size() == N,
+                               "inconsistent number of basis values");
+                    std::copy(data.values.begin(), data.values.end(),
+                              design + k*N);
+                    targets[k] = data.cumulatedCashFlows - data.controlValue;
+                } catch (...) {
+                    #pragma omp critical(ql_generic_ls_regression)
+                    if (!error)
+                        error = std::current_exception();
+                }
             }
+            if (error)
+                std::rethrow_exception(error);
 
             // 2) solve for least squares regression
-            Array alphas = SVD(C).solveFor(target);
-            basisCoefficients[i-1].resize(N);
-            std::copy(alphas.begin(), alphas.end(),
-                      basisCoefficients[i-1].begin());
+            const Array& alphas = regression.solve();
+            basisCoefficients[i-1].assign(alphas.begin(), alphas.end());
 
             // 3) use exercise strategy to divide paths into exercise and
             //    non-exercise domains
-            for (j=0; j<exerciseData.size(); ++j) {
+            std::vector<NodeData>& previousData = simulationData[i-1];
+
+            #pragma omp parallel for if(threads > 1) num_threads(threads)
+            for (long j=0; j<(long)exerciseData.size(); ++j) {
                 if (exerciseData[j].isValid) {
                     Real exerciseValue = exerciseData[j].exerciseValue;
                     Real continuationValue =
@@ -92,7 +105,7 @@ namespace QuantLib {
                                  exerciseValue :
                                  continuationValue;
 
-                    simulationData[i-1][j].cumulatedCashFlows += value;
+                    previousData[j].cumulatedCashFlows += value;
                 }
             }
         }
@@ -108,4 +121,3 @@ namespace QuantLib {
     }
 
 }
-
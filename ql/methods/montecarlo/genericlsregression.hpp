@@ -35,9 +35,13 @@ namespace QuantLib {
 
        basisCoefficients.size() = n
     */
+    /*! If more than one thread is given and the library is compiled
+        with OpenMP, the work over paths is distributed among them.
+    */
     Real genericLongstaffSchwartzRegression(
         std::vector<std::vector<NodeData> >& simulationData,
-        std::vector<std::vector<Real> >& basisCoefficients);
+        std::vector<std::vector<Real> >& basisCoefficients,
+        Size threads = 1);
 
 }
 
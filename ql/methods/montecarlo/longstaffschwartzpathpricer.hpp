@@ -29,13 +29,16 @@
 #include <ql/functional.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
-#include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
+#include <ql/methods/montecarlo/normalequationsregression.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/threadlocalsettings.hpp>
 #if !defined(QL_USE_STD_UNIQUE_PTR)
 #include <boost/scoped_array.hpp>
 #endif
+#include <atomic>
+#include <exception>
 #include <utility>
 #include <memory>
 
@@ -58,12 +61,23 @@ namespace QuantLib {
       public:
         typedef typename EarlyExerciseTraits<PathType>::StateType StateType;
 
+        /*! If more than one thread is given and the library is
+            compiled with OpenMP, the calibration distributes its
+            work over paths among them.
+        */
         LongstaffSchwartzPathPricer(const TimeGrid& times,
                                     ext::shared_ptr<EarlyExercisePathPricer<PathType> >,
-                                    const ext::shared_ptr<YieldTermStructure>& termStructure);
+                                    const ext::shared_ptr<YieldTermStructure>& termStructure,
+                                    Size threads = 1);
 
         Real operator()(const PathType& path) const override;
         virtual void calibrate();
+        //! adds paths collected elsewhere to the calibration set
+        /*! This allows calibration paths to be generated on several
+            threads, e.g., by LongstaffSchwartzPathCollector
+            instances.
+        */
+        void addCalibrationPaths(const std::vector<PathType>& paths);
 
         Real exerciseProbability() const;
 
@@ -76,7 +90,8 @@ namespace QuantLib {
         const ext::shared_ptr<EarlyExercisePathPricer<PathType> >
             pathPricer_;
 
-        mutable QuantLib::IncrementalStatistics exerciseProbability_;
+        // counters are atomic so that paths can be priced concurrently
+        mutable std::atomic<Size> exercisedPaths_, pricedPaths_;
 
         #if defined(QL_USE_STD_UNIQUE_PTR)
         std::unique_ptr<Array[]> coeff_;
@@ -90,16 +105,35 @@ namespace QuantLib {
         const   std::vector<ext::function<Real(StateType)> > v_;
 
         const Size len_;
+        const Size threads_;
+    };
+
+    //! stores calibration paths for a Longstaff-Schwarz path pricer
+    /*! \ingroup mcarlo */
+    template <class PathType>
+    class LongstaffSchwartzPathCollector : public PathPricer<PathType> {
+      public:
+        Real operator()(const PathType& path) const override {
+            paths_.push_back(path);
+            // result doesn't matter
+            return 0.0;
+        }
+        const std::vector<PathType>& paths() const { return paths_; }
+      private:
+        mutable std::vector<PathType> paths_;
     };
 
     template <class PathType>
     inline LongstaffSchwartzPathPricer<PathType>::LongstaffSchwartzPathPricer(
         const TimeGrid& times,
         ext::shared_ptr<EarlyExercisePathPricer<PathType> > pathPricer,
-        const ext::shared_ptr<YieldTermStructure>& termStructure)
+        const ext::shared_ptr<YieldTermStructure>& termStructure,
+        Size threads)
     : calibrationPhase_(true), pathPricer_(std::move(pathPricer)),
+      exercisedPaths_(0), pricedPaths_(0),
       coeff_(new Array[times.size() - 2]), dF_(new DiscountFactor[times.size() - 1]),
-      v_(pathPricer_->basisSystem()), len_(times.size()) {
+      v_(pathPricer_->basisSystem()), len_(times.size()), threads_(threads) {
+        QL_REQUIRE(threads_ > 0, "at least one thread required");
 
         for (Size i=0; i<times.size()-1; ++i) {
             dF_[i] =   termStructure->discount(times[i+1])
@@ -143,7 +177,9 @@ namespace QuantLib {
             }
         }
 
-        exerciseProbability_.add(exercised ? 1.0 : 0.0);
+        if (exercised)
+            ++exercisedPaths_;
+        ++pricedPaths_;
 
         return price*dF_[0];
     }
@@ -151,55 +187,108 @@ namespace QuantLib {
     template <class PathType> inline
     void LongstaffSchwartzPathPricer<PathType>::calibrate() {
         const Size n = paths_.size();
+        const Size m = v_.size();
         Array prices(n), exercise(n);
         std::vector<StateType> p_state(n);
         std::vector<Real> p_price(n), p_exercise(n);
 
-        for (Size i=0; i<n; ++i) {
-            p_state[i] = pathPricer_->state(paths_[i],len_-1);
-            prices[i] = p_price[i] = (*pathPricer_)(paths_[i], len_-1);
-            p_exercise[i] = prices[i];
+        // exceptions can't leave the parallel loops; the first one
+        // is stored and rethrown after the loop.
+        std::exception_ptr error;
+        const SharedSettings settings;
+
+        #pragma omp parallel for if(threads_ > 1) num_threads(threads_)
+        for (long i=0; i<(long)n; ++i) {
+            const SharedSettings::Scope scope(settings);
+            try {
+                p_state[i] = pathPricer_->state(paths_[i],len_-1);
+                prices[i] = p_price[i] = (*pathPricer_)(paths_[i], len_-1);
+                p_exercise[i] = prices[i];
+            } catch (...) {
+                #pragma omp critical(ql_longstaff_schwartz_calibration)
+                if (!error)
+                    error = std::current_exception();
+            }
         }
+        if (error)
+            std::rethrow_exception(error);
 
         post_processing(len_ - 1, p_state, p_price, p_exercise);
 
-        std::vector<Real>      y;
-        std::vector<StateType> x;
+        // in-the-money paths and their regression data; buffers are
+        // reused across exercise dates
+        std::vector<Size> itm;
+        itm.reserve(n);
+        NormalEquationsRegression regression(threads_);
+
         for (Size i=len_-2; i>0; --i) {
-            y.clear();
-            x.clear();
 
             //roll back step
-            for (Size j=0; j<n; ++j) {
-                exercise[j]=(*pathPricer_)(paths_[j], i);
-                if (exercise[j]>0.0) {
-                    x.push_back(pathPricer_->state(paths_[j], i));
-                    y.push_back(dF_[i]*prices[j]);
+            #pragma omp parallel for if(threads_ > 1) num_threads(threads_)
+            for (long j=0; j<(long)n; ++j) {
+                const SharedSettings::Scope scope(settings);
+                try {
+                    prices[j] *= dF_[i];
+                    exercise[j] = (*pathPricer_)(paths_[j], i);
+                    p_state[j] = pathPricer_->state(paths_[j], i);
+                } catch (...) {
+                    #pragma omp critical(ql_longstaff_schwartz_calibration)
+                    if (!error)
+                        error = std::current_exception();
                 }
             }
+            if (error)
+                std::rethrow_exception(error);
 
-            if (v_.size() <=  x.size()) {
-                coeff_[i-1] = GeneralLinearLeastSquares(x, y, v_).coefficients();
+            itm.clear();
+            for (Size j=0; j<n; ++j) {
+                if (exercise[j]>0.0)
+                    itm.push_back(j);
+            }
+
+            if (m <= itm.size()) {
+                regression.resize(itm.size(), m);
+                Real* design = regression.design();
+                Real* targets = regression.targets();
+
+                #pragma omp parallel for if(threads_ > 1) num_threads(threads_)
+                for (long k=0; k<(long)itm.size(); ++k) {
+                    const SharedSettings::Scope scope(settings);
+                    try {
+                        const Size j = itm[k];
+                        for (Size l=0; l<m; ++l)
+                            design[k*m+l] = v_[l](p_state[j]);
+                        targets[k] = prices[j];
+                    } catch (...) {
+                        #pragma omp critical(ql_longstaff_schwartz_calibration)
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                }
+                if (error)
+                    std::rethrow_exception(error);
+                coeff_[i-1] = regression.solve();
+
+                const Array& coeff = coeff_[i-1];
+                #pragma omp parallel for if(threads_ > 1) num_threads(threads_)
+                for (long k=0; k<(long)itm.size(); ++k) {
+                    const Size j = itm[k];
+                    Real continuationValue = 0.0;
+                    for (Size l=0; l<m; ++l)
+                        continuationValue += coeff[l] * design[k*m+l];
+                    if (continuationValue < exercise[j])
+                        prices[j] = exercise[j];
+                }
             }
             else {
             // if number of itm paths is smaller then the number of
             // calibration functions then early exercise if exerciseValue > 0
-                coeff_[i-1] = Array(v_.size(), 0.0);
+                coeff_[i-1] = Array(m, 0.0);
+                for (Size j : itm)
+                    prices[j] = exercise[j];
             }
 
-            for (Size j=0, k=0; j<n; ++j) {
-                prices[j]*=dF_[i];
-                if (exercise[j]>0.0) {
-                    Real continuationValue = 0.0;
-                    for (Size l=0; l<v_.size(); ++l) {
-                        continuationValue += coeff_[i-1][l] * v_[l](x[k]);
-                    }
-                    if (continuationValue < exercise[j]) {
-                        prices[j] = exercise[j];
-                    }
-                    ++k;
-                }
-                p_state[j] = pathPricer_->state(paths_[j],i);
+            for (Size j=0; j<n; ++j) {
                 p_price[j] = prices[j];
                 p_exercise[j] = exercise[j];
             }
@@ -214,9 +303,18 @@ namespace QuantLib {
         calibrationPhase_ = false;
     }
 
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::addCalibrationPaths(
+                                       const std::vector<PathType>& paths) {
+        QL_REQUIRE(calibrationPhase_, "pricer already calibrated");
+        paths_.insert(paths_.end(), paths.begin(), paths.end());
+    }
+
     template <class PathType> inline
     Real LongstaffSchwartzPathPricer<PathType>::exerciseProbability() const {
-        return exerciseProbability_.mean();
+        const Size n = pricedPaths_;
+        QL_REQUIRE(n > 0, "empty sample set");
+        return Real(exercisedPaths_) / Real(n);
     }
 
 
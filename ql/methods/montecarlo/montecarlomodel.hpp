@@ -28,7 +28,11 @@
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/shared_ptr.hpp>
+#include <ql/threadlocalsettings.hpp>
+#include <algorithm>
+#include <exception>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -46,6 +50,10 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        Samples can be drawn on several threads by passing a path
+        generator and a path pricer for each worker; see
+        setWorkers() for details.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -76,7 +84,43 @@ namespace QuantLib {
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator() const;
+        //! enables multithreaded sampling
+        /*! Each worker uses its own path generator and path pricer;
+            the generators must draw from non-overlapping random
+            streams (see the stream-based factories in rngtraits.hpp).
+            For traits whose streams have a finite length, such as
+            the low-discrepancy ones, an exception is raised if a
+            worker would draw past the end of its stream.  The
+            control-variate path pricer, if any, is shared among
+            workers and must be safe to call concurrently; a separate
+            control-variate path generator is not supported.
+
+            Each call to addSamples() splits the required samples
+            among the workers in a fixed way and adds their results
+            to the accumulator in worker order; therefore, results
+            are reproducible for a given seed and number of workers,
+            regardless of the number of threads actually used.
+            Workers run in parallel if the library is compiled with
+            OpenMP support, and sequentially otherwise.
+
+            \warning the underlying process and any term structures
+                     it uses are accessed concurrently; lazy objects
+                     are calculated when the first sample is drawn,
+                     which is done before the other workers start.
+        */
+        void setWorkers(
+                std::vector<ext::shared_ptr<path_generator_type> > pathGenerators,
+                std::vector<ext::shared_ptr<path_pricer_type> > pathPricers);
+        Size workers() const;
       private:
+        typedef std::vector<std::pair<result_type, Real> > sample_buffer;
+        std::pair<result_type, Real> nextSample(
+                                const path_generator_type& pathGenerator,
+                                const path_pricer_type& pathPricer,
+                                const path_generator_type* cvPathGenerator) const;
+        void addSamplesInParallel(Size samples);
+        void runWorker(Size worker, Size samples,
+                       sample_buffer& results) const;
         ext::shared_ptr<path_generator_type> pathGenerator_;
         ext::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -85,43 +129,154 @@ namespace QuantLib {
         result_type cvOptionValue_;
         bool isControlVariate_;
         ext::shared_ptr<path_generator_type> cvPathGenerator_;
+        std::vector<ext::shared_ptr<path_generator_type> > workerGenerators_;
+        std::vector<ext::shared_ptr<path_pricer_type> > workerPricers_;
+        std::vector<Size> workerDraws_;
     };
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        if (workerGenerators_.size() > 1) {
+            addSamplesInParallel(samples);
+            return;
+        }
+
         for(Size j = 1; j <= samples; j++) {
+            std::pair<result_type, Real> sample =
+                nextSample(*pathGenerator_, *pathPricer_,
+                           cvPathGenerator_.get());
+            sampleAccumulator_.add(sample.first, sample.second);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline std::pair<typename MonteCarloModel<MC,RNG,S>::result_type, Real>
+    MonteCarloModel<MC,RNG,S>::nextSample(
+                        const path_generator_type& pathGenerator,
+                        const path_pricer_type& pathPricer,
+                        const path_generator_type* cvPathGenerator) const {
 
-            const sample_type& path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+        const sample_type& path = pathGenerator.next();
+        result_type price = pathPricer(path.value);
 
+        if (isControlVariate_) {
+            if (cvPathGenerator == nullptr) {
+                price += cvOptionValue_-(*cvPathPricer_)(path.value);
+            }
+            else {
+                const sample_type& cvPath = cvPathGenerator->next();
+                price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+            }
+        }
+
+        if (isAntitheticVariate_) {
+            const sample_type& atPath = pathGenerator.antithetic();
+            result_type price2 = pathPricer(atPath.value);
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
+                if (cvPathGenerator == nullptr)
+                    price2 += cvOptionValue_-(*cvPathPricer_)(atPath.value);
                 else {
-                    const sample_type& cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                    const sample_type& cvPath = cvPathGenerator->antithetic();
+                    price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
                 }
             }
 
-            if (isAntitheticVariate_) {
-                const sample_type& atPath = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(atPath.value);
-                if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(atPath.value);
-                    else {
-                        const sample_type& cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
-                    }
-                }
+            return std::make_pair(result_type((price+price2)/2.0),
+                                  path.weight);
+        } else {
+            return std::make_pair(price, path.weight);
+        }
+    }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
-            } else {
-                sampleAccumulator_.add(price, path.weight);
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::setWorkers(
+            std::vector<ext::shared_ptr<path_generator_type> > pathGenerators,
+            std::vector<ext::shared_ptr<path_pricer_type> > pathPricers) {
+        QL_REQUIRE(!pathGenerators.empty(), "no workers given");
+        QL_REQUIRE(pathGenerators.size() == pathPricers.size(),
+                   "number of path generators (" << pathGenerators.size()
+                   << ") different from number of path pricers ("
+                   << pathPricers.size() << ")");
+        QL_REQUIRE(!cvPathGenerator_,
+                   "multithreaded sampling not supported "
+                   "with a control-variate path generator");
+        for (Size i=0; i<pathGenerators.size(); ++i)
+            QL_REQUIRE(pathGenerators[i] && pathPricers[i],
+                       "null path generator or pricer for worker " << i);
+        workerGenerators_ = std::move(pathGenerators);
+        workerPricers_ = std::move(pathPricers);
+        workerDraws_.assign(workerGenerators_.size(), 0);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Size MonteCarloModel<MC,RNG,S>::workers() const {
+        return std::max<Size>(workerGenerators_.size(), 1);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::runWorker(
+                                              Size worker, Size samples,
+                                              sample_buffer& results) const {
+        for (Size j=0; j<samples; ++j)
+            results.push_back(nextSample(*workerGenerators_[worker],
+                                         *workerPricers_[worker],
+                                         nullptr));
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamplesInParallel(
+                                                             Size samples) {
+        const Size n = workerGenerators_.size();
+        std::vector<sample_buffer> results(n);
+        std::vector<std::exception_ptr> errors(n);
+
+        std::vector<Size> workerSamples(n, samples/n);
+        for (Size i=0; i<samples%n; ++i)
+            ++workerSamples[i];
+        // each sample draws one sequence from the worker stream
+        const Size streamLength = detail::SequenceStreamLength<RNG>::value();
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(streamLength == Null<Size>() ||
+                       workerDraws_[i] + workerSamples[i] <= streamLength,
+                       "worker " << i << " would draw "
+                       << workerDraws_[i] + workerSamples[i]
+                       << " sequences, but its stream provides only "
+                       << streamLength << "; use more threads or "
+                       "fewer samples");
+            workerDraws_[i] += workerSamples[i];
+            results[i].reserve(workerSamples[i]);
+        }
+
+        // the first sample is drawn before starting the parallel
+        // loop, so that any lazy calculation triggered by path
+        // generation or pricing is not done concurrently.
+        if (workerSamples[0] > 0)
+            runWorker(0, 1, results[0]);
+
+        const SharedSettings settings;
+        #pragma omp parallel for num_threads((int)n)
+        for (long i=0; i<(long)n; ++i) {
+            const SharedSettings::Scope scope(settings);
+            const Size remaining = (i == 0 && workerSamples[0] > 0) ?
+                                   workerSamples[0]-1 : workerSamples[i];
+            try {
+                runWorker(i, remaining, results[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
             }
         }
+
+        for (Size i=0; i<n; ++i) {
+            if (errors[i])
+                std::rethrow_exception(errors[i]);
+        }
+
+        for (Size i=0; i<n; ++i) {
+            for (Size j=0; j<results[i].size(); ++j)
+                sampleAccumulator_.add(results[i][j].first,
+                                       results[i][j].second);
+        }
     }
 
     template <template <class> class MC, class RNG, class S>
@@ -0,0 +1,92 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multipathbatch.hpp
+    \brief Batch of correlated multiple asset paths
+*/
+
+#ifndef quantlib_montecarlo_multi_path_batch_hpp
+#define quantlib_montecarlo_multi_path_batch_hpp
+
+#include <ql/timegrid.hpp>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Batch of correlated multiple asset paths
+    /*! MultiPathBatch stores a number of multi-asset paths on the
+        same time grid in a single buffer laid out by time step, then
+        by asset, then by path; that is, the values of a given asset
+        at a given step are contiguous across paths and can be
+        processed by loops running over the paths.
+
+        \ingroup mcarlo
+    */
+    class MultiPathBatch {
+      public:
+        MultiPathBatch() = default;
+        MultiPathBatch(Size nAsset, Size nPaths, TimeGrid timeGrid);
+        //! \name inspectors
+        //@{
+        Size assetNumber() const { return nAsset_; }
+        Size pathNumber() const { return nPaths_; }
+        Size pathSize() const { return timeGrid_.size(); }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //@}
+        //! \name read/write access to components
+        //@{
+        //! value of the given asset at the given step for the given path
+        Real operator()(Size step, Size asset, Size path) const {
+            return values_[(step*nAsset_+asset)*nPaths_+path];
+        }
+        Real& operator()(Size step, Size asset, Size path) {
+            return values_[(step*nAsset_+asset)*nPaths_+path];
+        }
+        //! values of the given asset at the given step for all paths
+        const Real* values(Size step, Size asset) const {
+            return &values_[(step*nAsset_+asset)*nPaths_];
+        }
+        Real* values(Size step, Size asset) {
+            return &values_[(step*nAsset_+asset)*nPaths_];
+        }
+        //! sample weights of the paths
+        const std::vector<Real>& weights() const { return weights_; }
+        std::vector<Real>& weights() { return weights_; }
+        //@}
+      private:
+        Size nAsset_ = 0, nPaths_ = 0;
+        TimeGrid timeGrid_;
+        std::vector<Real> values_, weights_;
+    };
+
+
+    // inline definitions
+
+    inline MultiPathBatch::MultiPathBatch(Size nAsset,
+                                          Size nPaths,
+                                          TimeGrid timeGrid)
+    : nAsset_(nAsset), nPaths_(nPaths), timeGrid_(std::move(timeGrid)),
+      values_(timeGrid_.size()*nAsset*nPaths), weights_(nPaths, 1.0) {
+        QL_REQUIRE(nAsset > 0, "number of asset must be positive");
+        QL_REQUIRE(nPaths > 0, "number of paths must be positive");
+    }
+
+}
+
+
+#endif
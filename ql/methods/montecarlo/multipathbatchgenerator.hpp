@@ -0,0 +1,161 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multipathbatchgenerator.hpp
+    \brief Generates a batch of multi paths from a random-array generator
+*/
+
+#ifndef quantlib_multi_path_batch_generator_hpp
+#define quantlib_multi_path_batch_generator_hpp
+
+#include <ql/methods/montecarlo/multipathbatch.hpp>
+#include <ql/processes/stochasticprocessarray.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Generates a batch of multipaths from a random number generator.
+    /*! Each path in the batch consumes one sequence from the
+        generator, exactly as MultiPathGenerator does; therefore, the
+        k-th path of a batch equals the path that MultiPathGenerator
+        would have returned at the corresponding draw.  The
+        increments are then rearranged by step and factor so that the
+        whole batch can be evolved at once through
+        StochasticProcess::evolveBatch().  For arrays of correlated
+        processes, the buffer for the correlated increments is kept
+        by the generator and reused across steps and batches.
+
+        \ingroup mcarlo
+
+        \test the generated paths are checked against those returned
+              by MultiPathGenerator.
+    */
+    template <class GSG>
+    class MultiPathBatchGenerator {
+      public:
+        typedef MultiPathBatch sample_type;
+        MultiPathBatchGenerator(ext::shared_ptr<StochasticProcess>,
+                                const TimeGrid&,
+                                GSG generator,
+                                Size batchSize);
+        //! draws a new batch of paths
+        const sample_type& next() const;
+        //! returns the antithetic batch of the last one drawn
+        const sample_type& antithetic() const;
+        Size batchSize() const { return next_.pathNumber(); }
+        GSG& generator() { return generator_; }
+      private:
+        void evolve() const;
+        ext::shared_ptr<StochasticProcess> process_;
+        ext::shared_ptr<StochasticProcessArray> processArray_;
+        GSG generator_;
+        mutable sample_type next_;
+        // Brownian increments as [step][factor][path]; negated_ tells
+        // whether they were flipped for the antithetic batch
+        mutable std::vector<Real> dw_;
+        mutable bool negated_ = false;
+        mutable std::vector<Real> workspace_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    MultiPathBatchGenerator<GSG>::MultiPathBatchGenerator(
+                                ext::shared_ptr<StochasticProcess> process,
+                                const TimeGrid& times,
+                                GSG generator,
+                                Size batchSize)
+    : process_(std::move(process)),
+      processArray_(
+          ext::dynamic_pointer_cast<StochasticProcessArray>(process_)),
+      generator_(std::move(generator)),
+      next_(process_->size(), batchSize, times),
+      dw_(process_->factors()*(times.size()-1)*batchSize) {
+
+        QL_REQUIRE(generator_.dimension() ==
+                   process_->factors()*(times.size()-1),
+                   "dimension (" << generator_.dimension()
+                   << ") is not equal to ("
+                   << process_->factors() << " * " << times.size()-1
+                   << ") the number of factors "
+                   << "times the number of time steps");
+        QL_REQUIRE(times.size() > 1,
+                   "no times given");
+        if (processArray_)
+            workspace_.resize(process_->size()*batchSize);
+    }
+
+    template <class GSG>
+    const typename MultiPathBatchGenerator<GSG>::sample_type&
+    MultiPathBatchGenerator<GSG>::next() const {
+        const Size n = next_.pathNumber();
+        const Size dim = generator_.dimension();
+        std::vector<Real>& weights = next_.weights();
+        for (Size k=0; k<n; ++k) {
+            typedef typename GSG::sample_type sequence_type;
+            const sequence_type& sequence = generator_.nextSequence();
+            weights[k] = sequence.weight;
+            for (Size d=0; d<dim; ++d)
+                dw_[d*n+k] = sequence.value[d];
+        }
+        negated_ = false;
+        evolve();
+        return next_;
+    }
+
+    template <class GSG>
+    const typename MultiPathBatchGenerator<GSG>::sample_type&
+    MultiPathBatchGenerator<GSG>::antithetic() const {
+        if (!negated_) {
+            for (Real& w : dw_)
+                w = -w;
+            negated_ = true;
+        }
+        evolve();
+        return next_;
+    }
+
+    template <class GSG>
+    void MultiPathBatchGenerator<GSG>::evolve() const {
+        const Size m = process_->size();
+        const Size f = process_->factors();
+        const Size n = next_.pathNumber();
+
+        Array asset = process_->initialValues();
+        for (Size j=0; j<m; ++j)
+            std::fill(next_.values(0,j), next_.values(0,j)+n, asset[j]);
+
+        const TimeGrid& timeGrid = next_.timeGrid();
+        for (Size i=1; i<next_.pathSize(); ++i) {
+            if (processArray_)
+                processArray_->evolveBatch(timeGrid[i-1],
+                                           next_.values(i-1,0),
+                                           timeGrid.dt(i-1),
+                                           &dw_[(i-1)*f*n],
+                                           next_.values(i,0), n,
+                                           &workspace_[0]);
+            else
+                process_->evolveBatch(timeGrid[i-1], next_.values(i-1,0),
+                                      timeGrid.dt(i-1), &dw_[(i-1)*f*n],
+                                      next_.values(i,0), n);
+        }
+    }
+
+}
+
+#endif
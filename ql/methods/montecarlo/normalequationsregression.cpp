@@ -0,0 +1,111 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/montecarlo/normalequationsregression.hpp>
+#include <ql/math/matrixutilities/svd.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        // number of samples accumulated together; it must not depend
+        // on the number of threads, or results would not be
+        // reproducible.
+        const Size blockSize = 256;
+
+    }
+
+    NormalEquationsRegression::NormalEquationsRegression(Size threads)
+    : threads_(threads) {
+        QL_REQUIRE(threads_ > 0, "at least one thread required");
+    }
+
+    void NormalEquationsRegression::resize(Size samples, Size basisSize) {
+        QL_REQUIRE(basisSize > 0, "no basis functions given");
+        samples_ = samples;
+        basisSize_ = basisSize;
+        if (design_.size() < samples*basisSize)
+            design_.resize(samples*basisSize);
+        if (targets_.size() < samples)
+            targets_.resize(samples);
+        if (gram_.rows() != basisSize) {
+            gram_ = Matrix(basisSize, basisSize);
+            rhs_ = scaling_ = coefficients_ = Array(basisSize);
+        }
+    }
+
+    const Array& NormalEquationsRegression::solve() {
+        const Size n = basisSize_;
+        QL_REQUIRE(n > 0, "regression size not set");
+
+        // lower triangle of X^T X followed by X^T y, for each block
+        const Size stride = n*n + n;
+        const Size blocks = (samples_ + blockSize - 1) / blockSize;
+        if (partialSums_.size() < blocks*stride)
+            partialSums_.resize(blocks*stride);
+
+        const Real* x = design_.data();
+        const Real* y = targets_.data();
+        Real* partial = partialSums_.data();
+        const Size samples = samples_;
+
+        #pragma omp parallel for if(threads_ > 1) num_threads(threads_)
+        for (long b=0; b<(long)blocks; ++b) {
+            Real* g = partial + b*stride;
+            Real* r = g + n*n;
+            std::fill(g, g+stride, 0.0);
+            const Size end = std::min<Size>((b+1)*blockSize, samples);
+            for (Size j=b*blockSize; j<end; ++j) {
+                const Real* row = x + j*n;
+                for (Size k=0; k<n; ++k) {
+                    const Real xk = row[k];
+                    for (Size l=0; l<=k; ++l)
+                        g[k*n+l] += xk*row[l];
+                    r[k] += xk*y[j];
+                }
+            }
+        }
+
+        std::fill(gram_.begin(), gram_.end(), 0.0);
+        std::fill(rhs_.begin(), rhs_.end(), 0.0);
+        for (Size b=0; b<blocks; ++b) {
+            const Real* g = partial + b*stride;
+            for (Size k=0; k<n; ++k) {
+                for (Size l=0; l<=k; ++l)
+                    gram_[k][l] += g[k*n+l];
+                rhs_[k] += g[n*n+k];
+            }
+        }
+
+        // scale to unit diagonal to reduce the condition number
+        for (Size k=0; k<n; ++k)
+            scaling_[k] = gram_[k][k] > 0.0 ? 1.0/std::sqrt(gram_[k][k])
+                                            : 1.0;
+        for (Size k=0; k<n; ++k) {
+            rhs_[k] *= scaling_[k];
+            for (Size l=0; l<=k; ++l)
+                gram_[l][k] = gram_[k][l] *= scaling_[k]*scaling_[l];
+        }
+
+        coefficients_ = SVD(gram_).solveFor(rhs_);
+        for (Size k=0; k<n; ++k)
+            coefficients_[k] *= scaling_[k];
+        return coefficients_;
+    }
+
+}
@@ -0,0 +1,77 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file normalequationsregression.hpp
+    \brief least-squares regression through the normal equations
+*/
+
+#ifndef quantlib_normal_equations_regression_hpp
+#define quantlib_normal_equations_regression_hpp
+
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! least-squares regression through the normal equations
+    /*! This class is meant for the repeated regressions performed
+        by Longstaff-Schwartz algorithms, with many samples and few
+        basis functions.  The caller fills the design matrix (one
+        row of basis-function values per sample) and the targets in
+        buffers owned by the class; the products \f$ X^T X \f$ and
+        \f$ X^T y \f$ are then accumulated over fixed blocks of
+        samples, distributed over the given number of threads if the
+        library is compiled with OpenMP, and the resulting small
+        system is solved by SVD after diagonal scaling so that
+        rank-deficient bases (including the case of fewer samples
+        than basis functions) are handled as a pseudo-inverse.
+
+        Since the blocks don't depend on the number of threads,
+        results are reproducible.  The buffers are only reallocated
+        when a regression needs more room than any previous one.
+
+        \ingroup mcarlo
+    */
+    class NormalEquationsRegression {
+      public:
+        explicit NormalEquationsRegression(Size threads = 1);
+        //! sets the size of the next regression
+        void resize(Size samples, Size basisSize);
+        //! \name buffers
+        //@{
+        //! basis-function values, <tt>design()[j*basisSize+l]</tt>
+        Real* design() { return design_.data(); }
+        //! regression targets, one per sample
+        Real* targets() { return targets_.data(); }
+        //@}
+        //! performs the regression on the current buffers
+        const Array& solve();
+        const Array& coefficients() const { return coefficients_; }
+        Size samples() const { return samples_; }
+        Size basisSize() const { return basisSize_; }
+      private:
+        Size threads_;
+        Size samples_ = 0, basisSize_ = 0;
+        std::vector<Real> design_, targets_, partialSums_;
+        Matrix gram_;
+        Array rhs_, scaling_, coefficients_;
+    };
+
+}
+
+
+#endif
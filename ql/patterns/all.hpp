@@ -1,10 +1,13 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/patterns/calculationgraph.hpp>
 #include <ql/patterns/composite.hpp>
 #include <ql/patterns/curiouslyrecurring.hpp>
+#include <ql/patterns/dependencygraph.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/patterns/observable.hpp>
+#include <ql/patterns/observergraph.hpp>
 #include <ql/patterns/singleton.hpp>
 #include <ql/patterns/visitor.hpp>
 
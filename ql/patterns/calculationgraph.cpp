@@ -0,0 +1,195 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/patterns/calculationgraph.hpp>
+#include <ql/patterns/dependencygraph.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
+namespace QuantLib {
+
+    void CalculationGraph::observablesOf(Observer* o,
+                                         std::vector<Observable*>& result) {
+        result.clear();
+        for (const auto& observable : o->observables())
+            result.push_back(observable.get());
+    }
+
+    void CalculationGraph::build(const std::vector<LazyObject*>& targets) {
+
+        std::vector<LazyObject*> nodes;
+        boost::unordered_map<LazyObject*, Size> index;
+        auto node = [&](LazyObject* o) {
+            auto inserted = index.insert(std::make_pair(o, nodes.size()));
+            if (inserted.second)
+                nodes.push_back(o);
+            return inserted.first->second;
+        };
+        for (auto* target : targets)
+            node(target);
+
+        // upward visit of the registrations; dependents[i] lists the
+        // objects depending on object i
+        std::vector<std::vector<Size> > dependents;
+        detail::DisjointSets groups;
+        boost::unordered_map<Observer*, Size> firstUser;
+        std::vector<Observable*> found, stack;
+        boost::unordered_set<Observable*> visited;
+        for (Size i=0; i<nodes.size(); ++i) {
+            observablesOf(nodes[i], stack);
+            const Size direct = stack.size();
+            visited.clear();
+            visited.insert(stack.begin(), stack.end());
+            groups.add();
+            for (Size k=0; k<stack.size(); ++k) {
+                Observable* observable = stack[k];
+                auto* lazy = dynamic_cast<LazyObject*>(observable);
+                if (lazy != nullptr) {
+                    if (lazy != nodes[i]) {
+                        Size j = node(lazy);
+                        if (dependents.size() <= j)
+                            dependents.resize(j+1);
+                        dependents[j].push_back(i);
+                    }
+                    continue;
+                }
+                auto* observer = dynamic_cast<Observer*>(observable);
+                if (observer == nullptr)
+                    continue;
+                if (k < direct || detail::isCouponPricer(observer)) {
+                    // objects using the same observer directly, or the
+                    // same coupon pricer through their coupons, are
+                    // grouped
+                    auto user = firstUser.insert(std::make_pair(observer, i));
+                    if (!user.second)
+                        groups.merge(i, user.first->second);
+                }
+                observablesOf(observer, found);
+                for (auto* o : found)
+                    if (visited.insert(o).second)
+                        stack.push_back(o);
+            }
+        }
+        const Size n = nodes.size();
+        dependents.resize(n);
+
+        std::vector<Size> order;
+        bool acyclic = detail::sortTopologically(dependents, order);
+
+        if (acyclic) {
+            // one task per group of objects
+            std::vector<Size> taskOf(n, Null<Size>());
+            boost::unordered_map<Size, Size> taskOfRoot;
+            for (Size i : order) {
+                auto inserted = taskOfRoot.insert(
+                    std::make_pair(groups.find(i), tasks_.size()));
+                if (inserted.second)
+                    tasks_.emplace_back();
+                taskOf[i] = inserted.first->second;
+                tasks_[taskOf[i]].push_back(nodes[i]);
+            }
+            successors_.resize(tasks_.size());
+            std::vector<boost::unordered_set<Size> > edges(tasks_.size());
+            for (Size i=0; i<n; ++i)
+                for (Size j : dependents[i])
+                    if (taskOf[i] != taskOf[j]
+                        && edges[taskOf[i]].insert(taskOf[j]).second)
+                        successors_[taskOf[i]].push_back(taskOf[j]);
+            std::vector<Size> taskOrder;
+            acyclic = detail::sortTopologically(successors_, taskOrder);
+        }
+
+        if (acyclic) {
+            objects_.reserve(n);
+            for (Size i : order)
+                objects_.push_back(nodes[i]);
+            dependencies_.assign(tasks_.size(), 0);
+            for (const auto& next : successors_)
+                for (Size t : next)
+                    ++dependencies_[t];
+        } else {
+            // objects in cycles, and those depending on them, are
+            // calculated last in the order they were found
+            boost::unordered_set<Size> sorted(order.begin(), order.end());
+            for (Size i=0; i<n; ++i)
+                if (sorted.count(i) == 0)
+                    order.push_back(i);
+            objects_.clear();
+            for (Size i : order)
+                objects_.push_back(nodes[i]);
+            tasks_.assign(n > 0 ? 1 : 0, objects_);
+            successors_.assign(tasks_.size(), std::vector<Size>());
+            dependencies_.assign(tasks_.size(), 0);
+        }
+    }
+
+    void CalculationGraph::run(Size task, State* state) const {
+        const SharedSettings::Scope scope(state->settings);
+        for (auto* object : tasks_[task]) {
+            try {
+                object->ensureCalculated();
+            } catch (std::exception& e) {
+                state->failed[task] = 1;
+                state->errors[task] = e.what();
+            } catch (...) {
+                state->failed[task] = 1;
+            }
+        }
+        for (Size next : successors_[task]) {
+            if (--state->pending[next] == 0) {
+                #pragma omp task firstprivate(next, state)
+                run(next, state);
+            }
+        }
+    }
+
+    void CalculationGraph::calculate(Size threads) const {
+        QL_REQUIRE(threads > 0, "at least one thread required");
+        const Size n = tasks_.size();
+        State state(n);
+        for (Size t=0; t<n; ++t)
+            state.pending[t] = dependencies_[t];
+
+        State* s = &state;
+        #pragma omp parallel if(threads > 1) num_threads(threads) firstprivate(s)
+        {
+            #pragma omp single
+            {
+                for (Size t=0; t<n; ++t) {
+                    if (dependencies_[t] == 0) {
+                        #pragma omp task firstprivate(t, s)
+                        run(t, s);
+                    }
+                }
+            }
+        }
+
+        bool successful = true;
+        std::string errMsg;
+        for (Size t=0; t<n; ++t) {
+            if (state.failed[t] != 0) {
+                successful = false;
+                if (!state.errors[t].empty())
+                    errMsg = state.errors[t];
+            }
+        }
+        QL_ENSURE(successful,
+                  "could not calculate one or more objects: " << errMsg);
+    }
+
+}
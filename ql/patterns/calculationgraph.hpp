@@ -0,0 +1,122 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file calculationgraph.hpp
+    \brief parallel calculation of lazy objects and their dependencies
+*/
+
+#ifndef quantlib_calculation_graph_hpp
+#define quantlib_calculation_graph_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/threadlocalsettings.hpp>
+#include <boost/atomic.hpp>
+#include <boost/scoped_array.hpp>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Lazy objects and the lazy objects they depend upon
+    /*! The graph is built once from the given lazy objects (e.g.,
+        instruments) by following their registrations upwards, i.e.,
+        towards the observables they depend upon; any lazy object
+        found (e.g., term structures or volatility surfaces) is added
+        to the graph, while other observers (e.g., handles, indexes
+        or pricing engines) are passed through.
+
+        calculate() then calculates each object in the graph exactly
+        once, after the objects it depends upon.  If more than one
+        thread is given and the library is compiled with OpenMP,
+        independent objects are calculated concurrently as OpenMP
+        tasks, each object being scheduled as soon as its last
+        dependency is calculated; otherwise, they are calculated in
+        sequence.
+
+        Lazy objects registered directly with the same non-lazy
+        observer (typically, instruments sharing a pricing engine),
+        or using the same coupon pricer through their coupons, are
+        calculated in sequence by the same task, since engines and
+        pricers are not safe to use from several threads at once.
+        If this creates a cycle, or if the registrations contain
+        one, the whole graph is calculated in sequence.
+
+        \warning Objects are only protected against concurrent use
+                 as described above; other non-lazy observers shared
+                 through intermediate ones (e.g., indexes or
+                 handles) are assumed not to hold mutable state.
+
+        \warning The graph holds raw pointers; it is a snapshot of
+                 the registrations at construction and must not
+                 outlive the objects, nor be used after they
+                 register or unregister.
+
+        \ingroup patterns
+    */
+    class CalculationGraph {
+      public:
+        template <class Iterator>
+        CalculationGraph(Iterator begin, Iterator end) {
+            std::vector<LazyObject*> targets;
+            for (Iterator i=begin; i!=end; ++i) {
+                QL_REQUIRE(*i, "null lazy object given");
+                targets.push_back(&**i);
+            }
+            build(targets);
+        }
+        explicit CalculationGraph(
+                  const std::vector<ext::shared_ptr<LazyObject> >& targets)
+        : CalculationGraph(targets.begin(), targets.end()) {}
+        //! \name Inspectors
+        //@{
+        Size size() const { return objects_.size(); }
+        //! lazy objects in topological order
+        const std::vector<LazyObject*>& objects() const { return objects_; }
+        //! number of sets of objects calculated in sequence
+        Size tasks() const { return tasks_.size(); }
+        //@}
+        /*! Calculates the objects in the graph; objects that are
+            already calculated or frozen are not recalculated.  If
+            any calculation fails, the others are performed anyway
+            and an exception is raised at the end.
+        */
+        void calculate(Size threads = 1) const;
+      private:
+        struct State {
+            explicit State(Size n)
+            : pending(new boost::atomic<Size>[n]), errors(n), failed(n, 0) {}
+            boost::scoped_array<boost::atomic<Size> > pending;
+            std::vector<std::string> errors;
+            std::vector<char> failed;
+            // settings of the calling thread, seen by all tasks
+            SharedSettings settings;
+        };
+        static void observablesOf(Observer*, std::vector<Observable*>&);
+        void build(const std::vector<LazyObject*>& targets);
+        void run(Size task, State* state) const;
+        std::vector<LazyObject*> objects_;
+        // objects calculated by each task, in topological order
+        std::vector<std::vector<LazyObject*> > tasks_;
+        // tasks to be notified when each task is completed
+        std::vector<std::vector<Size> > successors_;
+        std::vector<Size> dependencies_;
+    };
+
+}
+
+
+#endif
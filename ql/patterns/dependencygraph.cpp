@@ -0,0 +1,85 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/patterns/dependencygraph.hpp>
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/inflationcouponpricer.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        DisjointSets::DisjointSets(Size n) : parent_(n) {
+            for (Size i=0; i<n; ++i)
+                parent_[i] = i;
+        }
+
+        Size DisjointSets::add() {
+            parent_.push_back(parent_.size());
+            return parent_.size()-1;
+        }
+
+        Size DisjointSets::find(Size i) {
+            while (parent_[i] != i) {
+                parent_[i] = parent_[parent_[i]];
+                i = parent_[i];
+            }
+            return i;
+        }
+
+        void DisjointSets::merge(Size i, Size j) {
+            parent_[find(i)] = find(j);
+        }
+
+        bool sortTopologically(const std::vector<std::vector<Size> >& next,
+                               std::vector<Size>& order,
+                               std::vector<Size>* levels) {
+            const Size n = next.size();
+            std::vector<Size> inDegree(n, 0);
+            for (const auto& edges : next)
+                for (Size j : edges)
+                    ++inDegree[j];
+            if (levels != nullptr)
+                levels->assign(n, 0);
+            order.clear();
+            for (Size i=0; i<n; ++i)
+                if (inDegree[i] == 0)
+                    order.push_back(i);
+            for (Size k=0; k<order.size(); ++k) {
+                const Size i = order[k];
+                for (Size j : next[i]) {
+                    if (levels != nullptr)
+                        (*levels)[j] = std::max((*levels)[j], (*levels)[i]+1);
+                    if (--inDegree[j] == 0)
+                        order.push_back(j);
+                }
+            }
+            return order.size() == n;
+        }
+
+        bool isCouponPricer(const Observer* observer) {
+            return dynamic_cast<const FloatingRateCouponPricer*>(observer)
+                       != nullptr
+                || dynamic_cast<const InflationCouponPricer*>(observer)
+                       != nullptr;
+        }
+
+    }
+
+}
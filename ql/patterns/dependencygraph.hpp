@@ -0,0 +1,74 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file dependencygraph.hpp
+    \brief algorithms on dependency graphs of observers
+*/
+
+#ifndef quantlib_dependency_graph_hpp
+#define quantlib_dependency_graph_hpp
+
+#include <ql/types.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class Observer;
+
+    namespace detail {
+
+        //! partition of a set of indices into disjoint subsets
+        class DisjointSets {
+          public:
+            explicit DisjointSets(Size n = 0);
+            //! adds a new subset with a single index, and returns it
+            Size add();
+            //! representative index of the subset containing i
+            Size find(Size i);
+            //! joins the subsets containing i and j
+            void merge(Size i, Size j);
+          private:
+            std::vector<Size> parent_;
+        };
+
+        //! topological sort of a directed graph (Kahn's algorithm)
+        /*! next[i] lists the nodes reached from node i.  On return,
+            order holds each node after all the nodes leading to it,
+            except for the nodes taking part in a cycle or reached
+            from one, which are left out; the return value tells
+            whether all nodes were sorted.  If levels is given, it
+            holds for each sorted node the length of the longest
+            path leading to it.
+        */
+        bool sortTopologically(const std::vector<std::vector<Size> >& next,
+                               std::vector<Size>& order,
+                               std::vector<Size>* levels = nullptr);
+
+        //! whether the observer is a coupon pricer
+        /*! Coupon pricers store data about the coupon being priced,
+            so that lazy objects using the same pricer, even through
+            their coupons, must not be calculated concurrently.
+        */
+        bool isCouponPricer(const Observer* observer);
+
+    }
+
+}
+
+
+#endif
@@ -33,6 +33,7 @@ namespace QuantLib {
     class LazyObject : public virtual Observable,
                        public virtual Observer {
       public:
+        class FreezeGuard;
         LazyObject() = default;
         ~LazyObject() override = default;
         //! \name Observer interface
@@ -83,7 +84,22 @@ namespace QuantLib {
                      behavior.
         */
         void alwaysForwardNotifications();
+        /*! This method performs the calculations, if needed, as the
+            first access to the results would; it allows schedulers
+            (e.g., CalculationGraph) to calculate objects in advance.
+        */
+        void ensureCalculated() const;
+        //@}
+        //! \name Inspectors
+        //@{
+        //! whether the cached results are up to date
+        bool isCalculated() const;
+        //! whether the object is frozen
+        bool isFrozen() const;
+        //@}
       protected:
+        //! \name Calculations
+        //@{
         /*! This method performs all needed calculations by calling
             the <i><b>performCalculations</b></i> method.
 
@@ -109,6 +125,31 @@ namespace QuantLib {
         mutable bool calculated_ = false, frozen_ = false, alwaysForward_ = false;
     };
 
+    //! Keeps a lazy object frozen while it's calculated with others
+    /*! While in scope, the object ignores the notifications sent by
+        the objects it's calculated together with (e.g., mutually
+        dependent curves), but it can still be recalculated by means
+        of the recalculate() method of the guard.  On exit, the object
+        is unfrozen without notifying its observers; it is considered
+        calculated if complete() was called, and the notifications
+        received meanwhile are discarded.  Objects that were frozen
+        already are left untouched.
+    */
+    class LazyObject::FreezeGuard {
+      public:
+        explicit FreezeGuard(const LazyObject& object);
+        FreezeGuard(const FreezeGuard&) = delete;
+        FreezeGuard& operator=(const FreezeGuard&) = delete;
+        ~FreezeGuard();
+        //! recalculates the object, unless it was frozen already
+        void recalculate();
+        //! marks the object as calculated on exit
+        void complete() { completed_ = true; }
+      private:
+        const LazyObject& object_;
+        bool wasFrozen_, completed_ = false;
+    };
+
 
     // inline definitions
 
@@ -159,6 +200,18 @@ namespace QuantLib {
         alwaysForward_ = true;
     }
 
+    inline void LazyObject::ensureCalculated() const {
+        calculate();
+    }
+
+    inline bool LazyObject::isCalculated() const {
+        return calculated_;
+    }
+
+    inline bool LazyObject::isFrozen() const {
+        return frozen_;
+    }
+
     inline void LazyObject::calculate() const {
         if (!calculated_ && !frozen_) {
             calculated_ = true;   // prevent infinite recursion in
@@ -172,6 +225,26 @@ namespace QuantLib {
         }
     }
 
+    inline LazyObject::FreezeGuard::FreezeGuard(const LazyObject& object)
+    : object_(object), wasFrozen_(object.frozen_) {
+        object_.frozen_ = true;
+    }
+
+    inline LazyObject::FreezeGuard::~FreezeGuard() {
+        if (!wasFrozen_) {
+            object_.frozen_ = false;
+            object_.calculated_ = completed_;
+        }
+    }
+
+    inline void LazyObject::FreezeGuard::recalculate() {
+        if (!wasFrozen_) {
+            object_.frozen_ = object_.calculated_ = false;
+            object_.calculate();
+            object_.frozen_ = true;
+        }
+    }
+
 }
 
 #endif
@@ -87,77 +87,45 @@ namespace QuantLib {
 
 #else
 
-#include <boost/signals2/signal_type.hpp>
-
 namespace QuantLib {
 
-    namespace detail {
-
-        class Signal {
-          public:
-            typedef boost::signals2::signal_type<
-                void(),
-                boost::signals2::keywords::mutex_type<boost::recursive_mutex> >
-                ::type signal_type;
-
-            void connect(const signal_type::slot_type& slot) {
-                sig_.connect(slot);
-            }
-
-            template <class T>
-            void disconnect(const T& slot) {
-                sig_.disconnect(slot);
-            }
-
-            void operator()() const {
-                sig_();
-            }
-          private:
-            signal_type sig_;
-        };
-
-        template <class T>
-        class ProxyUpdater {
-            T* proxy_;
-          public:
-            explicit ProxyUpdater(const ext::shared_ptr<T>& observerProxy)
-            : proxy_(observerProxy.get()) {}
-
-            void operator()() const {
-                proxy_->update();
-            }
-
-            bool operator==(const ProxyUpdater<T>& other) const {
-                return proxy_ == other.proxy_;
-            }
+    ext::shared_ptr<Observable::set_type> Observable::observers() const {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        return observers_;
+    }
 
-            bool operator!=(const ProxyUpdater<T>& other) const {
-                return proxy_ != other.proxy_;
+    void Observable::changeObservers(
+                          const ext::shared_ptr<Observer::Proxy>& proxy,
+                          bool add) {
+        boost::unique_lock<boost::mutex> lock(mutex_);
+        while ((observers_->count(proxy) == 0) == add) {
+            // the set is never modified in place, since notifications
+            // might be iterating over it; modify a copy made without
+            // holding the lock and swap it in, unless the set changed
+            // in the meantime.
+            const ext::shared_ptr<set_type> current = observers_;
+            lock.unlock();
+            const ext::shared_ptr<set_type> modified =
+                ext::make_shared<set_type>(*current);
+            if (add)
+                modified->insert(proxy);
+            else
+                modified->erase(proxy);
+            lock.lock();
+            if (observers_ == current) {
+                observers_ = modified;
+                return;
             }
-        };
-
+        }
     }
 
     void Observable::registerObserver(const ext::shared_ptr<Observer::Proxy>& observerProxy) {
-        {
-            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-            observers_.insert(observerProxy);
-        }
-
-        detail::Signal::signal_type::slot_type slot {detail::ProxyUpdater<Observer::Proxy>(observerProxy)};
-        #if defined(QL_USE_STD_SHARED_PTR)
-        sig_->connect(slot.track_foreign(observerProxy));
-        #else
-        sig_->connect(slot.track(observerProxy));
-        #endif
+        changeObservers(observerProxy, true);
     }
 
     void Observable::unregisterObserver(const ext::shared_ptr<Observer::Proxy>& observerProxy,
-                                        bool disconnect) {
-        {
-            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-            observers_.erase(observerProxy);
-        }
+                                        bool) {
+        changeObservers(observerProxy, false);
 
         if (settings_.updatesDeferred()) {
             boost::lock_guard<boost::mutex> sLock(settings_.mutex_);
@@ -165,35 +133,47 @@ namespace QuantLib {
                 settings_.unregisterDeferredObserver(observerProxy);
             }
         }
-
-        if (disconnect) {
-            sig_->disconnect(detail::ProxyUpdater<Observer::Proxy>(observerProxy));
-        }
     }
 
     void Observable::notifyObservers() {
-        if (settings_.updatesEnabled()) {
-            return (*sig_)();
+        if (!settings_.updatesEnabled()) {
+            boost::lock_guard<boost::mutex> sLock(settings_.mutex_);
+            if (!settings_.updatesEnabled()) {
+                // if updates are only deferred, flag this for later
+                // notification; these are held centrally by the
+                // settings singleton
+                if (settings_.updatesDeferred())
+                    settings_.registerDeferredObservers(*observers());
+                return;
+            }
         }
 
-        boost::lock_guard<boost::mutex> sLock(settings_.mutex_);
-        if (settings_.updatesEnabled()) {
-            return (*sig_)();
-        }
-        else if (settings_.updatesDeferred()) {
-            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-            // if updates are only deferred, flag this for later notification
-            // these are held centrally by the settings singleton
-            settings_.registerDeferredObservers(observers_);
+        const ext::shared_ptr<set_type> observers = this->observers();
+        bool successful = true;
+        std::string errMsg;
+        for (const auto& observer : *observers) {
+            try {
+                observer->update();
+            } catch (std::exception& e) {
+                // as in the single-threaded implementation, try and
+                // notify all observers and raise an exception
+                // afterwards if something bad happened.
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
         }
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
     }
 
     Observable::Observable()
-    : sig_(new detail::Signal()),
+    : observers_(ext::make_shared<set_type>()),
       settings_(ObservableSettings::instance()) { }
 
     Observable::Observable(const Observable&)
-    : sig_(new detail::Signal()),
+    : observers_(ext::make_shared<set_type>()),
       settings_(ObservableSettings::instance()) {
         // the observer set is not copied; no observer asked to
         // register with this object
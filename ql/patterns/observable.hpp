@@ -43,6 +43,7 @@ namespace QuantLib {
 
     class Observer;
     class Observable;
+    class ObserverGraph;
 
     //! global repository for run-time library settings
     class ObservableSettings : public Singleton<ObservableSettings> {
@@ -78,6 +79,7 @@ namespace QuantLib {
     /*! \ingroup patterns */
     class Observable {
         friend class Observer;
+        friend class ObserverGraph;
       public:
         // constructors, assignment, destructor
         Observable() : settings_(ObservableSettings::instance()) {}
@@ -119,6 +121,8 @@ namespace QuantLib {
         void registerWithObservables(const ext::shared_ptr<Observer>&);
         Size unregisterWith(const ext::shared_ptr<Observable>&);
         void unregisterWithAll();
+        //! returns the observables this instance is registered with
+        const set_type& observables() const { return observables_; }
 
         /*! This method must be implemented in derived classes. An
             instance of %Observer does not call this method directly:
@@ -258,12 +262,14 @@ namespace QuantLib {
 namespace QuantLib {
     class Observable;
     class ObservableSettings;
+    class ObserverGraph;
 
     //! Object that gets notified when a given observable changes
     /*! \ingroup patterns */
     class Observer : public ext::enable_shared_from_this<Observer> {
         friend class Observable;
         friend class ObservableSettings;
+        friend class ObserverGraph;
       public:
         typedef boost::unordered_set<ext::shared_ptr<Observable> > set_type;
         typedef set_type::iterator iterator;
@@ -282,6 +288,11 @@ namespace QuantLib {
         void registerWithObservables(const ext::shared_ptr<Observer>&);
         Size unregisterWith(const ext::shared_ptr<Observable>&);
         void unregisterWithAll();
+        //! returns the observables this instance is registered with
+        set_type observables() const {
+            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+            return observables_;
+        }
 
         /*! This method must be implemented in derived classes. An
             instance of %Observer does not call this method directly:
@@ -298,7 +309,13 @@ namespace QuantLib {
 
       private:
 
+        /* The proxy is locked during updates, so that each observer
+           is notified by one thread at a time and observers such as
+           LazyObject don't need to synchronize their own state.
+           Updates of different observers can still run concurrently.
+        */
         class Proxy {
+            friend class QuantLib::ObserverGraph;
           public:
             explicit Proxy(Observer* const observer)
              : active_  (true),
@@ -307,6 +324,16 @@ namespace QuantLib {
 
             void update() const {
                 boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+                doUpdate();
+            }
+
+            void deactivate() {
+                boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+                active_ = false;
+            }
+
+        private:
+            void doUpdate() const {
                 if (active_) {
                     // c++17 is required if used with std::shared_ptr<T>
                     const ext::weak_ptr<Observer> o
@@ -326,12 +353,6 @@ namespace QuantLib {
                 }
             }
 
-            void deactivate() {
-                boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-                active_ = false;
-            }
-
-        private:
             bool active_;
             mutable boost::recursive_mutex mutex_;
             Observer* const observer_;
@@ -343,14 +364,21 @@ namespace QuantLib {
         set_type observables_;
     };
 
-	namespace detail {
-		class Signal;
-	}
-
     //! Object that notifies its changes to a set of observers
-    /*! \ingroup patterns */
+    /*! The set of observers is copied on write: notifications take
+        a reference to the current set under a mutex held for the
+        duration of a pointer copy, and then notify observers
+        without holding it.  Registration never modifies the set in
+        place; it works on a copy made outside the lock and swaps it
+        in.  Concurrent notifications thus don't serialize on the
+        observable; each observer is still notified by one thread at
+        a time.
+
+        \ingroup patterns
+    */
     class Observable {
         friend class Observer;
+        friend class ObserverGraph;
       public:
         typedef boost::unordered_set<ext::shared_ptr<Observer::Proxy> >
             set_type;
@@ -369,11 +397,14 @@ namespace QuantLib {
         void registerObserver(const ext::shared_ptr<Observer::Proxy>&);
         void unregisterObserver(
             const ext::shared_ptr<Observer::Proxy>& proxy, bool disconnect);
+        ext::shared_ptr<set_type> observers() const;
+        /* adds or removes the proxy; the set is copied outside the
+           lock if a notification is holding it */
+        void changeObservers(const ext::shared_ptr<Observer::Proxy>& proxy,
+                             bool add);
 
-        ext::shared_ptr<detail::Signal> sig_;
-
-        set_type observers_;
-        mutable boost::recursive_mutex mutex_;
+        ext::shared_ptr<set_type> observers_;
+        mutable boost::mutex mutex_;
 
         ObservableSettings& settings_;
     };
@@ -0,0 +1,312 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/patterns/observergraph.hpp>
+#include <ql/patterns/dependencygraph.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/threadlocalsettings.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/unordered_map.hpp>
+#include <algorithm>
+#include <string>
+
+namespace QuantLib {
+
+    void ObserverGraph::observersOf(Observable* o,
+                                    std::vector<Node>& result) {
+        result.clear();
+        #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+        for (auto* observer : o->observers_)
+            result.push_back({observer});
+        #else
+        const ext::shared_ptr<Observable::set_type> proxies =
+            o->observers();
+        for (const auto& proxy : *proxies) {
+            // an active proxy can't be deactivated, i.e., its observer
+            // destroyed, while it is locked
+            boost::lock_guard<boost::recursive_mutex> lock(proxy->mutex_);
+            if (!proxy->active_)
+                continue;
+            const ext::weak_ptr<Observer> observer =
+                proxy->observer_->weak_from_this();
+            const ext::weak_ptr<Observer> empty;
+            if (observer.owner_before(empty)
+                || empty.owner_before(observer)) {
+                // shared ownership; it might be expiring already
+                ext::shared_ptr<Observer> owner = observer.lock();
+                if (owner)
+                    result.push_back({proxy->observer_, proxy, owner});
+            } else {
+                result.push_back({proxy->observer_, proxy,
+                                  ext::shared_ptr<Observer>()});
+            }
+        }
+        #endif
+    }
+
+    ObserverGraph::ObserverGraph(
+                  const std::vector<ext::shared_ptr<Observable> >& sources)
+    : sources_(sources) {
+
+        // breadth-first visit of the registrations
+        std::vector<Node> nodes;
+        std::vector<std::vector<Size> > children;
+        boost::unordered_map<Observer*, Size> index;
+        std::vector<Observable*> foundThrough;
+
+        std::vector<Node> found;
+        auto visit = [&](Observable* o, Size from) {
+            observersOf(o, found);
+            for (const auto& node : found) {
+                auto inserted = index.insert(
+                    std::make_pair(node.observer, nodes.size()));
+                if (inserted.second) {
+                    nodes.push_back(node);
+                    foundThrough.push_back(o);
+                    children.emplace_back();
+                }
+                if (from != Null<Size>())
+                    children[from].push_back(inserted.first->second);
+            }
+        };
+
+        for (const auto& source : sources_) {
+            QL_REQUIRE(source, "null observable given");
+            visit(source.get(), Null<Size>());
+        }
+        for (Size i=0; i<nodes.size(); ++i) {
+            auto* lazy = dynamic_cast<LazyObject*>(nodes[i].observer);
+            if (lazy != nullptr && lazy->isFrozen())
+                continue;
+            auto* observable = dynamic_cast<Observable*>(nodes[i].observer);
+            if (observable != nullptr)
+                visit(observable, i);
+        }
+
+        // levels, as the longest path from the sources
+        const Size n = nodes.size();
+        std::vector<Size> level, sorted;
+        const bool acyclic = detail::sortTopologically(children, sorted,
+                                                       &level);
+        Size nLevels = n > 0 ? 1 : 0;
+        for (Size i : sorted)
+            nLevels = std::max(nLevels, level[i]+1);
+        Size cycleLevel = Null<Size>();
+        if (!acyclic) {
+            // cycles (and whatever depends on them) go last
+            std::vector<char> inOrder(n, 0);
+            for (Size i : sorted)
+                inOrder[i] = 1;
+            cycleLevel = nLevels++;
+            for (Size i=0; i<n; ++i)
+                if (inOrder[i] == 0)
+                    level[i] = cycleLevel;
+        }
+
+        std::vector<Size> order(n);
+        for (Size i=0; i<n; ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(),
+                         [&level](Size i, Size j) {
+                             return level[i] < level[j];
+                         });
+
+        observers_.resize(n);
+        #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+        proxies_.resize(n);
+        #endif
+        std::vector<Size> position(n);
+        levelStart_.assign(nLevels+1, n);
+        for (Size k=n; k>0; --k) {
+            observers_[k-1] = nodes[order[k-1]].observer;
+            #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+            proxies_[k-1] = nodes[order[k-1]].proxy;
+            #endif
+            position[order[k-1]] = k-1;
+            levelStart_[level[order[k-1]]] = k-1;
+        }
+        registrations_.resize(n);
+        for (Size i=0; i<n; ++i)
+            registrations_[i] = std::make_pair(foundThrough[i], position[i]);
+
+        // lazy objects in the same level sharing a non-lazy observer
+        // (e.g., a pricing engine) are grouped together; so are those
+        // using a coupon pricer through their coupons
+        std::vector<LazyObject*> lazy(n);
+        detail::DisjointSets sets(n);
+        for (Size i=0; i<n; ++i)
+            lazy[i] = dynamic_cast<LazyObject*>(nodes[i].observer);
+        std::vector<Size> users, stack;
+        std::vector<char> reached(n, 0);
+        for (Size i=0; i<n; ++i) {
+            if (lazy[i] != nullptr)
+                continue;
+            users.clear();
+            if (detail::isCouponPricer(nodes[i].observer)) {
+                stack.assign(1, i);
+                while (!stack.empty()) {
+                    Size k = stack.back();
+                    stack.pop_back();
+                    for (Size j : children[k]) {
+                        if (reached[j] != 0)
+                            continue;
+                        reached[j] = 1;
+                        if (lazy[j] != nullptr)
+                            users.push_back(j);
+                        else
+                            stack.push_back(j);
+                    }
+                }
+                std::fill(reached.begin(), reached.end(), 0);
+            } else {
+                for (Size j : children[i])
+                    if (lazy[j] != nullptr)
+                        users.push_back(j);
+            }
+            boost::unordered_map<Size, Size> firstInLevel;
+            for (Size j : users) {
+                auto inserted = firstInLevel.insert(std::make_pair(level[j], j));
+                if (!inserted.second)
+                    sets.merge(j, inserted.first->second);
+            }
+        }
+
+        groups_.resize(nLevels);
+        boost::unordered_map<Size, Size> groupOf;
+        for (Size k=0; k<n; ++k) {
+            Size i = order[k];
+            if (lazy[i] == nullptr)
+                continue;
+            std::vector<std::vector<LazyObject*> >& groups = groups_[level[i]];
+            // objects in cycles are calculated in sequence
+            Size root = level[i] == cycleLevel ? n : sets.find(i);
+            auto inserted = groupOf.insert(std::make_pair(root, groups.size()));
+            if (inserted.second)
+                groups.emplace_back();
+            groups[inserted.first->second].push_back(lazy[i]);
+        }
+    }
+
+    void ObserverGraph::lock(
+                     std::vector<ext::shared_ptr<Observer> >& owners) const {
+        owners.clear();
+        // observers are checked in the order in which they were
+        // found, so that the observable through which each was found
+        // is known to be alive
+        for (const auto& r : registrations_) {
+            #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+            const bool registered =
+                r.first->observers_.count(observers_[r.second]) != 0;
+            #else
+            const ext::shared_ptr<Observer::Proxy>& proxy =
+                proxies_[r.second];
+            bool registered = r.first->observers()->count(proxy) != 0;
+            if (registered) {
+                boost::lock_guard<boost::recursive_mutex> lock(proxy->mutex_);
+                registered = proxy->active_;
+                if (registered) {
+                    const ext::weak_ptr<Observer> o =
+                        proxy->observer_->weak_from_this();
+                    const ext::weak_ptr<Observer> empty;
+                    if (o.owner_before(empty) || empty.owner_before(o)) {
+                        owners.push_back(o.lock());
+                        registered = bool(owners.back());
+                    }
+                }
+            }
+            #endif
+            QL_REQUIRE(registered,
+                       "observer graph out of date: an observer was "
+                       "destroyed or unregistered");
+        }
+    }
+
+    void ObserverGraph::update() const {
+        std::vector<ext::shared_ptr<Observer> > owners;
+        lock(owners);
+
+        ObservableSettings& settings = ObservableSettings::instance();
+        const bool enabled = settings.updatesEnabled();
+        const bool deferred = settings.updatesDeferred();
+        settings.disableUpdates(false);
+
+        bool successful = true;
+        std::string errMsg;
+        for (Size i=0; i<observers_.size(); ++i) {
+            try {
+                #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+                observers_[i]->update();
+                #else
+                // through the proxy, so that other notifications
+                // of the same observer are serialized with this one
+                proxies_[i]->update();
+                #endif
+            } catch (std::exception& e) {
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+
+        if (enabled)
+            settings.enableUpdates();
+        else
+            settings.disableUpdates(deferred);
+
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
+    void ObserverGraph::recalculate(Size threads) const {
+        QL_REQUIRE(threads > 0, "at least one thread required");
+        std::vector<ext::shared_ptr<Observer> > owners;
+        lock(owners);
+
+        bool successful = true;
+        std::string errMsg;
+        const SharedSettings settings;
+        for (const auto& groups : groups_) {
+            std::vector<std::string> errors(groups.size());
+            std::vector<char> failed(groups.size(), 0);
+            #pragma omp parallel for if(threads > 1) num_threads(threads)
+            for (long i=0; i<(long)groups.size(); ++i) {
+                const SharedSettings::Scope scope(settings);
+                for (auto* lazy : groups[i]) {
+                    try {
+                        lazy->ensureCalculated();
+                    } catch (std::exception& e) {
+                        failed[i] = 1;
+                        errors[i] = e.what();
+                    } catch (...) {
+                        failed[i] = 1;
+                    }
+                }
+            }
+            for (Size i=0; i<groups.size(); ++i) {
+                if (failed[i] != 0) {
+                    successful = false;
+                    if (!errors[i].empty())
+                        errMsg = errors[i];
+                }
+            }
+        }
+        QL_ENSURE(successful,
+                  "could not recalculate one or more objects: " << errMsg);
+    }
+
+}
@@ -0,0 +1,134 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file observergraph.hpp
+    \brief dependency graph of the observers of a set of observables
+*/
+
+#ifndef quantlib_observer_graph_hpp
+#define quantlib_observer_graph_hpp
+
+#include <ql/patterns/observable.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class LazyObject;
+
+    //! Observers reachable from a set of observables
+    /*! The graph is built once by following the registrations of
+        the given observables and, recursively, of those observers
+        that are observables themselves.  Each observer appears once
+        and observers are sorted in topological order; they are also
+        grouped by level, i.e., by the length of the longest path
+        leading to them from the sources, so that objects in the
+        same level don't depend on one another.  Observers taking
+        part in a dependency cycle are placed in a last level.
+
+        The notifications of a frozen LazyObject are not followed,
+        consistently with LazyObject::update().
+
+        The graph keeps the sources alive, but not the observers; it
+        is a snapshot of the registrations at construction.  Before
+        each update or recalculation, it checks that each observer
+        is still registered with the observable through which it
+        was found, which is not the case if the observer was
+        destroyed or unregistered, and raises an exception
+        otherwise.  In the thread-safe observer pattern, observers
+        owned by shared pointers are also kept alive during the
+        update or recalculation.
+
+        \warning Observers registering after construction are not
+                 detected, and observers not owned by shared
+                 pointers must not be destroyed while the graph is
+                 used.
+
+        \ingroup patterns
+    */
+    class ObserverGraph {
+      public:
+        explicit ObserverGraph(
+                   const std::vector<ext::shared_ptr<Observable> >& sources);
+        //! \name Inspectors
+        //@{
+        Size size() const { return observers_.size(); }
+        //! observers in topological order, grouped by level
+        const std::vector<Observer*>& observers() const {
+            return observers_;
+        }
+        Size levels() const { return levelStart_.size() - 1; }
+        //! index in observers() of the first observer in level \f$ l \f$
+        Size levelBegin(Size l) const { return levelStart_[l]; }
+        //! index in observers() past the last observer in level \f$ l \f$
+        Size levelEnd(Size l) const { return levelStart_[l+1]; }
+        //@}
+        //! \name Calculations
+        //@{
+        /*! Calls update() once on each observer, in topological
+            order.  Notifications sent meanwhile are discarded, as
+            all their recipients are in the graph already.
+        */
+        void update() const;
+        /*! Calculates the lazy objects in the graph, one level at a
+            time.  If more than one thread is given and the library
+            is compiled with OpenMP, objects in the same level are
+            calculated in parallel, except for those registered with
+            the same non-lazy observer in the graph (such as a
+            pricing engine) or using the same coupon pricer through
+            their coupons; since these are not safe to use from
+            several threads at once, such objects are calculated in
+            sequence by the same thread.  Frozen objects are not
+            recalculated.
+
+            \warning The calculations of distinct objects in a
+                     level are assumed not to share any mutable state
+                     besides the one described above.
+        */
+        void recalculate(Size threads = 1) const;
+        //@}
+      private:
+        struct Node {
+            Observer* observer;
+            #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+            ext::shared_ptr<Observer::Proxy> proxy;
+            // empty if the observer is not owned by shared pointers
+            ext::shared_ptr<Observer> owner;
+            #endif
+        };
+        static void observersOf(Observable*, std::vector<Node>&);
+        /* checks the registrations and, in the thread-safe observer
+           pattern, stores the observers owned by shared pointers */
+        void lock(std::vector<ext::shared_ptr<Observer> >& owners) const;
+        std::vector<ext::shared_ptr<Observable> > sources_;
+        std::vector<Observer*> observers_;
+        #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+        std::vector<ext::shared_ptr<Observer::Proxy> > proxies_;
+        #endif
+        // for each observer, in the order in which they were found,
+        // the observable through which it was found and its index
+        // in observers_
+        std::vector<std::pair<Observable*, Size> > registrations_;
+        std::vector<Size> levelStart_;
+        // for each level, the groups of lazy objects to be
+        // calculated in sequence by the same thread
+        std::vector<std::vector<std::vector<LazyObject*> > > groups_;
+    };
+
+}
+
+
+#endif
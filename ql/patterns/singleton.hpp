@@ -55,6 +55,7 @@
     #endif
 #endif
 
+#include <ql/errors.hpp>
 #include <ql/types.hpp>
 #include <ql/shared_ptr.hpp>
 #if defined(QL_PATCH_MSVC)
@@ -65,6 +66,7 @@
     #pragma managed(pop)
 #endif
 #include <map>
+#include <utility>
 
 
 #if (_MANAGED == 1) || (_M_CEE == 1)
@@ -122,8 +124,16 @@ namespace QuantLib {
 
         \ingroup patterns
     */
+    template <class T>
+    class ThreadLocalInstance;
+
+    template <class T>
+    class SharedThreadInstance;
+
     template <class T>
     class Singleton : private boost::noncopyable {
+        friend class ThreadLocalInstance<T>;
+        friend class SharedThreadInstance<T>;
     #if (QL_MANAGED == 1) && !defined(QL_SINGLETON_THREAD_SAFE_INIT)
       private:
         static std::map<ThreadKey, ext::shared_ptr<T> > instances_;
@@ -137,9 +147,88 @@ namespace QuantLib {
 
       public:
         //! access to the unique instance
+        /*! If a ThreadLocalInstance<T> was created in the calling
+            thread, the instance it holds is returned instead.
+        */
         static T& instance();
       protected:
         Singleton() = default;
+      private:
+        static T*& threadInstance();
+    };
+
+    //! Replacement of a singleton instance for the current thread
+    /*! While an instance of this class is alive, calls to
+        T::instance() from the thread that created it return the
+        given instance; other threads are not affected.  The lookup
+        costs an access to thread-local storage and takes no lock.
+
+        Replacements can be nested, and must be destroyed in the
+        thread that created them in reverse order of creation.
+
+        \ingroup patterns
+    */
+    template <class T>
+    class ThreadLocalInstance : private boost::noncopyable {
+      public:
+        explicit ThreadLocalInstance(ext::shared_ptr<T> instance)
+        : instance_(std::move(instance)),
+          previous_(Singleton<T>::threadInstance()) {
+            QL_REQUIRE(instance_, "null instance given");
+            Singleton<T>::threadInstance() = instance_.get();
+        }
+        ~ThreadLocalInstance() {
+            Singleton<T>::threadInstance() = previous_;
+        }
+        T& instance() const { return *instance_; }
+      private:
+        ext::shared_ptr<T> instance_;
+        T* previous_;
+    };
+
+    //! Propagation of the instance seen by a thread to other threads
+    /*! An instance of this class records the instance of T seen by
+        the thread that creates it, i.e., the one set by the
+        innermost ThreadLocalInstance<T> alive in that thread, if
+        any.  While a Scope built on it is alive, T::instance()
+        called from the thread that built the scope returns the
+        recorded instance.
+
+        This allows code distributing work over worker threads to
+        make them see the replacements made in the calling thread:
+        \code
+        const SharedThreadInstance<Foo> shared;
+        #pragma omp parallel for
+        for (long i=0; i<n; ++i) {
+            const SharedThreadInstance<Foo>::Scope scope(shared);
+            // Foo::instance() is the one seen outside the loop
+        }
+        \endcode
+
+        The recorded instance must outlive the scopes; scopes must
+        be destroyed in the thread that created them in reverse
+        order of creation.
+
+        \ingroup patterns
+    */
+    template <class T>
+    class SharedThreadInstance {
+      public:
+        SharedThreadInstance() : instance_(Singleton<T>::threadInstance()) {}
+        class Scope : private boost::noncopyable {
+          public:
+            explicit Scope(const SharedThreadInstance& shared)
+            : previous_(Singleton<T>::threadInstance()) {
+                Singleton<T>::threadInstance() = shared.instance_;
+            }
+            ~Scope() {
+                Singleton<T>::threadInstance() = previous_;
+            }
+          private:
+            T* previous_;
+        };
+      private:
+        T* instance_;
     };
 
     // static member definitions
@@ -156,9 +245,19 @@ namespace QuantLib {
     
     // template definitions
 
+    template <class T>
+    T*& Singleton<T>::threadInstance() {
+        static thread_local T* instance = nullptr;
+        return instance;
+    }
+
     template <class T>
     T& Singleton<T>::instance() {
 
+        T* local = threadInstance();
+        if (local != nullptr)
+            return *local;
+
         #if (QL_MANAGED == 0) && !defined(QL_SINGLETON_THREAD_SAFE_INIT)
         static std::map<ThreadKey, ext::shared_ptr<T> > instances_;
         #endif
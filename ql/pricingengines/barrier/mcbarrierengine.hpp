@@ -74,7 +74,8 @@ namespace QuantLib {
                         Real requiredTolerance,
                         Size maxSamples,
                         bool isBiased,
-                        BigNatural seed);
+                        BigNatural seed,
+                        Size threads = 1);
         void calculate() const override {
             Real spot = process_->x0();
             QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
@@ -99,7 +100,19 @@ namespace QuantLib {
                          new path_generator_type(process_,
                                                  grid, gen, brownianBridge_));
         }
+        ext::shared_ptr<path_generator_type>
+        workerPathGenerator(Size worker) const override {
+            TimeGrid grid = timeGrid();
+            typename RNG::rsg_type gen =
+                detail::SequenceStreams<RNG>::make(grid.size()-1, seed_,
+                                                   worker);
+            return ext::shared_ptr<path_generator_type>(
+                         new path_generator_type(process_,
+                                                 grid, gen, brownianBridge_));
+        }
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
+        ext::shared_ptr<path_pricer_type>
+        workerPathPricer(Size worker) const override;
         // data members
         ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_, timeStepsPerYear_;
@@ -126,6 +139,7 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -134,6 +148,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -193,8 +208,10 @@ namespace QuantLib {
         Real requiredTolerance,
         Size maxSamples,
         bool isBiased,
-        BigNatural seed)
-    : McSimulation<SingleVariate, RNG, S>(antitheticVariate, false), process_(std::move(process)),
+        BigNatural seed,
+        Size threads)
+    : McSimulation<SingleVariate, RNG, S>(antitheticVariate, false, threads),
+      process_(std::move(process)),
       timeSteps_(timeSteps), timeStepsPerYear_(timeStepsPerYear), requiredSamples_(requiredSamples),
       maxSamples_(maxSamples), requiredTolerance_(requiredTolerance), isBiased_(isBiased),
       brownianBridge_(brownianBridge), seed_(seed) {
@@ -232,6 +249,14 @@ namespace QuantLib {
     inline
     ext::shared_ptr<typename MCBarrierEngine<RNG,S>::path_pricer_type>
     MCBarrierEngine<RNG,S>::pathPricer() const {
+        return workerPathPricer(0);
+    }
+
+
+    template <class RNG, class S>
+    inline
+    ext::shared_ptr<typename MCBarrierEngine<RNG,S>::path_pricer_type>
+    MCBarrierEngine<RNG,S>::workerPathPricer(Size worker) const {
         ext::shared_ptr<PlainVanillaPayoff> payoff =
             ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non-plain payoff given");
@@ -253,8 +278,24 @@ namespace QuantLib {
                        payoff->strike(),
                        discounts));
         } else {
-            PseudoRandom::ursg_type sequenceGen(grid.size()-1,
-                                                PseudoRandom::urng_type(5));
+            // workers other than the first need their own uniform
+            // sequence for the crossing probabilities; it is derived
+            // from the engine seed (or random, if the seed is 0) so
+            // that different seeds give independent sequences.  The
+            // first worker keeps the sequence used for serial runs.
+            PseudoRandom::urng_type urng(5);
+            if (worker != 0) {
+                if (seed_ == 0) {
+                    urng = PseudoRandom::urng_type(0);
+                } else {
+                    std::vector<unsigned long> seeds(3);
+                    seeds[0] = static_cast<unsigned long>(seed_);
+                    seeds[1] = static_cast<unsigned long>(worker);
+                    seeds[2] = 5;
+                    urng = PseudoRandom::urng_type(seeds);
+                }
+            }
+            PseudoRandom::ursg_type sequenceGen(grid.size()-1, urng);
             return ext::shared_ptr<
                         typename MCBarrierEngine<RNG,S>::path_pricer_type>(
                 new BarrierPathPricer(
@@ -275,7 +316,7 @@ namespace QuantLib {
         ext::shared_ptr<GeneralizedBlackScholesProcess> process)
     : process_(std::move(process)), brownianBridge_(false), antithetic_(false), biased_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()), samples_(Null<Size>()),
-      maxSamples_(Null<Size>()), tolerance_(Null<Real>()), seed_(0) {}
+      maxSamples_(Null<Size>()), tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>&
@@ -347,6 +388,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -364,7 +412,8 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    biased_,
-                                   seed_));
+                                   seed_,
+                                   threads_));
     }
 
 }
@@ -0,0 +1,454 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/batchblackformula.hpp>
+#include <ql/pricingengines/blackcalculator.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+
+        // options are processed in blocks small enough for the
+        // intermediate results to stay in cache
+        const Size blockSize = 256;
+
+        struct Block {
+            Real d1[blockSize], d2[blockSize];
+            Real cum_d1[blockSize], cum_d2[blockSize];
+            Real alpha[blockSize], beta[blockSize];
+            Real DalphaDd1[blockSize], DbetaDd2[blockSize];
+        };
+
+        void checkInputs(const Option::Type* optionTypes,
+                         const Real* strikes,
+                         const Real* forwards,
+                         const Real* stdDevs,
+                         const Real* discounts,
+                         const Real* spots,
+                         const Time* maturities,
+                         Size n) {
+            for (Size i=0; i<n; ++i) {
+                QL_REQUIRE(optionTypes[i] == Option::Call ||
+                           optionTypes[i] == Option::Put,
+                           "invalid option type");
+                QL_REQUIRE(strikes[i]>=0.0,
+                           "strike (" << strikes[i] << ") must be non-negative");
+                QL_REQUIRE(forwards[i]>0.0,
+                           "forward (" << forwards[i] << ") must be positive");
+                QL_REQUIRE(stdDevs[i]>=0.0,
+                           "stdDev (" << stdDevs[i] << ") must be non-negative");
+                QL_REQUIRE(discounts[i]>0.0,
+                           "discount (" << discounts[i] << ") must be positive");
+                if (spots != nullptr)
+                    QL_REQUIRE(spots[i] > 0.0,
+                               "positive spot value required: " <<
+                               spots[i] << " not allowed");
+                if (maturities != nullptr)
+                    QL_REQUIRE(maturities[i]>=0.0,
+                               "maturity (" << maturities[i] << ") must be non-negative");
+            }
+        }
+
+        // the cases treated separately by BlackCalculator
+        bool isDegenerate(Real strike, Real stdDev) {
+            return stdDev < QL_EPSILON || close(strike, 0.0);
+        }
+
+        void calculateBlock(const Option::Type* optionTypes,
+                            const Real* strikes,
+                            const Real* forwards,
+                            const Real* stdDevs,
+                            const Real* discounts,
+                            const Real* spots,
+                            const Time* maturities,
+                            const BlackGreeks& r,
+                            Size offset,
+                            Size m,
+                            Block& b) {
+            const Option::Type* type = optionTypes + offset;
+            const Real* K = strikes + offset;
+            const Real* F = forwards + offset;
+            const Real* s = stdDevs + offset;
+            const Real* D = discounts + offset;
+            const Real* S = spots != nullptr ? spots + offset : nullptr;
+            const Time* T = maturities != nullptr ? maturities + offset : nullptr;
+            const Real normalization = M_SQRT_2 * M_1_SQRTPI;
+
+            #pragma omp simd
+            for (Size i=0; i<m; ++i) {
+                // 0 for calls, 1 for puts
+                const Real isPut = 0.5*(1.0 - Real(type[i]));
+                b.d1[i] = std::log(F[i]/K[i])/s[i] + 0.5*s[i];
+                b.d2[i] = b.d1[i]-s[i];
+                b.cum_d1[i] = 0.5*std::erfc(-b.d1[i]*M_SQRT_2);
+                b.cum_d2[i] = 0.5*std::erfc(-b.d2[i]*M_SQRT_2);
+                b.alpha[i] = b.cum_d1[i] - isPut;
+                b.beta[i] = isPut - b.cum_d2[i];
+                b.DalphaDd1[i] = normalization*std::exp(-0.5*b.d1[i]*b.d1[i]);
+                b.DbetaDd2[i] = -normalization*std::exp(-0.5*b.d2[i]*b.d2[i]);
+            }
+
+            // each result follows the calculations in BlackCalculator
+            if (r.value != nullptr) {
+                Real* value = r.value + offset;
+                #pragma omp simd
+                for (Size i=0; i<m; ++i)
+                    value[i] = D[i] * (F[i]*b.alpha[i] + K[i]*b.beta[i]);
+            }
+            if (r.deltaForward != nullptr) {
+                Real* deltaForward = r.deltaForward + offset;
+                #pragma omp simd
+                for (Size i=0; i<m; ++i) {
+                    Real temp = s[i]*F[i];
+                    Real DalphaDforward = b.DalphaDd1[i]/temp;
+                    Real DbetaDforward  = b.DbetaDd2[i]/temp;
+                    deltaForward[i] = D[i] * (DalphaDforward * F[i] + b.alpha[i]
+                                              + DbetaDforward * K[i]);
+                }
+            }
+            if (r.gammaForward != nullptr) {
+                Real* gammaForward = r.gammaForward + offset;
+                #pragma omp simd
+                for (Size i=0; i<m; ++i) {
+                    Real temp = s[i]*F[i];
+                    Real DalphaDforward = b.DalphaDd1[i]/temp;
+                    Real DbetaDforward  = b.DbetaDd2[i]/temp;
+                    Real D2alphaDforward2 =
+                        - DalphaDforward/F[i]*(1+b.d1[i]/s[i]);
+                    Real D2betaDforward2 =
+                        - DbetaDforward/F[i]*(1+b.d2[i]/s[i]);
+                    gammaForward[i] =
+                        D[i] * (D2alphaDforward2 * F[i] + 2.0 * DalphaDforward
+                                + D2betaDforward2 * K[i]);
+                }
+            }
+            if (r.strikeSensitivity != nullptr) {
+                Real* strikeSensitivity = r.strikeSensitivity + offset;
+                #pragma omp simd
+                for (Size i=0; i<m; ++i) {
+                    Real temp = s[i]*K[i];
+                    Real DalphaDstrike = -b.DalphaDd1[i]/temp;
+                    Real DbetaDstrike  = -b.DbetaDd2[i]/temp;
+                    strikeSensitivity[i] =
+                        D[i] * (DalphaDstrike * F[i] + DbetaDstrike * K[i]
+                                + b.beta[i]);
+                }
+            }
+            if (r.itmCashProbability != nullptr)
+                std::copy(b.cum_d2, b.cum_d2 + m,
+                          r.itmCashProbability + offset);
+            if (r.itmAssetProbability != nullptr)
+                std::copy(b.cum_d1, b.cum_d1 + m,
+                          r.itmAssetProbability + offset);
+            if (r.delta != nullptr || r.gamma != nullptr || r.theta != nullptr) {
+                Real* delta = r.delta != nullptr ? r.delta + offset : nullptr;
+                Real* gamma = r.gamma != nullptr ? r.gamma + offset : nullptr;
+                Real* theta = r.theta != nullptr ? r.theta + offset : nullptr;
+                // a tolerance such that close(t, 0.0) iff t < tolerance
+                const Real tolerance = (42*QL_EPSILON)*(42*QL_EPSILON);
+                #pragma omp simd
+                for (Size i=0; i<m; ++i) {
+                    Real DforwardDs = F[i] / S[i];
+                    Real temp = s[i]*S[i];
+                    Real DalphaDs = b.DalphaDd1[i]/temp;
+                    Real DbetaDs  = b.DbetaDd2[i]/temp;
+                    Real de = D[i] * (DalphaDs * F[i] + b.alpha[i] * DforwardDs
+                                      + DbetaDs * K[i]);
+                    Real D2alphaDs2 = - DalphaDs/S[i]*(1+b.d1[i]/s[i]);
+                    Real D2betaDs2  = - DbetaDs /S[i]*(1+b.d2[i]/s[i]);
+                    Real ga = D[i] * (D2alphaDs2 * F[i]
+                                      + 2.0 * DalphaDs * DforwardDs
+                                      + D2betaDs2 * K[i]);
+                    if (delta != nullptr)
+                        delta[i] = de;
+                    if (gamma != nullptr)
+                        gamma[i] = ga;
+                    if (theta != nullptr) {
+                        Real value = D[i] * (F[i]*b.alpha[i] + K[i]*b.beta[i]);
+                        Real th = -( std::log(D[i]) * value
+                                    +std::log(F[i]/S[i]) * S[i] * de
+                                    +0.5*s[i]*s[i] * S[i] * S[i] * ga)/T[i];
+                        theta[i] = T[i] < tolerance ? 0.0 : th;
+                    }
+                }
+            }
+            if (r.vega != nullptr) {
+                Real* vega = r.vega + offset;
+                #pragma omp simd
+                for (Size i=0; i<m; ++i) {
+                    Real temp = std::log(K[i]/F[i])/(s[i]*s[i]);
+                    Real DalphaDsigma = b.DalphaDd1[i]*(temp+0.5);
+                    Real DbetaDsigma  = b.DbetaDd2[i] *(temp-0.5);
+                    vega[i] = D[i] * std::sqrt(T[i])
+                        * (DalphaDsigma * F[i] + DbetaDsigma * K[i]);
+                }
+            }
+            if (r.rho != nullptr) {
+                Real* rho = r.rho + offset;
+                #pragma omp simd
+                for (Size i=0; i<m; ++i) {
+                    Real DalphaDr = b.DalphaDd1[i]/s[i];
+                    Real DbetaDr  = b.DbetaDd2[i]/s[i];
+                    Real temp = DalphaDr * F[i] + b.alpha[i] * F[i]
+                        + DbetaDr * K[i];
+                    Real value = D[i] * (F[i]*b.alpha[i] + K[i]*b.beta[i]);
+                    rho[i] = T[i] * (D[i] * temp - value);
+                }
+            }
+            if (r.dividendRho != nullptr) {
+                Real* dividendRho = r.dividendRho + offset;
+                #pragma omp simd
+                for (Size i=0; i<m; ++i) {
+                    Real DalphaDq = -b.DalphaDd1[i]/s[i];
+                    Real DbetaDq  = -b.DbetaDd2[i]/s[i];
+                    Real temp = DalphaDq * F[i] - b.alpha[i] * F[i]
+                        + DbetaDq * K[i];
+                    dividendRho[i] = T[i] * D[i] * temp;
+                }
+            }
+
+            // degenerate cases are delegated to BlackCalculator
+            for (Size i=0; i<m; ++i) {
+                if (!isDegenerate(K[i], s[i]))
+                    continue;
+                BlackCalculator black(type[i], K[i], F[i], s[i], D[i]);
+                Size j = offset + i;
+                if (r.value != nullptr)
+                    r.value[j] = black.value();
+                if (r.deltaForward != nullptr)
+                    r.deltaForward[j] = black.deltaForward();
+                if (r.gammaForward != nullptr)
+                    r.gammaForward[j] = black.gammaForward();
+                if (r.strikeSensitivity != nullptr)
+                    r.strikeSensitivity[j] = black.strikeSensitivity();
+                if (r.itmCashProbability != nullptr)
+                    r.itmCashProbability[j] = black.itmCashProbability();
+                if (r.itmAssetProbability != nullptr)
+                    r.itmAssetProbability[j] = black.itmAssetProbability();
+                if (r.delta != nullptr)
+                    r.delta[j] = black.delta(S[i]);
+                if (r.gamma != nullptr)
+                    r.gamma[j] = black.gamma(S[i]);
+                if (r.theta != nullptr)
+                    r.theta[j] = black.theta(S[i], T[i]);
+                if (r.vega != nullptr)
+                    r.vega[j] = black.vega(T[i]);
+                if (r.rho != nullptr)
+                    r.rho[j] = black.rho(T[i]);
+                if (r.dividendRho != nullptr)
+                    r.dividendRho[j] = black.dividendRho(T[i]);
+            }
+        }
+
+    }
+
+    void blackFormula(const Option::Type* optionTypes,
+                      const Real* strikes,
+                      const Real* forwards,
+                      const Real* stdDevs,
+                      const Real* discounts,
+                      Real* values,
+                      Size n,
+                      Size threads) {
+        BlackGreeks results;
+        results.value = values;
+        blackFormulaGreeks(optionTypes, strikes, forwards, stdDevs,
+                           discounts, nullptr, nullptr, results, n, threads);
+    }
+
+    void blackFormulaGreeks(const Option::Type* optionTypes,
+                            const Real* strikes,
+                            const Real* forwards,
+                            const Real* stdDevs,
+                            const Real* discounts,
+                            const Real* spots,
+                            const Time* maturities,
+                            const BlackGreeks& results,
+                            Size n,
+                            Size threads) {
+        QL_REQUIRE(threads > 0, "at least one thread required");
+        QL_REQUIRE(spots != nullptr || (results.delta == nullptr &&
+                                        results.gamma == nullptr &&
+                                        results.theta == nullptr),
+                   "spots required for delta, gamma and theta");
+        QL_REQUIRE(maturities != nullptr || (results.theta == nullptr &&
+                                             results.vega == nullptr &&
+                                             results.rho == nullptr &&
+                                             results.dividendRho == nullptr),
+                   "maturities required for theta, vega, rho "
+                   "and dividend rho");
+        checkInputs(optionTypes, strikes, forwards, stdDevs, discounts,
+                    spots, maturities, n);
+
+        const Size nBlocks = (n + blockSize - 1) / blockSize;
+        #pragma omp parallel for if(threads > 1) num_threads(threads)
+        for (long k=0; k<(long)nBlocks; ++k) {
+            const Size offset = Size(k) * blockSize;
+            Block block;
+            calculateBlock(optionTypes, strikes, forwards, stdDevs,
+                           discounts, spots, maturities, results,
+                           offset, std::min(blockSize, n - offset), block);
+        }
+    }
+
+
+    namespace {
+
+        /* Quotes are reduced to an out-of-the-money call, struck at
+           max(F,K) on a forward min(F,K), and the price is normalized
+           as in P. Jaeckel, "Let's be rational", Wilmott (2015), so
+           that it only depends on x = log(F/K) <= 0 and on the
+           standard deviation s:
+
+           b(x,s) = exp(x/2) N(x/s+s/2) - exp(-x/2) N(x/s-s/2).
+        */
+        void impliedStdDevBlock(const Option::Type* optionTypes,
+                                const Real* strikes,
+                                const Real* forwards,
+                                const Real* blackPrices,
+                                const Real* discounts,
+                                Real* stdDevs,
+                                BlackImpliedStdDevStatus::Code* status,
+                                Size m,
+                                Real accuracy,
+                                Natural householderSteps) {
+            Real x[blockSize], beta[blockSize], s[blockSize], ds[blockSize];
+            int code[blockSize], solve[blockSize];
+            const Real normalization = M_SQRT_2 * M_1_SQRTPI;
+
+            #pragma omp simd
+            for (Size i=0; i<m; ++i) {
+                const Real K = strikes[i], F = forwards[i], D = discounts[i];
+                const bool valid = (optionTypes[i] == Option::Call ||
+                                    optionTypes[i] == Option::Put)
+                    && K > 0.0 && F > 0.0 && D > 0.0 && blackPrices[i] >= 0.0;
+                const Real intrinsic =
+                    std::max(Real(optionTypes[i])*(F-K), Real(0.0));
+                const Real price = blackPrices[i]/D - intrinsic;
+                const Real lower = std::min(F, K), upper = std::max(F, K);
+                code[i] = !valid ? BlackImpliedStdDevStatus::InvalidInput
+                    : price < 0.0 ? BlackImpliedStdDevStatus::BelowIntrinsicValue
+                    : price >= lower ? BlackImpliedStdDevStatus::AboveMaximumValue
+                    : BlackImpliedStdDevStatus::Success;
+                solve[i] =
+                    code[i] == BlackImpliedStdDevStatus::Success && price > 0.0;
+
+                // quotes not to be solved are replaced by harmless ones
+                const Real xi = solve[i] != 0 ? Real(std::log(lower/upper)) : 0.0;
+                const Real b = solve[i] != 0 ? price/std::sqrt(lower*upper) : 0.1;
+                x[i] = xi;
+                beta[i] = b;
+
+                // Radoicic-Stefanica guess for the equivalent call
+                // with unit strike, as in the scalar version
+                const Real ey = std::exp(xi), ey2 = ey*ey;
+                const Real alpha = b*std::exp(0.5*xi);
+                const Real R = 2*alpha + 1.0 - ey, R2 = R*R;
+                const Real a = std::exp((1.0-M_2_PI)*xi);
+                const Real A = (a - 1.0/a)*(a - 1.0/a);
+                const Real c = std::exp(M_2_PI*xi);
+                const Real B = 4.0*(c + 1.0/c) - 2.0/ey*(a + 1.0/a)*(ey2 + 1 - R2);
+                const Real C = (R2-(ey-1)*(ey-1))*((ey+1)*(ey+1)-R2)/ey2;
+                const Real gamma =
+                    -M_PI_2*std::log(2*C/(B+std::sqrt(B*B+4*A*C)));
+                const Real M0 = 0.5*ey
+                    - 0.5*(1.0-std::sqrt(1.0-std::exp(2.0*M_2_PI*xi)));
+                const Real guess = alpha <= M0
+                    ? std::sqrt(gamma-xi) - std::sqrt(gamma+xi)
+                    : std::sqrt(gamma+xi) + std::sqrt(gamma-xi);
+                // fallback (also for NaN) close to the point of maximum vega
+                s[i] = guess > 0.0 ? guess
+                    : std::sqrt(-2.0*xi) + b/normalization;
+                ds[i] = 0.0;
+            }
+
+            for (Natural k=0; k<householderSteps; ++k) {
+                #pragma omp simd
+                for (Size i=0; i<m; ++i) {
+                    const Real si = s[i], xi = x[i];
+                    const Real d1 = xi/si + 0.5*si, d2 = d1 - si;
+                    const Real b =
+                        std::exp(0.5*xi)*0.5*std::erfc(-d1*M_SQRT_2)
+                        - std::exp(-0.5*xi)*0.5*std::erfc(-d2*M_SQRT_2);
+                    const Real x2s2 = xi*xi/(si*si);
+                    const Real vega =
+                        normalization*std::exp(-0.5*(x2s2 + 0.25*si*si));
+                    // second and third derivatives over the first
+                    const Real h2 = x2s2/si - 0.25*si;
+                    const Real h3 = h2*h2 - 3.0*x2s2/(si*si) - 0.25;
+                    const Real nu = (beta[i]-b)/vega;
+                    const Real step =
+                        nu*(1.0+0.5*h2*nu)/(1.0+nu*(h2+h3*nu/6.0));
+                    const Real next = si + step;
+                    // keep the standard deviation positive
+                    s[i] = next > 0.0 ? next
+                        : (step < 0.0 ? 0.5*si : 2.0*si);
+                    ds[i] = step;
+                }
+            }
+
+            const Real null = Null<Real>();
+            #pragma omp simd
+            for (Size i=0; i<m; ++i) {
+                const bool converged = std::fabs(ds[i]) <= accuracy;
+                if (solve[i] != 0 && !converged)
+                    code[i] = BlackImpliedStdDevStatus::NotConverged;
+                const bool success =
+                    code[i] == BlackImpliedStdDevStatus::Success;
+                stdDevs[i] = !success ? null : (solve[i] != 0 ? s[i] : 0.0);
+            }
+            for (Size i=0; i<m; ++i)
+                status[i] = BlackImpliedStdDevStatus::Code(code[i]);
+        }
+
+    }
+
+    void blackFormulaImpliedStdDev(const Option::Type* optionTypes,
+                                   const Real* strikes,
+                                   const Real* forwards,
+                                   const Real* blackPrices,
+                                   const Real* discounts,
+                                   Real* stdDevs,
+                                   BlackImpliedStdDevStatus::Code* status,
+                                   Size n,
+                                   Real accuracy,
+                                   Natural householderSteps,
+                                   Size threads) {
+        QL_REQUIRE(threads > 0, "at least one thread required");
+        QL_REQUIRE(accuracy > 0.0,
+                   "accuracy (" << accuracy << ") must be positive");
+        QL_REQUIRE(householderSteps > 0,
+                   "at least one Householder step required");
+
+        const Size nBlocks = (n + blockSize - 1) / blockSize;
+        #pragma omp parallel for if(threads > 1) num_threads(threads)
+        for (long k=0; k<(long)nBlocks; ++k) {
+            const Size offset = Size(k) * blockSize;
+            impliedStdDevBlock(optionTypes + offset, strikes + offset,
+                               forwards + offset, blackPrices + offset,
+                               discounts + offset, stdDevs + offset,
+                               status + offset,
+                               std::min(blockSize, n - offset),
+                               accuracy, householderSteps);
+        }
+    }
+
+}
@@ -0,0 +1,142 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchblackformula.hpp
+    \brief Black formula and greeks over arrays of options
+*/
+
+#ifndef quantlib_batch_black_formula_hpp
+#define quantlib_batch_black_formula_hpp
+
+#include <ql/option.hpp>
+
+namespace QuantLib {
+
+    //! arrays receiving the results of blackFormulaGreeks
+    /*! Results whose array is null are not calculated.  The
+        sensitivities are those returned by BlackCalculator for a
+        plain-vanilla payoff with the same inputs.
+    */
+    struct BlackGreeks {
+        Real* value = nullptr;
+        Real* deltaForward = nullptr;
+        Real* gammaForward = nullptr;
+        Real* strikeSensitivity = nullptr;
+        Real* itmCashProbability = nullptr;
+        Real* itmAssetProbability = nullptr;
+        //! these require the spots
+        Real* delta = nullptr;
+        Real* gamma = nullptr;
+        //! this requires both the spots and the maturities
+        Real* theta = nullptr;
+        //! these require the maturities
+        Real* vega = nullptr;
+        Real* rho = nullptr;
+        Real* dividendRho = nullptr;
+    };
+
+    /*! Black 1976 formula over \f$ n \f$ options given as separate
+        arrays of inputs (structure of arrays.)  The results are
+        consistent with the ones of BlackCalculator; the loops over
+        the options have no branches, so that they can be
+        vectorized, and batches of options are priced in parallel
+        over the given number of threads if OpenMP is enabled.
+
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    void blackFormula(const Option::Type* optionTypes,
+                      const Real* strikes,
+                      const Real* forwards,
+                      const Real* stdDevs,
+                      const Real* discounts,
+                      Real* values,
+                      Size n,
+                      Size threads = 1);
+
+    /*! Black 1976 formula and greeks over \f$ n \f$ options given as
+        separate arrays of inputs; see BlackGreeks for the available
+        results.  The spots and the maturities can be null if no
+        result requiring them is asked for.  As for blackFormula,
+        batches of options are priced in parallel over the given
+        number of threads if OpenMP is enabled.
+
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    void blackFormulaGreeks(const Option::Type* optionTypes,
+                            const Real* strikes,
+                            const Real* forwards,
+                            const Real* stdDevs,
+                            const Real* discounts,
+                            const Real* spots,
+                            const Time* maturities,
+                            const BlackGreeks& results,
+                            Size n,
+                            Size threads = 1);
+
+    //! outcome of the implied standard-deviation calculation for a quote
+    struct BlackImpliedStdDevStatus {
+        enum Code { Success,
+                    InvalidInput,        //!< non-positive forward, strike
+                                         //!< or discount, or negative price
+                    BelowIntrinsicValue, //!< price below intrinsic value
+                    AboveMaximumValue,   //!< price not below the forward
+                                         //!< (calls) or strike (puts)
+                    NotConverged         //!< accuracy not reached
+        };
+    };
+
+    /*! Black 1976 implied standard deviation over \f$ n \f$ quotes
+        given as separate arrays of inputs, e.g., one or more option
+        chains stored one after the other.
+
+        The initial guess is given by the explicit formula by
+        Radoicic and Stefanica (see
+        blackFormulaImpliedStdDevApproximationRS) and is refined by a
+        fixed number of third-order Householder steps on the
+        normalized price of the out-of-the-money option.  As for
+        blackFormula, the loops have no branches, so that they can be
+        vectorized, and batches of quotes are processed in parallel
+        over the given number of threads if OpenMP is enabled.
+
+        No exception is raised for invalid quotes; instead, the
+        outcome for each quote is written in the status array and
+        the corresponding standard deviation is set to
+        Null<Real>().  A quote is reported as not converged if the
+        last Householder correction exceeds the given accuracy.
+
+        \warning for out-of-the-money prices below about 1e-8 times
+                 the forward, the accuracy is limited by cancellation
+                 in the calculation of the normalized price.
+    */
+    void blackFormulaImpliedStdDev(const Option::Type* optionTypes,
+                                   const Real* strikes,
+                                   const Real* forwards,
+                                   const Real* blackPrices,
+                                   const Real* discounts,
+                                   Real* stdDevs,
+                                   BlackImpliedStdDevStatus::Code* status,
+                                   Size n,
+                                   Real accuracy = 1.0e-6,
+                                   Natural householderSteps = 3,
+                                   Size threads = 1);
+
+}
+
+
+#endif
@@ -42,11 +42,23 @@ namespace QuantLib {
                                        *includeSettlementDateFlows_ :
                                        Settings::instance().includeReferenceDateEvents();
 
-        results_.value = CashFlows::npv(arguments_.cashflows,
-                                        **discountCurve_,
-                                        includeRefDateFlows,
-                                        results_.valuationDate,
-                                        results_.valuationDate);
+        // the compiled cash flows are used if the bond provides them
+        const FlatLeg* flatCashflows = nullptr;
+        if (arguments_.flatCashflows != nullptr
+            && arguments_.flatCashflows->leg() == arguments_.cashflows)
+            flatCashflows = arguments_.flatCashflows.get();
+
+        if (flatCashflows != nullptr)
+            results_.value = flatCashflows->npv(**discountCurve_,
+                                                includeRefDateFlows,
+                                                results_.valuationDate,
+                                                results_.valuationDate);
+        else
+            results_.value = CashFlows::npv(arguments_.cashflows,
+                                            **discountCurve_,
+                                            includeRefDateFlows,
+                                            results_.valuationDate,
+                                            results_.valuationDate);
 
         // a bond's cashflow on settlement date is never taken into
         // account, so we might have to play it safe and recalculate
@@ -56,12 +68,19 @@ namespace QuantLib {
             results_.settlementValue = results_.value;
         } else {
             // no such luck
-            results_.settlementValue =
-                CashFlows::npv(arguments_.cashflows,
-                               **discountCurve_,
-                               false,
-                               arguments_.settlementDate,
-                               arguments_.settlementDate);
+            if (flatCashflows != nullptr)
+                results_.settlementValue =
+                    flatCashflows->npv(**discountCurve_,
+                                       false,
+                                       arguments_.settlementDate,
+                                       arguments_.settlementDate);
+            else
+                results_.settlementValue =
+                    CashFlows::npv(arguments_.cashflows,
+                                   **discountCurve_,
+                                   false,
+                                   arguments_.settlementDate,
+                                   arguments_.settlementDate);
         }
     }
 
@@ -68,7 +68,11 @@ namespace QuantLib {
           calibration and pricing; note however that this has no effect
           for low discrepancy RNGs usually, it is therefore recommended
           to use pseudo random generators for the calibration phase always
-          (and possibly quasi monte carlo in the subsequent pricing). */
+          (and possibly quasi monte carlo in the subsequent pricing).
+
+          If more than one thread is given, both the calibration
+          paths and the pricing paths are generated in parallel,
+          each thread drawing from its own random stream. */
         MCLongstaffSchwartzEngine(ext::shared_ptr<StochasticProcess> process,
                                   Size timeSteps,
                                   Size timeStepsPerYear,
@@ -82,7 +86,8 @@ namespace QuantLib {
                                   Size nCalibrationSamples = Null<Size>(),
                                   boost::optional<bool> brownianBridgeCalibration = boost::none,
                                   boost::optional<bool> antitheticVariateCalibration = boost::none,
-                                  BigNatural seedCalibration = Null<Size>());
+                                  BigNatural seedCalibration = Null<Size>(),
+                                  Size threads = 1);
 
         void calculate() const override;
 
@@ -93,6 +98,10 @@ namespace QuantLib {
         TimeGrid timeGrid() const override;
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
         ext::shared_ptr<path_generator_type> pathGenerator() const override;
+        ext::shared_ptr<path_generator_type>
+        workerPathGenerator(Size worker) const override;
+        ext::shared_ptr<path_pricer_type>
+        workerPathPricer(Size worker) const override;
 
         ext::shared_ptr<StochasticProcess> process_;
         const Size timeSteps_;
@@ -133,8 +142,10 @@ namespace QuantLib {
                                   Size nCalibrationSamples,
                                   boost::optional<bool> brownianBridgeCalibration,
                                   boost::optional<bool> antitheticVariateCalibration,
-                                  BigNatural seedCalibration)
-    : McSimulation<MC, RNG, S>(antitheticVariate, controlVariate), process_(std::move(process)),
+                                  BigNatural seedCalibration,
+                                  Size threads)
+    : McSimulation<MC, RNG, S>(antitheticVariate, controlVariate, threads),
+      process_(std::move(process)),
       timeSteps_(timeSteps), timeStepsPerYear_(timeStepsPerYear), brownianBridge_(brownianBridge),
       requiredSamples_(requiredSamples), requiredTolerance_(requiredTolerance),
       maxSamples_(maxSamples), seed_(seed),
@@ -194,7 +205,37 @@ namespace QuantLib {
                     pathGeneratorCalibration, pathPricer_, stats_type(),
                     this->antitheticVariateCalibration_));
 
-        mcModelCalibration_->addSamples(nCalibrationSamples_);
+        if (this->threads_ > 1
+            && detail::SequenceStreams<RNG_Calibration>::available) {
+            // each worker stores its paths in a separate collector;
+            // they are passed to the pricer in worker order so that
+            // the calibration is reproducible.
+            std::vector<ext::shared_ptr<path_generator_type_calibration> >
+                generators(this->threads_);
+            std::vector<ext::shared_ptr<
+                LongstaffSchwartzPathCollector<path_type> > >
+                collectors(this->threads_);
+            std::vector<ext::shared_ptr<PathPricer<path_type> > >
+                pricers(this->threads_);
+            for (Size i=0; i<this->threads_; ++i) {
+                generators[i] =
+                    ext::make_shared<path_generator_type_calibration>(
+                        process_, grid,
+                        detail::SequenceStreams<RNG_Calibration>::make(
+                            dimensions * (grid.size() - 1),
+                            seedCalibration_, i),
+                        brownianBridgeCalibration_);
+                collectors[i] = ext::make_shared<
+                    LongstaffSchwartzPathCollector<path_type> >();
+                pricers[i] = collectors[i];
+            }
+            mcModelCalibration_->setWorkers(generators, pricers);
+            mcModelCalibration_->addSamples(nCalibrationSamples_);
+            for (Size i=0; i<this->threads_; ++i)
+                pathPricer_->addCalibrationPaths(collectors[i]->paths());
+        } else {
+            mcModelCalibration_->addSamples(nCalibrationSamples_);
+        }
         pathPricer_->calibrate();
         // pricing
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
@@ -255,6 +296,34 @@ namespace QuantLib {
                                            grid, generator, brownianBridge_));
     }
 
+    template <class GenericEngine, template <class> class MC, class RNG,
+              class S, class RNG_Calibration>
+    inline ext::shared_ptr<typename MCLongstaffSchwartzEngine<
+        GenericEngine, MC, RNG, S, RNG_Calibration>::path_generator_type>
+    MCLongstaffSchwartzEngine<GenericEngine, MC, RNG, S, RNG_Calibration>::
+    workerPathGenerator(Size worker) const {
+
+        Size dimensions = process_->factors();
+        TimeGrid grid = this->timeGrid();
+        typename RNG::rsg_type generator =
+            detail::SequenceStreams<RNG>::make(dimensions*(grid.size()-1),
+                                               seed_, worker);
+        return ext::shared_ptr<path_generator_type>(
+                   new path_generator_type(process_,
+                                           grid, generator, brownianBridge_));
+    }
+
+    template <class GenericEngine, template <class> class MC, class RNG,
+              class S, class RNG_Calibration>
+    inline ext::shared_ptr<typename MCLongstaffSchwartzEngine<
+        GenericEngine, MC, RNG, S, RNG_Calibration>::path_pricer_type>
+    MCLongstaffSchwartzEngine<GenericEngine, MC, RNG, S, RNG_Calibration>::
+    workerPathPricer(Size) const {
+        // the calibrated pricer is shared; in the pricing phase it
+        // can be safely called from several threads.
+        return pathPricer();
+    }
+
 }
 
 
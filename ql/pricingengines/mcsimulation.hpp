@@ -66,13 +66,38 @@ namespace QuantLib {
                        Size requiredSamples,
                        Size maxSamples) const;
       protected:
+        /*! If more than one thread is given, samples are drawn in
+            parallel; see MonteCarloModel::setWorkers() for details.
+            In this case, the derived engine must implement
+            workerPathGenerator().  If the random-number traits
+            don't provide independent streams, samples are drawn
+            serially.
+        */
         McSimulation(bool antitheticVariate,
-                     bool controlVariate)
+                     bool controlVariate,
+                     Size threads = 1)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), threads_(threads) {
+            QL_REQUIRE(threads_ > 0, "at least one thread required");
+        }
         virtual ext::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual ext::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
+        //! path generator for the given worker thread
+        /*! The generator for worker 0 should draw the same sequence
+            as the one returned by pathGenerator(); the others must
+            draw from non-overlapping streams.
+        */
+        virtual ext::shared_ptr<path_generator_type>
+        workerPathGenerator(Size) const {
+            QL_FAIL("multithreaded sampling not supported by this engine");
+        }
+        //! path pricer for the given worker thread
+        /*! By default, a new path pricer is built for each worker. */
+        virtual ext::shared_ptr<path_pricer_type>
+        workerPathPricer(Size) const {
+            return pathPricer();
+        }
         virtual TimeGrid timeGrid() const = 0;
         virtual ext::shared_ptr<path_pricer_type> controlPathPricer() const {
             return ext::shared_ptr<path_pricer_type>();
@@ -97,6 +122,9 @@ namespace QuantLib {
         
         mutable ext::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size threads_;
+      private:
+        void setWorkers() const;
     };
 
 
@@ -195,6 +223,9 @@ namespace QuantLib {
                            this->antitheticVariate_));
         }
 
+        if (threads_ > 1 && detail::SequenceStreams<RNG>::available)
+            setWorkers();
+
         if (requiredTolerance != Null<Real>()) {
             if (maxSamples != Null<Size>())
                 this->value(requiredTolerance, maxSamples);
@@ -206,6 +237,18 @@ namespace QuantLib {
 
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::setWorkers() const {
+        std::vector<ext::shared_ptr<path_generator_type> >
+            generators(threads_);
+        std::vector<ext::shared_ptr<path_pricer_type> > pricers(threads_);
+        for (Size i=0; i<threads_; ++i) {
+            generators[i] = this->workerPathGenerator(i);
+            pricers[i] = this->workerPathPricer(i);
+        }
+        mcModel_->setWorkers(generators, pricers);
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline typename McSimulation<MC,RNG,S>::result_type
         McSimulation<MC,RNG,S>::errorEstimate() const {
@@ -77,24 +77,43 @@ namespace QuantLib {
         for (Size i=0; i<n; ++i) {
             try {
                 const YieldTermStructure& discount_ref = **discountCurve_;
-                CashFlows::npvbps(arguments_.legs[i],
-                                  discount_ref,
-                                  includeRefDateFlows,
-                                  settlementDate,
-                                  results_.valuationDate,
-                                  results_.legNPV[i],
-                                  results_.legBPS[i]);
+                // the compiled leg is used if the instrument provides it
+                const FlatLeg* flatLeg = nullptr;
+                if (i < arguments_.flatLegs.size()
+                    && arguments_.flatLegs[i] != nullptr
+                    && arguments_.flatLegs[i]->leg() == arguments_.legs[i])
+                    flatLeg = arguments_.flatLegs[i].get();
+
+                if (flatLeg != nullptr)
+                    flatLeg->npvbps(discount_ref,
+                                    includeRefDateFlows,
+                                    settlementDate,
+                                    results_.valuationDate,
+                                    results_.legNPV[i],
+                                    results_.legBPS[i]);
+                else
+                    CashFlows::npvbps(arguments_.legs[i],
+                                      discount_ref,
+                                      includeRefDateFlows,
+                                      settlementDate,
+                                      results_.valuationDate,
+                                      results_.legNPV[i],
+                                      results_.legBPS[i]);
                 results_.legNPV[i] *= arguments_.payer[i];
                 results_.legBPS[i] *= arguments_.payer[i];
 
                 if (!arguments_.legs[i].empty()) {
-                    Date d1 = CashFlows::startDate(arguments_.legs[i]);
+                    Date d1 = flatLeg != nullptr ?
+                        flatLeg->startDate() :
+                        CashFlows::startDate(arguments_.legs[i]);
                     if (d1>=refDate)
                         results_.startDiscounts[i] = discountCurve_->discount(d1);
                     else
                         results_.startDiscounts[i] = Null<DiscountFactor>();
 
-                    Date d2 = CashFlows::maturityDate(arguments_.legs[i]);
+                    Date d2 = flatLeg != nullptr ?
+                        flatLeg->maturityDate() :
+                        CashFlows::maturityDate(arguments_.legs[i]);
                     if (d2>=refDate)
                         results_.endDiscounts[i] = discountCurve_->discount(d2);
                     else
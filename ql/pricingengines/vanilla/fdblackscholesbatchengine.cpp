@@ -0,0 +1,259 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmultistrikemesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/predefined1dmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesbatchengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* Sets the values of each option to its payoff at its
+           maturity, and applies the early exercise of American
+           options at any time before.  The values of the k-th option
+           are the k-th line of the given size in the array.
+        */
+        class FdmBatchExerciseCondition : public StepCondition<Array> {
+          public:
+            FdmBatchExerciseCondition(std::vector<Time> maturities,
+                                      std::vector<bool> american,
+                                      Array payoffValues,
+                                      Array exerciseValues,
+                                      Size lineSize)
+            : maturities_(std::move(maturities)),
+              american_(std::move(american)),
+              payoffValues_(std::move(payoffValues)),
+              exerciseValues_(std::move(exerciseValues)),
+              lineSize_(lineSize) {}
+
+            void applyTo(Array& a, Time t) const override {
+                QL_REQUIRE(a.size() == payoffValues_.size(),
+                           "inconsistent array dimensions");
+
+                for (Size k=0; k < maturities_.size(); ++k) {
+                    const Size first = k*lineSize_, last = first + lineSize_;
+                    if (t == maturities_[k]) {
+                        std::copy(payoffValues_.begin() + first,
+                                  payoffValues_.begin() + last,
+                                  a.begin() + first);
+                    } else if (american_[k] && t < maturities_[k]) {
+                        for (Size i=first; i < last; ++i)
+                            a[i] = std::max(a[i], exerciseValues_[i]);
+                    }
+                }
+            }
+
+          private:
+            const std::vector<Time> maturities_;
+            const std::vector<bool> american_;
+            const Array payoffValues_, exerciseValues_;
+            const Size lineSize_;
+        };
+
+    }
+
+    FdBlackScholesBatchEngine::FdBlackScholesBatchEngine(
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+        Size tGrid,
+        Size xGrid,
+        Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc,
+        bool localVol,
+        Real illegalLocalVolOverwrite,
+        Real volatilityStrike)
+    : process_(std::move(process)), tGrid_(tGrid), xGrid_(xGrid),
+      dampingSteps_(dampingSteps), schemeDesc_(schemeDesc),
+      localVol_(localVol), illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      volatilityStrike_(volatilityStrike) {
+        QL_REQUIRE(process_, "null process given");
+    }
+
+    std::vector<OneAssetOption::results> FdBlackScholesBatchEngine::calculate(
+        const std::vector<ext::shared_ptr<VanillaOption> >& options) const {
+
+        const Size n = options.size();
+        std::vector<OneAssetOption::results> results(n);
+        if (n == 0)
+            return results;
+
+        // 1. Options
+        std::vector<ext::shared_ptr<StrikedTypePayoff> > payoffs(n);
+        std::vector<Time> maturities(n);
+        std::vector<bool> american(n);
+        std::vector<Real> strikes(n);
+        for (Size k=0; k < n; ++k) {
+            QL_REQUIRE(options[k], "null option given");
+            payoffs[k] = ext::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                       options[k]->payoff());
+            QL_REQUIRE(payoffs[k], "non-striked payoff given");
+
+            const ext::shared_ptr<Exercise>& exercise = options[k]->exercise();
+            QL_REQUIRE(   exercise->type() == Exercise::American
+                       || exercise->type() == Exercise::European,
+                       "exercise type is not supported");
+            american[k] = (exercise->type() == Exercise::American);
+
+            maturities[k] = process_->time(exercise->lastDate());
+            QL_REQUIRE(maturities[k] > 0.0, "option #" << k << " expired");
+            strikes[k] = payoffs[k]->strike();
+        }
+        const Time maturity =
+            *std::max_element(maturities.begin(), maturities.end());
+
+        // 2. Mesher, concentrated around the distinct strikes, with
+        //    one line per option in the second direction
+        std::sort(strikes.begin(), strikes.end());
+        strikes.erase(std::unique(strikes.begin(), strikes.end()),
+                      strikes.end());
+
+        const ext::shared_ptr<Fdm1dMesher> boundaries =
+            ext::make_shared<FdmBlackScholesMultiStrikeMesher>(
+                xGrid_, process_, maturity, strikes);
+        const Real xMin = boundaries->locations().front();
+        const Real xMax = boundaries->locations().back();
+
+        std::vector<ext::tuple<Real, Real, bool> > cPoints;
+        for (Real strike : strikes) {
+            const Real x = std::log(strike);
+            if (x > xMin && x < xMax)
+                cPoints.emplace_back(x, 0.1, false);
+        }
+
+        const ext::shared_ptr<Fdm1dMesher> equityMesher = cPoints.empty()
+            ? boundaries
+            : ext::make_shared<Concentrating1dMesher>(xMin, xMax, xGrid_,
+                                                      cPoints);
+
+        std::vector<Real> lines(n);
+        for (Size k=0; k < n; ++k)
+            lines[k] = Real(k);
+
+        const ext::shared_ptr<FdmMesher> mesher =
+            ext::make_shared<FdmMesherComposite>(
+                equityMesher, ext::make_shared<Predefined1dMesher>(lines));
+
+        // 3. Payoffs at maturity (averaged over the cells, as in the
+        //    other engines) and exercise values
+        const ext::shared_ptr<FdmMesher> xMesher =
+            ext::make_shared<FdmMesherComposite>(equityMesher);
+        const ext::shared_ptr<FdmLinearOpLayout> layout = xMesher->layout();
+        const FdmLinearOpIterator endIter = layout->end();
+
+        Array payoffValues(mesher->layout()->size(), 0.0);
+        Array exerciseValues(mesher->layout()->size(), 0.0);
+        for (Size k=0; k < n; ++k) {
+            FdmLogInnerValue calculator(payoffs[k], xMesher, 0);
+            for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+                 ++iter) {
+                const Size i = k*xGrid_ + iter.index();
+                payoffValues[i] = calculator.avgInnerValue(iter, maturities[k]);
+                if (american[k])
+                    exerciseValues[i] = calculator.innerValue(iter,
+                                                              maturities[k]);
+            }
+        }
+
+        // 4. Step conditions
+        const Time thetaTime = 0.99 * std::min(1.0 / 365.0,
+            *std::min_element(maturities.begin(), maturities.end()));
+        const ext::shared_ptr<FdmSnapshotCondition> thetaCondition =
+            ext::make_shared<FdmSnapshotCondition>(thetaTime);
+
+        std::list<std::vector<Time> > stoppingTimes;
+        stoppingTimes.push_back(maturities);
+        stoppingTimes.emplace_back(1, thetaTime);
+
+        FdmStepConditionComposite::Conditions stepConditions;
+        stepConditions.push_back(ext::make_shared<FdmBatchExerciseCondition>(
+            maturities, american, payoffValues, exerciseValues, xGrid_));
+        stepConditions.push_back(thetaCondition);
+
+        const ext::shared_ptr<FdmStepConditionComposite> conditions =
+            ext::make_shared<FdmStepConditionComposite>(stoppingTimes,
+                                                        stepConditions);
+
+        // 5. Operator and rollback; the values of each option are set
+        //    by the step condition at its maturity
+        const Real strike = (volatilityStrike_ == Null<Real>())
+            ? process_->x0() : volatilityStrike_;
+
+        const ext::shared_ptr<FdmBlackScholesOp> op =
+            ext::make_shared<FdmBlackScholesOp>(
+                mesher, process_, strike,
+                localVol_, illegalLocalVolOverwrite_, 0);
+
+        FdmBackwardSolver solver(op, FdmBoundaryConditionSet(), conditions,
+                                 schemeDesc_);
+
+        // between consecutive maturities, the time step is the one
+        // of the shortest option alive, so that each option is
+        // rolled back with at least tGrid steps; the damping steps
+        // follow each maturity
+        std::vector<Time> times(maturities);
+        std::sort(times.begin(), times.end());
+        times.erase(std::unique(times.begin(), times.end()), times.end());
+
+        Array rhs(mesher->layout()->size(), 0.0);
+        for (Size j=times.size(); j > 0; --j) {
+            const Time from = times[j-1];
+            const Time to = (j > 1) ? times[j-2] : 0.0;
+            const Real steps = (from - to)/from*tGrid_;
+            solver.rollback(rhs, from, to,
+                            std::max(Size(1), Size(std::ceil(steps - 1e-8))),
+                            dampingSteps_);
+        }
+
+        // 6. Results, interpolated at the spot as in FdmBlackScholesSolver
+        const Real spot = process_->x0();
+        const Real x = std::log(spot);
+        const std::vector<Real>& locations = equityMesher->locations();
+        const Array& thetaValues = thetaCondition->getValues();
+
+        for (Size k=0; k < n; ++k) {
+            const Size first = k*xGrid_;
+            const MonotonicCubicNaturalSpline values(
+                locations.begin(), locations.end(), rhs.begin() + first);
+
+            results[k].reset();
+            results[k].value = values(x);
+            results[k].delta = values.derivative(x)/spot;
+            results[k].gamma = (values.secondDerivative(x)
+                                - values.derivative(x))/(spot*spot);
+            results[k].theta = (MonotonicCubicNaturalSpline(
+                                    locations.begin(), locations.end(),
+                                    thetaValues.begin() + first)(x)
+                                - results[k].value) / thetaTime;
+        }
+
+        return results;
+    }
+
+}
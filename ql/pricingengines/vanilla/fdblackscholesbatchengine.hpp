@@ -0,0 +1,96 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdblackscholesbatchengine.hpp
+    \brief Finite-Differences Black Scholes engine for sets of vanilla options
+*/
+
+#ifndef quantlib_fd_black_scholes_batch_engine_hpp
+#define quantlib_fd_black_scholes_batch_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class GeneralizedBlackScholesProcess;
+
+    //! Finite-Differences Black Scholes engine for sets of vanilla options
+
+    /*! Prices a set of European and American vanilla options on the
+        same process in a single backward induction, instead of one
+        per option as FdBlackScholesVanillaEngine does.
+
+        All options share a grid in ln(S), concentrated around their
+        strikes and covering the longest maturity, and a single
+        operator.  The values of the options are stored one after the
+        other, each option being a separate line of a two-dimensional
+        layout along which the operator doesn't act.  The values of
+        an option are zero until the rollback reaches its maturity,
+        where they are set to its payoff; from then on, the early
+        exercise of American options is applied to their values only.
+        Between consecutive maturities, the time step is the one of
+        the shortest option still alive, so that each option is
+        rolled back with at least the given number of time steps, and
+        the damping steps are performed after each maturity.
+
+        Unlike the other engines, this class is not set to the
+        options; it returns the results of all the given options at
+        once.
+
+        \warning Unless local volatility is used, the Black volatility
+                 of the process is read at a single strike for all
+                 the options (by default, the spot value).  The
+                 results reproduce the ones of separate engines only
+                 if the volatility doesn't depend on the strike.
+
+        \ingroup vanillaengines
+
+        \test the results are compared with the ones of
+              FdBlackScholesVanillaEngine and with Black pricing.
+    */
+    class FdBlackScholesBatchEngine {
+      public:
+        explicit FdBlackScholesBatchEngine(
+            ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+            Size tGrid = 100,
+            Size xGrid = 100,
+            Size dampingSteps = 0,
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
+            bool localVol = false,
+            Real illegalLocalVolOverwrite = -Null<Real>(),
+            Real volatilityStrike = Null<Real>());
+
+        /*! returns value, delta, gamma and theta of the given
+            options, in the same order.
+        */
+        std::vector<OneAssetOption::results> calculate(
+            const std::vector<ext::shared_ptr<VanillaOption> >& options)
+                                                                    const;
+      private:
+        const ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        const Size tGrid_, xGrid_, dampingSteps_;
+        const FdmSchemeDesc schemeDesc_;
+        const bool localVol_;
+        const Real illegalLocalVolOverwrite_;
+        const Real volatilityStrike_;
+    };
+
+}
+
+#endif
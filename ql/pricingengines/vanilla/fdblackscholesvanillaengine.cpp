@@ -75,6 +75,23 @@ namespace QuantLib {
         const Time maturity = process_->time(exerciseDate);
         const Date settlementDate = process_->riskFreeRate()->referenceDate();
 
+        // the solver kept for the same option only needs the
+        // current market data
+        if (solver_ != nullptr
+            && arguments_.payoff == solverArguments_.payoff
+            && arguments_.exercise == solverArguments_.exercise
+            && arguments_.cashFlow == solverArguments_.cashFlow
+            && settlementDate == solverReferenceDate_
+            && maturity == solverMaturity_) {
+            const Real spot = process_->x0();
+
+            results_.value = solver_->valueAt(spot);
+            results_.delta = solver_->deltaAt(spot);
+            results_.gamma = solver_->gammaAt(spot);
+            results_.theta = solver_->thetaAt(spot);
+            return;
+        }
+
         Real spotAdjustment = 0.0;
         DividendSchedule dividendSchedule = DividendSchedule();
 
@@ -170,6 +187,21 @@ namespace QuantLib {
         results_.delta = solver->deltaAt(spot);
         results_.gamma = solver->gammaAt(spot);
         results_.theta = solver->thetaAt(spot);
+
+        if (solverCaching_) {
+            solver_ = solver;
+            solverArguments_ = arguments_;
+            solverReferenceDate_ = settlementDate;
+            solverMaturity_ = maturity;
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::enableSolverCaching(bool enable) {
+        QL_REQUIRE(!enable || cashDividendModel_ == Spot,
+                   "solver caching is not available for the "
+                   "Escrowed cash dividend model");
+        solverCaching_ = enable;
+        solver_.reset();
     }
 
     MakeFdBlackScholesVanillaEngine::MakeFdBlackScholesVanillaEngine(
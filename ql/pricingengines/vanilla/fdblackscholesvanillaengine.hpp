@@ -40,6 +40,7 @@ namespace QuantLib {
               reproducing results available in web/literature
               and comparison with Black pricing.
     */
+    class FdmBlackScholesSolver;
     class FdmQuantoHelper;
     class GeneralizedBlackScholesProcess;
 
@@ -70,6 +71,24 @@ namespace QuantLib {
 
         void calculate() const override;
 
+        /*! When enabled, the mesher, the payoff values and the step
+            conditions built for an option are kept; the following
+            calculations for the same option, e.g., after a bump of
+            the market quotes, only rebuild the operator from the
+            current market data before rolling back.  They are built
+            again when the option, the evaluation date or the
+            maturity time change.
+
+            \warning The grid is the one built for the market data of
+                     the first calculation; in particular, it is not
+                     centered again when the spot moves.  This reduces
+                     the noise of bump-and-reval greeks, but the
+                     caching should be disabled and enabled again
+                     after large market moves.  It is not available
+                     for the Escrowed cash dividend model.
+        */
+        void enableSolverCaching(bool enable = true);
+
       private:
         const ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         const Size tGrid_, xGrid_, dampingSteps_;
@@ -78,6 +97,12 @@ namespace QuantLib {
         const Real illegalLocalVolOverwrite_;
         const ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
         const CashDividendModel cashDividendModel_;
+
+        bool solverCaching_ = false;
+        mutable ext::shared_ptr<FdmBlackScholesSolver> solver_;
+        mutable DividendVanillaOption::arguments solverArguments_;
+        mutable Date solverReferenceDate_;
+        mutable Time solverMaturity_ = Null<Time>();
     };
 
 
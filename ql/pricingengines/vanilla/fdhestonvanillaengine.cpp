@@ -162,12 +162,38 @@ namespace QuantLib {
         }
 
         const ext::shared_ptr<HestonProcess> process = model_->process();
+        const Date referenceDate = process->riskFreeRate()->referenceDate();
+        const Time maturity = process->time(arguments_.exercise->lastDate());
 
-        ext::shared_ptr<FdmHestonSolver> solver(new FdmHestonSolver(
+        ext::shared_ptr<FdmHestonSolver> solver;
+        if (solver_ != nullptr
+            && arguments_.payoff == solverArguments_.payoff
+            && arguments_.exercise == solverArguments_.exercise
+            && arguments_.cashFlow == solverArguments_.cashFlow
+            && referenceDate == solverReferenceDate_
+            && maturity == solverMaturity_) {
+            // the model creates a new process when its parameters
+            // change; relinking triggers the update of the operator
+            solverProcess_.linkTo(process);
+            solver = solver_;
+        } else if (solverCaching_) {
+            solverProcess_.linkTo(process);
+            solver = ext::make_shared<FdmHestonSolver>(
+                Handle<HestonProcess>(solverProcess_),
+                getSolverDesc(1.5), schemeDesc_,
+                Handle<FdmQuantoHelper>(quantoHelper_), leverageFct_,
+                mixingFactor_);
+            solver_ = solver;
+            solverArguments_ = arguments_;
+            solverReferenceDate_ = referenceDate;
+            solverMaturity_ = maturity;
+        } else {
+            solver = ext::shared_ptr<FdmHestonSolver>(new FdmHestonSolver(
                     Handle<HestonProcess>(process),
                     getSolverDesc(1.5), schemeDesc_,
                     Handle<FdmQuantoHelper>(quantoHelper_), leverageFct_,
                      mixingFactor_));
+        }
 
         const Real v0   = process->v0();
         const Real spot = process->s0()->value();
@@ -206,6 +232,12 @@ namespace QuantLib {
                                         const std::vector<Real>& strikes) {
         strikes_ = strikes;
         cachedArgs2results_.clear();
+        solver_.reset();
+    }
+
+    void FdHestonVanillaEngine::enableSolverCaching(bool enable) {
+        solverCaching_ = enable;
+        solver_.reset();
     }
 
 
@@ -43,6 +43,7 @@ namespace QuantLib {
               reproducing results available in web/literature
               and comparison with Black pricing.
     */
+    class FdmHestonSolver;
     class FdmQuantoHelper;
 
     class FdHestonVanillaEngine
@@ -79,6 +80,21 @@ namespace QuantLib {
         void update() override;
         void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
         
+        /*! When enabled, the mesher, the payoff values and the step
+            conditions built for an option are kept; the following
+            calculations for the same option, e.g., after a change
+            of the model parameters, only rebuild the operator from
+            the current process before rolling back.  They are built
+            again when the option, the evaluation date or the
+            maturity time change.
+
+            \warning The grid is the one built for the process of
+                     the first calculation; the caching should be
+                     disabled and enabled again after large changes
+                     of the spot or of the model parameters.
+        */
+        void enableSolverCaching(bool enable = true);
+
         // helper method for Heston like engines
         FdmSolverDesc getSolverDesc(Real equityScaleFactor) const;
 
@@ -93,6 +109,13 @@ namespace QuantLib {
         mutable std::vector<std::pair<DividendVanillaOption::arguments,
                                       DividendVanillaOption::results> >
                                                             cachedArgs2results_;
+
+        bool solverCaching_ = false;
+        mutable ext::shared_ptr<FdmHestonSolver> solver_;
+        mutable RelinkableHandle<HestonProcess> solverProcess_;
+        mutable DividendVanillaOption::arguments solverArguments_;
+        mutable Date solverReferenceDate_;
+        mutable Time solverMaturity_ = Null<Time>();
     };
 
     class MakeFdHestonVanillaEngine {
@@ -66,7 +66,8 @@ namespace QuantLib {
                         Size requiredSamples,
                         Real requiredTolerance,
                         Size maxSamples,
-                        BigNatural seed);
+                        BigNatural seed,
+                        Size threads = 1);
         // McSimulation implementation
         TimeGrid timeGrid() const override;
         ext::shared_ptr<path_generator_type> pathGenerator() const override {
@@ -79,6 +80,18 @@ namespace QuantLib {
                    new path_generator_type(process_, grid,
                                            generator, brownianBridge_));
         }
+        ext::shared_ptr<path_generator_type>
+        workerPathGenerator(Size worker) const override {
+
+            Size dimensions = process_->factors();
+            TimeGrid grid = this->timeGrid();
+            typename RNG::rsg_type generator =
+                detail::SequenceStreams<RNG>::make(
+                                    dimensions*(grid.size()-1), seed_, worker);
+            return ext::shared_ptr<path_generator_type>(
+                   new path_generator_type(process_, grid,
+                                           generator, brownianBridge_));
+        }
         result_type controlVariateValue() const override;
         // data members
         ext::shared_ptr<StochasticProcess> process_;
@@ -103,8 +116,10 @@ namespace QuantLib {
         Size requiredSamples,
         Real requiredTolerance,
         Size maxSamples,
-        BigNatural seed)
-    : McSimulation<MC, RNG, S>(antitheticVariate, controlVariate), process_(std::move(process)),
+        BigNatural seed,
+        Size threads)
+    : McSimulation<MC, RNG, S>(antitheticVariate, controlVariate, threads),
+      process_(std::move(process)),
       timeSteps_(timeSteps), timeStepsPerYear_(timeStepsPerYear), requiredSamples_(requiredSamples),
       maxSamples_(maxSamples), requiredTolerance_(requiredTolerance),
       brownianBridge_(brownianBridge), seed_(seed) {
@@ -146,6 +146,28 @@ namespace QuantLib {
                                  stdDeviation(t0, x0, dt) * dw);
     }
 
+    void GeneralizedBlackScholesProcess::evolveBatch(Time t0, const Real* x0,
+                                                     Time dt, const Real* dw,
+                                                     Real* x, Size n) const {
+        localVolatility(); // trigger update
+        if (isStrikeIndependent_ && !forceDiscretization_) {
+            // same as evolve(), with the path-independent terms
+            // calculated only once
+            Real var = variance(t0, 0.0, dt);
+            Real drift = (riskFreeRate_->forwardRate(t0, t0 + dt, Continuous,
+                                                     NoFrequency, true) -
+                          dividendYield_->forwardRate(t0, t0 + dt, Continuous,
+                                                      NoFrequency, true)) *
+                             dt -
+                         0.5 * var;
+            Real stdDev = std::sqrt(var);
+            for (Size k=0; k<n; ++k)
+                x[k] = x0[k] * std::exp(stdDev * dw[k] + drift);
+        } else {
+            StochasticProcess1D::evolveBatch(t0, x0, dt, dw, x, n);
+        }
+    }
+
     Time GeneralizedBlackScholesProcess::time(const Date& d) const {
         return riskFreeRate_->dayCounter().yearFraction(
                                            riskFreeRate_->referenceDate(), d);
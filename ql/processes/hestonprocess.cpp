@@ -555,6 +555,59 @@ namespace QuantLib {
         return retVal;
     }
 
+    void HestonProcess::evolveBatch(Time t0, const Real* x0, Time dt,
+                                    const Real* dw, Real* x, Size n) const {
+        if (discretization_ != PartialTruncation
+            && discretization_ != FullTruncation
+            && discretization_ != Reflection) {
+            StochasticProcess::evolveBatch(t0, x0, dt, dw, x, n);
+            return;
+        }
+
+        // same as evolve(); see there for details
+        const Real sdt = std::sqrt(dt);
+        const Real sqrhov = std::sqrt(1.0 - rho_*rho_);
+        const Real rate =
+              riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
+            - dividendYield_->forwardRate(t0, t0+dt, Continuous);
+
+        const Real *s0 = x0, *v0 = x0+n, *dw0 = dw, *dw1 = dw+n;
+        Real *s = x, *v = x+n;
+        switch (discretization_) {
+          case PartialTruncation:
+            for (Size k=0; k<n; ++k) {
+                const Real vol = (v0[k] > 0.0) ? std::sqrt(v0[k]) : 0.0;
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rate - 0.5 * vol * vol;
+                const Real nu = kappa_*(theta_ - v0[k]);
+                s[k] = s0[k] * std::exp(mu*dt+vol*dw0[k]*sdt);
+                v[k] = v0[k] + nu*dt + vol2*sdt*(rho_*dw0[k] + sqrhov*dw1[k]);
+            }
+            break;
+          case FullTruncation:
+            for (Size k=0; k<n; ++k) {
+                const Real vol = (v0[k] > 0.0) ? std::sqrt(v0[k]) : 0.0;
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rate - 0.5 * vol * vol;
+                const Real nu = kappa_*(theta_ - vol*vol);
+                s[k] = s0[k] * std::exp(mu*dt+vol*dw0[k]*sdt);
+                v[k] = v0[k] + nu*dt + vol2*sdt*(rho_*dw0[k] + sqrhov*dw1[k]);
+            }
+            break;
+          default:
+            for (Size k=0; k<n; ++k) {
+                const Real vol = std::sqrt(std::fabs(v0[k]));
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rate - 0.5 * vol*vol;
+                const Real nu = kappa_*(theta_ - vol*vol);
+                s[k] = s0[k]*std::exp(mu*dt+vol*dw0[k]*sdt);
+                v[k] = vol*vol
+                       +nu*dt + vol2*sdt*(rho_*dw0[k] + sqrhov*dw1[k]);
+            }
+            break;
+        }
+    }
+
     const Handle<Quote>& HestonProcess::s0() const {
         return s0_;
     }
@@ -73,6 +73,12 @@ namespace QuantLib {
         Disposable<Matrix> diffusion(Time t, const Array& x) const override;
         Disposable<Array> apply(const Array& x0, const Array& dx) const override;
         Disposable<Array> evolve(Time t0, const Array& x0, Time dt, const Array& dw) const override;
+        /*! The truncation and reflection schemes are evaluated
+            across paths, with the term-structure calls made once per
+            batch; the other schemes evolve each path separately.
+        */
+        void evolveBatch(Time t0, const Real* x0, Time dt,
+                         const Real* dw, Real* x, Size n) const override;
 
         Real v0()    const { return v0_; }
         Real rho()   const { return rho_; }
@@ -21,6 +21,7 @@
 #include <ql/processes/stochasticprocessarray.hpp>
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <ql/math/functional.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -108,6 +109,33 @@ namespace QuantLib {
         return tmp;
     }
 
+    void StochasticProcessArray::evolveBatch(Time t0, const Real* x0,
+                                             Time dt, const Real* dw,
+                                             Real* x, Size n) const {
+        std::vector<Real> workspace(size()*n);
+        evolveBatch(t0, x0, dt, dw, x, n, &workspace[0]);
+    }
+
+    void StochasticProcessArray::evolveBatch(Time t0, const Real* x0,
+                                             Time dt, const Real* dw,
+                                             Real* x, Size n,
+                                             Real* workspace) const {
+        // correlate the increments of all paths at once, then let
+        // each process evolve its own block
+        const Size m = size(), f = factors();
+        for (Size i=0; i<m; ++i) {
+            Real* dzi = workspace + i*n;
+            std::fill(dzi, dzi+n, 0.0);
+            for (Size j=0; j<f; ++j) {
+                const Real c = sqrtCorrelation_[i][j];
+                const Real* dwj = dw+j*n;
+                for (Size k=0; k<n; ++k)
+                    dzi[k] += c*dwj[k];
+            }
+            processes_[i]->evolveBatch(t0, x0+i*n, dt, dzi, x+i*n, n);
+        }
+    }
+
     Disposable<Array> StochasticProcessArray::apply(const Array& x0,
                                                     const Array& dx) const {
         Array tmp(size());
@@ -49,6 +49,15 @@ namespace QuantLib {
 
         Disposable<Array> apply(const Array& x0, const Array& dx) const override;
         Disposable<Array> evolve(Time t0, const Array& x0, Time dt, const Array& dw) const override;
+        void evolveBatch(Time t0, const Real* x0, Time dt,
+                         const Real* dw, Real* x, Size n) const override;
+        /*! same as above, but the correlated increments are stored
+            in the given workspace of at least size()*n elements
+            instead of a buffer allocated at each call.
+        */
+        void evolveBatch(Time t0, const Real* x0, Time dt,
+                         const Real* dw, Real* x, Size n,
+                         Real* workspace) const;
 
         Time time(const Date&) const override;
         // inspectors
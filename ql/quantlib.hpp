@@ -36,6 +36,7 @@
 #include <ql/shared_ptr.hpp>
 #include <ql/stochasticprocess.hpp>
 #include <ql/termstructure.hpp>
+#include <ql/threadlocalsettings.hpp>
 #include <ql/timegrid.hpp>
 #include <ql/timeseries.hpp>
 #include <ql/tuple.hpp>
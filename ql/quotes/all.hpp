@@ -9,5 +9,6 @@
 #include <ql/quotes/futuresconvadjustmentquote.hpp>
 #include <ql/quotes/impliedstddevquote.hpp>
 #include <ql/quotes/lastfixingquote.hpp>
+#include <ql/quotes/marketdatatransaction.hpp>
 #include <ql/quotes/simplequote.hpp>
 
@@ -0,0 +1,74 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/quotes/marketdatatransaction.hpp>
+
+namespace QuantLib {
+
+    void MarketDataTransaction::setValue(
+                           const ext::shared_ptr<SimpleQuote>& quote,
+                           Real value) {
+        QL_REQUIRE(quote, "null quote given");
+        auto inserted = index_.insert(std::make_pair(quote.get(),
+                                                     quotes_.size()));
+        if (inserted.second) {
+            quotes_.push_back(quote);
+            values_.push_back(value);
+        } else {
+            values_[inserted.first->second] = value;
+        }
+    }
+
+    void MarketDataTransaction::clear() {
+        quotes_.clear();
+        values_.clear();
+        index_.clear();
+    }
+
+    ObserverGraph MarketDataTransaction::commit(bool recalculate,
+                                                Size threads) {
+        std::vector<ext::shared_ptr<Observable> > changed;
+        changed.reserve(quotes_.size());
+
+        ObservableSettings& settings = ObservableSettings::instance();
+        const bool enabled = settings.updatesEnabled();
+        const bool deferred = settings.updatesDeferred();
+        settings.disableUpdates(false);
+        for (Size i=0; i<quotes_.size(); ++i) {
+            if (quotes_[i]->setValue(values_[i]) != 0.0)
+                changed.push_back(quotes_[i]);
+        }
+        if (enabled)
+            settings.enableUpdates();
+        else
+            settings.disableUpdates(deferred);
+
+        ObserverGraph graph(changed);
+        try {
+            graph.update();
+        } catch (...) {
+            clear();
+            throw;
+        }
+        clear();
+
+        if (recalculate)
+            graph.recalculate(threads);
+        return graph;
+    }
+
+}
@@ -0,0 +1,86 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file marketdatatransaction.hpp
+    \brief batch of quote updates notified at once
+*/
+
+#ifndef quantlib_market_data_transaction_hpp
+#define quantlib_market_data_transaction_hpp
+
+#include <ql/patterns/observergraph.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <boost/unordered_map.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! batch of quote updates notified at once
+    /*! Setting a number of quotes one by one sends the notifications
+        of each of them through the whole dependency tree.  A
+        transaction collects the new values instead, and on commit
+        sets them all while notifications are disabled; it then
+        builds the graph of the observers of the changed quotes and
+        updates each of them exactly once, in topological order (see
+        ObserverGraph).  Optionally, the lazy objects in the graph
+        are also recalculated, in parallel by dependency level if
+        more than one thread is given and the library is compiled
+        with OpenMP.
+
+        Unlike ObservableSettings::disableUpdates(true), which
+        collects the direct observers of the notifying objects and
+        lets the notifications cascade again when updates are
+        enabled, no observer is reached more than once.
+
+        \warning Notifications are disabled globally while the
+                 transaction is committed; in the thread-safe
+                 observer pattern, notifications sent from other
+                 threads in the meantime are lost.
+    */
+    class MarketDataTransaction {
+      public:
+        //! \name Modifiers
+        //@{
+        /*! stages a new value for the given quote; if the quote was
+            already staged, the last value wins.
+        */
+        void setValue(const ext::shared_ptr<SimpleQuote>& quote, Real value);
+        //! discards the staged values
+        void clear();
+        /*! sets the staged values, notifies the observers of the
+            quotes that actually changed, and clears the transaction.
+            The returned graph contains the notified observers; see
+            ObserverGraph for the conditions under which it can be
+            used afterwards.
+        */
+        ObserverGraph commit(bool recalculate = false, Size threads = 1);
+        //@}
+        //! \name Inspectors
+        //@{
+        Size size() const { return quotes_.size(); }
+        bool empty() const { return quotes_.empty(); }
+        //@}
+      private:
+        std::vector<ext::shared_ptr<SimpleQuote> > quotes_;
+        std::vector<Real> values_;
+        boost::unordered_map<SimpleQuote*, Size> index_;
+    };
+
+}
+
+
+#endif
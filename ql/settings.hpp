@@ -33,9 +33,15 @@
 
 namespace QuantLib {
 
+    class ThreadLocalSettings;
+
     //! global repository for run-time library settings
+    /*! \note a thread can own its settings by means of the
+              ThreadLocalSettings class.
+    */
     class Settings : public Singleton<Settings> {
         friend class Singleton<Settings>;
+        friend class ThreadLocalSettings;
       private:
         Settings();
         class DateProxy : public ObservableValue<Date> {
@@ -62,6 +62,22 @@ namespace QuantLib {
         return x0 + dx;
     }
 
+    void StochasticProcess::evolveBatch(Time t0, const Real* x0, Time dt,
+                                        const Real* dw, Real* x,
+                                        Size n) const {
+        const Size m = size(), f = factors();
+        Array y0(m), dwk(f);
+        for (Size k=0; k<n; ++k) {
+            for (Size i=0; i<m; ++i)
+                y0[i] = x0[i*n+k];
+            for (Size j=0; j<f; ++j)
+                dwk[j] = dw[j*n+k];
+            Array y = evolve(t0, y0, dt, dwk);
+            for (Size i=0; i<m; ++i)
+                x[i*n+k] = y[i];
+        }
+    }
+
     Time StochasticProcess::time(const Date& ) const {
         QL_FAIL("date/time conversion not supported");
     }
@@ -97,4 +113,11 @@ namespace QuantLib {
         return x0 + dx;
     }
 
+    void StochasticProcess1D::evolveBatch(Time t0, const Real* x0, Time dt,
+                                          const Real* dw, Real* x,
+                                          Size n) const {
+        for (Size k=0; k<n; ++k)
+            x[k] = evolve(t0, x0[k], dt, dw[k]);
+    }
+
 }
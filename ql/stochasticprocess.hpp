@@ -128,6 +128,20 @@ namespace QuantLib {
         */
         virtual Disposable<Array> apply(const Array& x0,
                                         const Array& dx) const;
+        /*! evolves a batch of \f$ n \f$ paths over a time interval
+            \f$ \Delta t \f$.  The state variables and the Brownian
+            increments are stored by component, i.e., <tt>x0[i*n+k]</tt>
+            is the i-th state variable of the k-th path, and
+            likewise for <tt>dw</tt> (by factor) and <tt>x</tt>.  The
+            results must be the same as those of evolve() for each
+            path; by default, it calls evolve() path by path, but
+            derived classes can override it with kernels working
+            across paths.
+
+            \pre the output range must not overlap the input ones.
+        */
+        virtual void evolveBatch(Time t0, const Real* x0, Time dt,
+                                 const Real* dw, Real* x, Size n) const;
         //@}
 
         //! \name utilities
@@ -220,6 +234,11 @@ namespace QuantLib {
             returns \f$ x + \Delta x \f$.
         */
         virtual Real apply(Real x0, Real dx) const;
+        /*! evolves a batch of \f$ n \f$ paths; by default, it calls
+            evolve() for each of them.
+        */
+        void evolveBatch(Time t0, const Real* x0, Time dt,
+                         const Real* dw, Real* x, Size n) const override;
         //@}
       protected:
         StochasticProcess1D() = default;
@@ -42,7 +42,14 @@ template <class Curve> class GlobalBootstrap {
     typedef typename Curve::interpolator_type Interpolator; // Linear, LogLinear, ...
 
   public:
-    GlobalBootstrap(Real accuracy = Null<Real>());
+    /*! If sparseJacobian is true, the Jacobian used by the optimizer is calculated by finite differences exploiting
+      the dependency structure of the helpers on the curve nodes.  The structure is detected by a full calculation at
+      the start of each bootstrap, so that it follows changes in the helpers and their market data; afterwards, nodes
+      not affecting any common helper are bumped together, and only the helpers affected by the bumped nodes are
+      repriced.  This is especially effective with short-dated helpers such as deposits, FRAs, futures or
+      meeting-date OIS.
+    */
+    GlobalBootstrap(Real accuracy = Null<Real>(), bool sparseJacobian = false);
     /*! The set of (alive) additional dates is added to the interpolation grid. The set of additional dates must only
       depend on the current global evaluation date.  The additionalErrors functor must yield at least as many values
       such that
@@ -62,7 +69,8 @@ template <class Curve> class GlobalBootstrap {
     GlobalBootstrap(std::vector<ext::shared_ptr<typename Traits::helper> > additionalHelpers,
                     ext::function<std::vector<Date>()> additionalDates,
                     ext::function<Array()> additionalErrors,
-                    Real accuracy = Null<Real>());
+                    Real accuracy = Null<Real>(),
+                    bool sparseJacobian = false);
     void setup(Curve *ts);
     void calculate() const;
 
@@ -70,6 +78,11 @@ template <class Curve> class GlobalBootstrap {
     void initialize() const;
     Curve *ts_;
     Real accuracy_;
+    bool sparseJacobian_;
+    // for each node, the error terms it affects; nodes are bumped
+    // together in groups not sharing any error term
+    mutable std::vector<std::vector<Size> > affectedErrors_;
+    mutable std::vector<std::vector<Size> > nodeGroups_;
     mutable std::vector<ext::shared_ptr<typename Traits::helper> > additionalHelpers_;
     ext::function<std::vector<Date>()> additionalDates_;
     ext::function<Array()> additionalErrors_;
@@ -83,16 +96,19 @@ template <class Curve> class GlobalBootstrap {
 // template definitions
 
 template <class Curve>
-GlobalBootstrap<Curve>::GlobalBootstrap(Real accuracy) : ts_(0), accuracy_(accuracy) {}
+GlobalBootstrap<Curve>::GlobalBootstrap(Real accuracy, bool sparseJacobian)
+: ts_(0), accuracy_(accuracy), sparseJacobian_(sparseJacobian) {}
 
 template <class Curve>
 GlobalBootstrap<Curve>::GlobalBootstrap(
     std::vector<ext::shared_ptr<typename Traits::helper> > additionalHelpers,
     ext::function<std::vector<Date>()> additionalDates,
     ext::function<Array()> additionalErrors,
-    Real accuracy)
-: ts_(nullptr), accuracy_(accuracy), additionalHelpers_(std::move(additionalHelpers)),
-  additionalDates_(std::move(additionalDates)), additionalErrors_(std::move(additionalErrors)) {}
+    Real accuracy,
+    bool sparseJacobian)
+: ts_(nullptr), accuracy_(accuracy), sparseJacobian_(sparseJacobian),
+  additionalHelpers_(std::move(additionalHelpers)), additionalDates_(std::move(additionalDates)),
+  additionalErrors_(std::move(additionalErrors)) {}
 
 template <class Curve> void GlobalBootstrap<Curve>::setup(Curve *ts) {
     ts_ = ts;
@@ -196,6 +212,11 @@ template <class Curve> void GlobalBootstrap<Curve>::calculate() const {
     if (!initialized_ || ts_->moving_)
         initialize();
 
+    // the dependency structure of the helpers on the nodes is detected
+    // again by the first Jacobian calculation of each bootstrap
+    affectedErrors_.clear();
+    nodeGroups_.clear();
+
     // setup helpers
     for (Size j = 0; j < numberHelpers_; ++j) {
         const ext::shared_ptr<typename Traits::helper> &helper = ts_->instruments_[firstHelper_ + j];
@@ -222,7 +243,7 @@ template <class Curve> void GlobalBootstrap<Curve>::calculate() const {
 
     // setup optimizer and EndCriteria
     Real optEps = accuracy;
-    LevenbergMarquardt optimizer(optEps, optEps, optEps); // FIXME hardcoded tolerances
+    LevenbergMarquardt optimizer(optEps, optEps, optEps, sparseJacobian_); // FIXME hardcoded tolerances
     EndCriteria ec(1000, 10, optEps, optEps, optEps);      // FIXME hardcoded values here as well
 
     // setup interpolation
@@ -248,10 +269,12 @@ template <class Curve> void GlobalBootstrap<Curve>::calculate() const {
                        ext::function<Array()> additionalErrors,
                        Curve* ts,
                        std::vector<Real> lowerBounds,
-                       std::vector<Real> upperBounds)
+                       std::vector<Real> upperBounds,
+                       const GlobalBootstrap* bootstrap)
         : firstHelper_(firstHelper), numberHelpers_(numberHelpers),
           additionalErrors_(std::move(additionalErrors)), ts_(ts),
-          lowerBounds_(std::move(lowerBounds)), upperBounds_(std::move(upperBounds)) {}
+          lowerBounds_(std::move(lowerBounds)), upperBounds_(std::move(upperBounds)),
+          bootstrap_(bootstrap) {}
 
         Real transformDirect(const Real x, const Size i) const {
             return (std::atan(x) + M_PI_2) / M_PI * (upperBounds_[i] - lowerBounds_[i]) + lowerBounds_[i];
@@ -268,14 +291,10 @@ template <class Curve> void GlobalBootstrap<Curve>::calculate() const {
         }
 
         Disposable<Array> values(const Array& x) const override {
-            for (Size i = 0; i < x.size(); ++i) {
-                Traits::updateGuess(ts_->data_, transformDirect(x[i], i), i + 1);
-            }
-            ts_->interpolation_.update();
+            setCurve(x);
             std::vector<Real> result(numberHelpers_);
             for (Size i = 0; i < numberHelpers_; ++i) {
-                result[i] = ts_->instruments_[firstHelper_ + i]->quote()->value() -
-                            ts_->instruments_[firstHelper_ + i]->impliedQuote();
+                result[i] = helperError(i);
             }
             if (!(additionalErrors_ == QL_NULL_FUNCTION)) {
                 Array tmp = additionalErrors_();
@@ -288,13 +307,101 @@ template <class Curve> void GlobalBootstrap<Curve>::calculate() const {
             return asArray;
         }
 
+        // forward differences, only used if sparseJacobian is true
+        void jacobian(Matrix& jac, const Array& x) const override {
+            std::vector<std::vector<Size> >& affected = bootstrap_->affectedErrors_;
+            std::vector<std::vector<Size> >& groups = bootstrap_->nodeGroups_;
+            const Array base = values(x);
+            const Size m = base.size(), n = x.size();
+            jac = Matrix(m, n, 0.0);
+            Array bumped = x;
+            std::vector<Real> h(n);
+            for (Size j = 0; j < n; ++j)
+                h[j] = 1.0e-6 * std::max(1.0, std::fabs(x[j]));
+
+            if (affected.size() != n) {
+                // full calculation, also detecting the dependencies
+                affected.assign(n, std::vector<Size>());
+                for (Size j = 0; j < n; ++j) {
+                    bumped[j] = x[j] + h[j];
+                    Array v = values(bumped);
+                    bumped[j] = x[j];
+                    for (Size i = 0; i < m; ++i) {
+                        if (v[i] != base[i]) {
+                            affected[j].push_back(i);
+                            jac[i][j] = (v[i] - base[i]) / h[j];
+                        }
+                    }
+                }
+                // greedy grouping of the nodes
+                groups.clear();
+                std::vector<std::vector<bool> > used;
+                for (Size j = 0; j < n; ++j) {
+                    Size g = 0;
+                    for (; g < groups.size(); ++g) {
+                        bool disjoint = true;
+                        for (Size i : affected[j])
+                            disjoint = disjoint && !used[g][i];
+                        if (disjoint)
+                            break;
+                    }
+                    if (g == groups.size()) {
+                        groups.emplace_back();
+                        used.emplace_back(m, false);
+                    }
+                    groups[g].push_back(j);
+                    for (Size i : affected[j])
+                        used[g][i] = true;
+                }
+            } else {
+                std::vector<Real> v(m);
+                for (const auto& group : groups) {
+                    for (Size j : group)
+                        bumped[j] = x[j] + h[j];
+                    setCurve(bumped);
+                    bool additional = false;
+                    for (Size j : group) {
+                        for (Size i : affected[j]) {
+                            if (i < numberHelpers_)
+                                v[i] = helperError(i);
+                            else
+                                additional = true;
+                        }
+                    }
+                    if (additional) {
+                        Array tmp = additionalErrors_();
+                        std::copy(tmp.begin(), tmp.end(), v.begin() + numberHelpers_);
+                    }
+                    for (Size j : group) {
+                        bumped[j] = x[j];
+                        for (Size i : affected[j])
+                            jac[i][j] = (v[i] - base[i]) / h[j];
+                    }
+                }
+            }
+            setCurve(x);
+        }
+
       private:
+        void setCurve(const Array& x) const {
+            for (Size i = 0; i < x.size(); ++i) {
+                Traits::updateGuess(ts_->data_, transformDirect(x[i], i), i + 1);
+            }
+            ts_->interpolation_.update();
+        }
+
+        Real helperError(Size i) const {
+            return ts_->instruments_[firstHelper_ + i]->quote()->value() -
+                   ts_->instruments_[firstHelper_ + i]->impliedQuote();
+        }
+
         Size firstHelper_, numberHelpers_;
         ext::function<Array()> additionalErrors_;
         Curve *ts_;
         const std::vector<Real> lowerBounds_, upperBounds_;
+        const GlobalBootstrap* bootstrap_;
     };
-    TargetFunction cost(firstHelper_, numberHelpers_, additionalErrors_, ts_, lowerBounds, upperBounds);
+    TargetFunction cost(firstHelper_, numberHelpers_, additionalErrors_, ts_, lowerBounds, upperBounds, this);
 
     // setup guess
     Array guess(numberHelpers_ + numberAdditionalDates_);
@@ -30,6 +30,7 @@
 #include <ql/termstructures/bootstraphelper.hpp>
 #include <ql/termstructures/bootstraperror.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/math/solvers1d/finitedifferencenewtonsafe.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -91,6 +92,16 @@ namespace detail {
                                   result.
             \param dontThrowSteps If \p dontThrow is \c true, this gives the number of steps to use when searching
                                   for a fallback curve pillar value that gives the minimum bootstrap helper error.
+            \param incremental    If set to \c true, a new bootstrap only solves again the pillars from the first
+                                  one whose helper quote changed, using the previous solution as a guess.  This
+                                  is only possible when the interpolation is local and each pillar is at the
+                                  last relevant date of its helper; otherwise, all the pillars are solved again,
+                                  still starting from the previous solution.  All the pillars are also solved
+                                  again if other market data used by the helpers (e.g., an exogenous discount
+                                  curve) changed; this is detected by checking that the implied quotes of the
+                                  earlier helpers are the same as at the end of the previous bootstrap.
+            \param jacobian       If set to \c true, the sensitivities of the curve data to the helper quotes are
+                                  calculated after each bootstrap; see jacobian().
         */
         IterativeBootstrap(Real accuracy = Null<Real>(),
                            Real minValue = Null<Real>(),
@@ -99,11 +110,20 @@ namespace detail {
                            Real maxFactor = 2.0,
                            Real minFactor = 2.0,
                            bool dontThrow = false,
-                           Size dontThrowSteps = 10);
+                           Size dontThrowSteps = 10,
+                           bool incremental = false,
+                           bool jacobian = false);
         void setup(Curve* ts);
         void calculate() const;
+        /*! Sensitivities of the curve data to the helper quotes, calculated by finite differences on the
+            bootstrapped curve.  The element \f$ (i,j) \f$ is the derivative of the curve data at the
+            \f$ (i+1) \f$-th node (the first node being fixed by the traits) with respect to the quote of the
+            \f$ (j+1) \f$-th alive helper, in pillar order.
+        */
+        const Matrix& jacobian() const;
       private:
         void initialize() const;
+        void calculateJacobian(Size firstPillar) const;
         Real accuracy_;
         Real minValue_, maxValue_;
         Size maxAttempts_;
@@ -111,14 +131,18 @@ namespace detail {
         Real minFactor_;
         bool dontThrow_;
         Size dontThrowSteps_;
+        bool incremental_, calculateJacobian_;
         Curve* ts_;
         Size n_;
         Brent firstSolver_;
         FiniteDifferenceNewtonSafe solver_;
         mutable bool initialized_ = false, validCurve_ = false, loopRequired_;
+        mutable bool triangularJacobian_ = false;
         mutable Size firstAliveHelper_, alive_;
-        mutable std::vector<Real> previousData_;
+        mutable std::vector<Real> previousData_, previousQuotes_, previousImpliedQuotes_;
         mutable std::vector<ext::shared_ptr<BootstrapError<Curve> > > errors_;
+        // derivatives of the implied quotes with respect to the data
+        mutable Matrix quoteDerivatives_, jacobian_;
     };
 
 
@@ -132,10 +156,13 @@ namespace detail {
                                                   Real maxFactor,
                                                   Real minFactor,
                                                   bool dontThrow,
-                                                  Size dontThrowSteps)
+                                                  Size dontThrowSteps,
+                                                  bool incremental,
+                                                  bool jacobian)
     : accuracy_(accuracy), minValue_(minValue), maxValue_(maxValue), maxAttempts_(maxAttempts),
       maxFactor_(maxFactor), minFactor_(minFactor), dontThrow_(dontThrow),
-      dontThrowSteps_(dontThrowSteps), ts_(nullptr), loopRequired_(Interpolator::global) {
+      dontThrowSteps_(dontThrowSteps), incremental_(incremental), calculateJacobian_(jacobian),
+      ts_(nullptr), loopRequired_(Interpolator::global) {
         QL_REQUIRE(maxFactor_ >= 1.0, "Expected that maxFactor would be at least 1.0 but got " << maxFactor_);
         QL_REQUIRE(minFactor_ >= 1.0, "Expected that minFactor would be at least 1.0 but got " << minFactor_);
     }
@@ -181,6 +208,9 @@ namespace detail {
         times[0] = ts_->timeFromReference(dates[0]);
 
         Date latestRelevantDate, maxDate = firstDate;
+        // the helpers might have moved; check again if the
+        // convergence loop is required
+        loopRequired_ = Interpolator::global;
         // pillar counter: i
         // helper counter: j
         for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
@@ -222,6 +252,8 @@ namespace detail {
             previousData_.resize(alive_+1);
             validCurve_ = false;
         }
+        // pillars might have moved; the next bootstrap must be complete
+        previousQuotes_.clear();
         initialized_ = true;
     }
 
@@ -260,6 +292,30 @@ namespace detail {
         // there might be a valid curve state to use as guess
         bool validData = validCurve_;
 
+        // in incremental mode, the pillars before the first changed
+        // quote are kept; if no quote changed, something else did
+        // and all the pillars are solved again
+        Size firstPillar = 1;
+        if (incremental_ && validCurve_ && !loopRequired_ &&
+            previousQuotes_.size() == alive_+1) {
+            for (Size i=1; i<=alive_; ++i) {
+                if (errors_[i]->helper()->quote()->value() != previousQuotes_[i]) {
+                    firstPillar = i;
+                    break;
+                }
+            }
+            // other market data used by the earlier helpers might have
+            // changed together with the quotes; if so, their implied
+            // quotes on the unchanged curve differ from the previous
+            // ones and all the pillars are solved again
+            for (Size i=1; i<firstPillar; ++i) {
+                if (errors_[i]->helper()->impliedQuote() != previousImpliedQuotes_[i]) {
+                    firstPillar = 1;
+                    break;
+                }
+            }
+        }
+
         for (Size iteration=0; ; ++iteration) {
             previousData_ = ts_->data_;
 
@@ -268,7 +324,7 @@ namespace detail {
             std::vector<Real> maxValues(alive_+1, Null<Real>());
             std::vector<Size> attempts(alive_+1, 1);
 
-            for (Size i=1; i<=alive_; ++i) { // pillar loop
+            for (Size i=firstPillar; i<=alive_; ++i) { // pillar loop
 
                 // shorter aliases for readability and to avoid duplication
                 Real& min = minValues[i];
@@ -383,6 +439,68 @@ namespace detail {
             validData = true;
         }
         validCurve_ = true;
+
+        if (incremental_) {
+            previousQuotes_.resize(alive_+1);
+            previousImpliedQuotes_.resize(alive_+1);
+            for (Size i=1; i<=alive_; ++i) {
+                previousQuotes_[i] = errors_[i]->helper()->quote()->value();
+                // the earlier ones were checked above
+                if (i >= firstPillar)
+                    previousImpliedQuotes_[i] = errors_[i]->helper()->impliedQuote();
+            }
+        }
+        if (calculateJacobian_)
+            calculateJacobian(firstPillar);
+    }
+
+    template <class Curve>
+    void IterativeBootstrap<Curve>::calculateJacobian(Size firstPillar) const {
+        // with a local interpolation and no convergence loop, the
+        // implied quote of the i-th helper only depends on the data
+        // up to the i-th node, and only the rows from the first
+        // pillar solved again have changed
+        const bool triangular = !loopRequired_;
+        // when switching to the triangular case, the upper triangle
+        // of the previous derivatives must be cleared as well
+        if (quoteDerivatives_.rows() != alive_ ||
+            (triangular && !triangularJacobian_)) {
+            quoteDerivatives_ = Matrix(alive_, alive_, 0.0);
+            firstPillar = 1;
+        }
+        if (!triangular)
+            firstPillar = 1;
+        triangularJacobian_ = triangular;
+
+        std::vector<Real>& data = ts_->data_;
+        for (Size j=1; j<=alive_; ++j) {
+            const Size first = triangular ? std::max(j, firstPillar) : 1;
+            if (first > alive_)
+                continue;
+            const Real x = data[j];
+            const Real h = 1.0e-6 * std::max(1.0, std::fabs(x));
+            data[j] = x + h;
+            ts_->interpolation_.update();
+            for (Size i=first; i<=alive_; ++i)
+                quoteDerivatives_[i-1][j-1] = errors_[i]->helper()->impliedQuote();
+            data[j] = x - h;
+            ts_->interpolation_.update();
+            for (Size i=first; i<=alive_; ++i)
+                quoteDerivatives_[i-1][j-1] =
+                    (quoteDerivatives_[i-1][j-1] - errors_[i]->helper()->impliedQuote()) / (2.0*h);
+            data[j] = x;
+        }
+        ts_->interpolation_.update();
+
+        // the bootstrap sets the implied quotes to the market ones
+        jacobian_ = inverse(quoteDerivatives_);
+    }
+
+    template <class Curve>
+    const Matrix& IterativeBootstrap<Curve>::jacobian() const {
+        QL_REQUIRE(calculateJacobian_, "jacobian not required for the bootstrap");
+        QL_REQUIRE(validCurve_, "curve not bootstrapped yet");
+        return jacobian_;
     }
 
 }
@@ -106,6 +106,9 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const override;
+        void discountsImpl(const Time* t,
+                           DiscountFactor* d,
+                           Size n) const override;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -179,6 +182,17 @@ namespace QuantLib {
         return dMax * std::exp(- instFwdMax * (t-tMax));
     }
 
+    template <class T>
+    void InterpolatedDiscountCurve<T>::discountsImpl(const Time* t,
+                                                     DiscountFactor* d,
+                                                     Size n) const {
+        this->interpolation_.values(t, d, n, true);
+        for (Size i=0; i<n; ++i) {
+            if (t[i] > this->times_.back())
+                d[i] = InterpolatedDiscountCurve<T>::discountImpl(t[i]);
+        }
+    }
+
     template <class T>
     InterpolatedDiscountCurve<T>::InterpolatedDiscountCurve(
                                     const DayCounter& dayCounter,
@@ -108,6 +108,12 @@ namespace QuantLib {
         Rate forwardImpl(Time t) const override;
         Rate zeroYieldImpl(Time t) const override;
         //@}
+        //! \name YieldTermStructure implementation
+        //@{
+        void discountsImpl(const Time* t,
+                           DiscountFactor* d,
+                           Size n) const override;
+        //@}
         mutable std::vector<Date> dates_;
       private:
         void initialize();
@@ -190,6 +196,21 @@ namespace QuantLib {
         return integral/t;
     }
 
+    template <class T>
+    void InterpolatedForwardCurve<T>::discountsImpl(const Time* t,
+                                                    DiscountFactor* d,
+                                                    Size n) const {
+        // the primitive of the interpolation is integrated piecewise;
+        // sorted times are located in constant time on average
+        for (Size i=0; i<n; ++i) {
+            if (t[i] == 0.0)
+                d[i] = 1.0;
+            else
+                d[i] = std::exp(
+                    -InterpolatedForwardCurve<T>::zeroYieldImpl(t[i])*t[i]);
+        }
+    }
+
     template <class T>
     InterpolatedForwardCurve<T>::InterpolatedForwardCurve(
                                     const DayCounter& dayCounter,
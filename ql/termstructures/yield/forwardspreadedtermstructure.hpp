@@ -67,6 +67,12 @@ namespace QuantLib {
         /* This method must disappear should the spread become a curve */
         Rate zeroYieldImpl(Time t) const override;
         //@}
+        //! \name YieldTermStructure implementation
+        //@{
+        void discountsImpl(const Time* t,
+                           DiscountFactor* d,
+                           Size n) const override;
+        //@}
       private:
         Handle<YieldTermStructure> originalCurve_;
         Handle<Quote> spread_;
@@ -126,6 +132,26 @@ namespace QuantLib {
             + spread_->value();
     }
 
+    inline void ForwardSpreadedTermStructure::discountsImpl(const Time* t,
+                                                            DiscountFactor* d,
+                                                            Size n) const {
+        // same as zeroYieldImpl, with the original discount factors
+        // calculated in a single batch
+        originalCurve_->discount(t, d, n, true);
+        Spread spread = spread_->value();
+        for (Size i=0; i<n; ++i) {
+            if (t[i] == 0.0) {
+                d[i] = 1.0;
+            } else {
+                Rate r = InterestRate::impliedRate(1.0/d[i],
+                                                   originalCurve_->dayCounter(),
+                                                   Continuous, NoFrequency,
+                                                   t[i]) + spread;
+                d[i] = std::exp(-r*t[i]);
+            }
+        }
+    }
+
 }
 
 #endif
@@ -27,6 +27,7 @@
 
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -57,8 +58,14 @@ namespace QuantLib {
 
       protected:
         DiscountFactor discountImpl(Time) const override;
+        void discountsImpl(const Time* t,
+                           DiscountFactor* d,
+                           Size n) const override;
         //@}
       private:
+        void originalDiscounts(const Time* t,
+                               DiscountFactor* d,
+                               Size n) const;
         Handle<YieldTermStructure> originalCurve_;
     };
 
@@ -144,6 +151,45 @@ namespace QuantLib {
 
     }
 
+    inline void ImpliedTermStructure::discountsImpl(const Time* t,
+                                                    DiscountFactor* d,
+                                                    Size n) const {
+        // as in discountImpl, with the evaluation date set (if needed)
+        // once for the whole batch
+        Date globalEvalDate = Settings::instance().evaluationDate();
+        const Date& spotDate = originalCurve_->referenceDate();
+        if (spotDate == globalEvalDate) {
+            originalDiscounts(t, d, n);
+        } else {
+            try {
+                Settings::instance().evaluationDate() = spotDate;
+                originalDiscounts(t, d, n);
+                Settings::instance().evaluationDate() = globalEvalDate;
+            } catch (...) {
+                Settings::instance().evaluationDate() = globalEvalDate;
+                throw;
+            }
+        }
+    }
+
+    inline void ImpliedTermStructure::originalDiscounts(const Time* t,
+                                                        DiscountFactor* d,
+                                                        Size n) const {
+        const Date& ref = referenceDate();
+        DiscountFactor denom = originalCurve_->discount(ref, true);
+        QL_REQUIRE(denom != 0,
+                   "Discount factor of spot curve for maturity " <<
+                   ref << " must not be 0");
+        Time shift =
+            dayCounter().yearFraction(originalCurve_->referenceDate(), ref);
+        std::vector<Time> originalTimes(t, t+n);
+        for (Size i=0; i<n; ++i)
+            originalTimes[i] += shift;
+        originalCurve_->discount(originalTimes.data(), d, n, true);
+        for (Size i=0; i<n; ++i)
+            d[i] /= denom;
+    }
+
 }
 
 
@@ -0,0 +1,386 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/yield/multicurve.hpp>
+#include <ql/threadlocalsettings.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+#include <algorithm>
+#include <deque>
+#include <string>
+
+namespace QuantLib {
+
+    namespace {
+
+        // Tarjan's algorithm; the components are found after the
+        // ones they depend upon
+        class StronglyConnectedComponents {
+          public:
+            explicit StronglyConnectedComponents(
+                               const std::vector<std::vector<Size> >& next)
+            : next_(next), index_(next.size(), Null<Size>()),
+              low_(next.size(), 0), onStack_(next.size(), 0) {
+                for (Size i=0; i<next.size(); ++i)
+                    if (index_[i] == Null<Size>())
+                        visit(i);
+            }
+            const std::vector<std::vector<Size> >& components() const {
+                return components_;
+            }
+          private:
+            void visit(Size i) {
+                index_[i] = low_[i] = counter_++;
+                stack_.push_back(i);
+                onStack_[i] = 1;
+                for (Size j : next_[i]) {
+                    if (index_[j] == Null<Size>()) {
+                        visit(j);
+                        low_[i] = std::min(low_[i], low_[j]);
+                    } else if (onStack_[j] != 0) {
+                        low_[i] = std::min(low_[i], index_[j]);
+                    }
+                }
+                if (low_[i] == index_[i]) {
+                    components_.emplace_back();
+                    Size j;
+                    do {
+                        j = stack_.back();
+                        stack_.pop_back();
+                        onStack_[j] = 0;
+                        components_.back().push_back(j);
+                    } while (j != i);
+                    std::sort(components_.back().begin(),
+                              components_.back().end());
+                }
+            }
+            const std::vector<std::vector<Size> >& next_;
+            std::vector<Size> index_, low_, stack_;
+            std::vector<char> onStack_;
+            Size counter_ = 0;
+            std::vector<std::vector<Size> > components_;
+        };
+
+    }
+
+    MultiCurve::MultiCurve(Real accuracy, Size maxIterations, Size threads)
+    : accuracy_(accuracy), maxIterations_(maxIterations), threads_(threads) {
+        QL_REQUIRE(threads_ > 0, "at least one thread required");
+    }
+
+    Size MultiCurve::add(const ext::shared_ptr<YieldTermStructure>& curve,
+                         std::vector<ext::shared_ptr<RateHelper> > helpers) {
+        QL_REQUIRE(curve, "null curve given");
+        auto* lazy = dynamic_cast<LazyObject*>(curve.get());
+        QL_REQUIRE(lazy != nullptr, "curve is not a lazy object");
+        QL_REQUIRE(std::find(lazy_.begin(), lazy_.end(), lazy) == lazy_.end(),
+                   "curve already added");
+        for (const auto& helper : helpers)
+            QL_REQUIRE(helper, "null helper given");
+        curves_.push_back(curve);
+        lazy_.push_back(lazy);
+        helpers_.push_back(std::move(helpers));
+        built_ = false;
+        return curves_.size()-1;
+    }
+
+    const ext::shared_ptr<YieldTermStructure>&
+    MultiCurve::curve(Size i) const {
+        QL_REQUIRE(i < curves_.size(),
+                   "curve #" << i << " not available: "
+                   << curves_.size() << " curves in the set");
+        return curves_[i];
+    }
+
+    const std::vector<ext::shared_ptr<RateHelper> >&
+    MultiCurve::helpers(Size i) const {
+        QL_REQUIRE(i < curves_.size(),
+                   "curve #" << i << " not available: "
+                   << curves_.size() << " curves in the set");
+        return helpers_[i];
+    }
+
+    const std::vector<std::vector<Size> >& MultiCurve::blocks() const {
+        if (!built_)
+            build();
+        return blocks_;
+    }
+
+    Size MultiCurve::levels() const {
+        if (!built_)
+            build();
+        return levelStart_.size()-1;
+    }
+
+    Size MultiCurve::levelStart(Size level) const {
+        QL_REQUIRE(level < levels(),
+                   "level #" << level << " not available: "
+                   << levels() << " levels in the set");
+        return levelStart_[level];
+    }
+
+    void MultiCurve::build() const {
+        const Size n = curves_.size();
+        boost::unordered_map<LazyObject*, Size> index;
+        for (Size i=0; i<n; ++i)
+            index[lazy_[i]] = i;
+
+        // upward visit of the registrations of each curve, stopping
+        // at the other curves in the set; other observers (helpers,
+        // handles, indexes, lazy objects outside the set) are passed
+        // through
+        std::vector<std::vector<Size> > dependencies(n);
+        std::vector<std::vector<LazyObject*> > externals(n);
+        std::vector<Observable*> stack;
+        boost::unordered_set<Observable*> visited;
+        for (Size i=0; i<n; ++i) {
+            stack.clear();
+            visited.clear();
+            auto push = [&](Observer* o) {
+                for (const auto& observable : o->observables())
+                    if (visited.insert(observable.get()).second)
+                        stack.push_back(observable.get());
+            };
+            push(lazy_[i]);
+            boost::unordered_set<Size> found;
+            while (!stack.empty()) {
+                Observable* observable = stack.back();
+                stack.pop_back();
+                auto* lazy = dynamic_cast<LazyObject*>(observable);
+                if (lazy != nullptr) {
+                    auto j = index.find(lazy);
+                    if (j != index.end()) {
+                        if (j->second != i && found.insert(j->second).second)
+                            dependencies[i].push_back(j->second);
+                        continue;
+                    }
+                    externals[i].push_back(lazy);
+                }
+                auto* observer = dynamic_cast<Observer*>(observable);
+                if (observer != nullptr)
+                    push(observer);
+            }
+        }
+
+        // blocks of mutually dependent curves, sorted in levels
+        std::vector<std::vector<Size> > components =
+            StronglyConnectedComponents(dependencies).components();
+        const Size m = components.size();
+        std::vector<Size> componentOf(n);
+        for (Size c=0; c<m; ++c)
+            for (Size i : components[c])
+                componentOf[i] = c;
+        std::vector<Size> level(m, 0);
+        Size nLevels = n > 0 ? 1 : 0;
+        for (Size c=0; c<m; ++c) {
+            for (Size i : components[c])
+                for (Size j : dependencies[i])
+                    if (componentOf[j] != c)
+                        level[c] = std::max(level[c], level[componentOf[j]]+1);
+            nLevels = std::max(nLevels, level[c]+1);
+        }
+
+        std::vector<Size> order(m);
+        for (Size c=0; c<m; ++c)
+            order[c] = c;
+        std::stable_sort(order.begin(), order.end(),
+                         [&level](Size i, Size j) {
+                             return level[i] < level[j];
+                         });
+
+        blocks_.resize(m);
+        blockDependencies_.assign(m, std::vector<Size>());
+        blockExternals_.assign(m, std::vector<LazyObject*>());
+        std::vector<Size> position(m);
+        for (Size k=0; k<m; ++k)
+            position[order[k]] = k;
+        levelStart_.assign(nLevels+1, m);
+        for (Size k=m; k>0; --k) {
+            Size c = order[k-1];
+            blocks_[k-1] = components[c];
+            levelStart_[level[c]] = k-1;
+            boost::unordered_set<Size> found;
+            boost::unordered_set<LazyObject*> foundExternals;
+            for (Size i : components[c]) {
+                for (Size j : dependencies[i])
+                    if (componentOf[j] != c
+                        && found.insert(componentOf[j]).second)
+                        blockDependencies_[k-1].push_back(
+                                                position[componentOf[j]]);
+                for (LazyObject* e : externals[i])
+                    if (foundExternals.insert(e).second)
+                        blockExternals_[k-1].push_back(e);
+            }
+        }
+        built_ = true;
+    }
+
+    Real MultiCurve::maxError(const std::vector<Size>& block) const {
+        Real error = 0.0;
+        for (Size i : block) {
+            Date firstDate = curves_[i]->referenceDate();
+            for (const auto& helper : helpers_[i]) {
+                if (helper->pillarDate() > firstDate)
+                    error = std::max(error, std::fabs(helper->quoteError()));
+            }
+        }
+        return error;
+    }
+
+    void MultiCurve::solve(const std::vector<Size>& block) const {
+        if (block.size() == 1) {
+            lazy_[block.front()]->ensureCalculated();
+            return;
+        }
+
+        bool calculated = true;
+        for (Size i : block)
+            calculated = calculated && (lazy_[i]->isCalculated()
+                                        || lazy_[i]->isFrozen());
+        if (calculated)
+            return;
+
+        // first pass, in which each curve uses the others as they are
+        // available; this gives the results of the usual recursive
+        // calculation
+        for (Size i : block)
+            lazy_[i]->ensureCalculated();
+        Real error = maxError(block);
+
+        // then, each curve is bootstrapped in turn on the latest
+        // results for the others, which are kept frozen meanwhile
+        Size iteration = 0;
+        {
+            std::deque<LazyObject::FreezeGuard> frozen;
+            for (Size i : block)
+                frozen.emplace_back(*lazy_[i]);
+            while (error > accuracy_ && iteration < maxIterations_) {
+                for (auto& curve : frozen)
+                    curve.recalculate();
+                error = maxError(block);
+                ++iteration;
+            }
+            // notifications received while frozen came from the
+            // other curves in the block, which are now consistent
+            for (auto& curve : frozen)
+                curve.complete();
+        }
+
+        QL_ENSURE(error <= accuracy_,
+                  "mutually dependent curves not converged after "
+                  << iteration << " iterations: maximum quote error is "
+                  << error << ", accuracy is " << accuracy_);
+    }
+
+    void MultiCurve::calculate() const {
+        if (!built_)
+            build();
+
+        const Size m = blocks_.size();
+        std::vector<std::string> errors(m);
+        std::vector<char> failed(m, 0);
+        auto run = [&](Size b) {
+            if (failed[b] != 0)
+                return;
+            try {
+                solve(blocks_[b]);
+            } catch (std::exception& e) {
+                failed[b] = 1;
+                errors[b] = e.what();
+            } catch (...) {
+                failed[b] = 1;
+            }
+        };
+
+        const SharedSettings settings;
+        for (Size l=0; l+1<levelStart_.size(); ++l) {
+            const Size begin = levelStart_[l], end = levelStart_[l+1];
+            for (Size b=begin; b<end; ++b) {
+                // curves depending on failed ones are not calculated,
+                // as their bootstrap would retry the failed ones
+                for (Size d : blockDependencies_[b])
+                    if (failed[d] != 0)
+                        failed[b] = 1;
+                // lazy objects outside the set might be shared by
+                // blocks in the level; they are calculated in sequence
+                for (LazyObject* e : blockExternals_[b]) {
+                    if (failed[b] != 0)
+                        break;
+                    try {
+                        e->ensureCalculated();
+                    } catch (std::exception& ex) {
+                        failed[b] = 1;
+                        errors[b] = ex.what();
+                    } catch (...) {
+                        failed[b] = 1;
+                    }
+                }
+            }
+            #pragma omp parallel for if(threads_ > 1) num_threads(threads_)
+            for (long b=(long)begin; b<(long)end; ++b) {
+                const SharedSettings::Scope scope(settings);
+                if (blocks_[b].size() == 1)
+                    run(b);
+            }
+            // the first pass over a block can trigger nested
+            // calculations of its curves, so blocks are solved in
+            // sequence
+            for (Size b=begin; b<end; ++b) {
+                if (blocks_[b].size() > 1)
+                    run(b);
+            }
+        }
+
+        bool successful = true;
+        std::string errMsg;
+        for (Size b=0; b<m; ++b) {
+            if (failed[b] != 0) {
+                successful = false;
+                if (!errors[b].empty())
+                    errMsg = errors[b];
+            }
+        }
+        QL_ENSURE(successful,
+                  "could not bootstrap one or more curves: " << errMsg);
+    }
+
+    void MultiCurve::setQuotes(
+                   const std::vector<ext::shared_ptr<SimpleQuote> >& quotes,
+                   const std::vector<Real>& values) {
+        QL_REQUIRE(quotes.size() == values.size(),
+                   "mismatch between number of quotes (" << quotes.size()
+                   << ") and number of values (" << values.size() << ")");
+        for (const auto& quote : quotes)
+            QL_REQUIRE(quote, "null quote given");
+
+        // each observer is notified once, after all quotes are set
+        ObservableSettings& settings = ObservableSettings::instance();
+        const bool enabled = settings.updatesEnabled();
+        const bool deferred = settings.updatesDeferred();
+        settings.disableUpdates(true);
+        for (Size i=0; i<quotes.size(); ++i)
+            quotes[i]->setValue(values[i]);
+        if (enabled)
+            settings.enableUpdates();
+        else
+            settings.disableUpdates(deferred);
+
+        calculate();
+    }
+
+}
@@ -0,0 +1,144 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multicurve.hpp
+    \brief bootstrap of a set of interdependent yield curves
+*/
+
+#ifndef quantlib_multi_curve_hpp
+#define quantlib_multi_curve_hpp
+
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Set of yield curves bootstrapped together
+    /*! The curves (e.g., an overnight discount curve, the forwarding
+        curves for several tenors, and cross-currency curves) are
+        added together with the helpers they are bootstrapped on.
+        When first calculated, the set follows the registrations of
+        each curve upwards to find the other curves in the set it
+        depends upon, e.g., through the discount or forecast handles
+        of its helpers.
+
+        The curves are then sorted in levels, each level depending
+        only on the previous ones.  If more than one thread is given
+        and the library is compiled with OpenMP, the independent
+        curves in a level are bootstrapped concurrently; curves
+        depending on each other, directly or not, are bootstrapped as
+        a single block by iterating over them, each curve being
+        bootstrapped while the others are kept frozen, until all the
+        helpers in the block reprice their quotes within the given
+        accuracy.
+
+        Only the curves invalidated since their last calculation are
+        bootstrapped again.  setQuotes() provides a single entry
+        point for market updates: the notifications are collected
+        while the quotes are set and sent once, after which the
+        affected curves (and only those) are recalculated.  Curves
+        using IterativeBootstrap in incremental mode also skip the
+        pillars before the first changed quote.
+
+        Lazy objects outside the set found between a curve and its
+        dependencies (e.g., a spreaded curve used as a discount
+        curve) are calculated in sequence before the level of the
+        curve is bootstrapped, so that curves in the same level
+        don't calculate them concurrently.
+
+        \warning All curves which other curves in the set depend
+                 upon must be added to the set.
+
+        \warning The dependencies are a snapshot of the
+                 registrations at the first calculation; the set
+                 must not be used after the curves or their helpers
+                 register or unregister, e.g., after a relinkable
+                 handle used by a helper is linked to a different
+                 curve.
+    */
+    class MultiCurve {
+      public:
+        /*! \param accuracy  tolerance on the quote errors of the
+                             helpers of mutually dependent curves
+            \param maxIterations  maximum number of iterations over
+                                  a block of mutually dependent curves
+            \param threads  number of threads bootstrapping the
+                            independent curves in a level
+        */
+        explicit MultiCurve(Real accuracy = 1.0e-10,
+                            Size maxIterations = 50,
+                            Size threads = 1);
+        /*! adds a curve and the helpers it is bootstrapped on, and
+            returns its index in the set.  The curve must be a lazy
+            object, e.g., a PiecewiseYieldCurve.
+        */
+        Size add(const ext::shared_ptr<YieldTermStructure>& curve,
+                 std::vector<ext::shared_ptr<RateHelper> > helpers);
+        //! \name Inspectors
+        //@{
+        Size size() const { return curves_.size(); }
+        const ext::shared_ptr<YieldTermStructure>& curve(Size i) const;
+        const std::vector<ext::shared_ptr<RateHelper> >& helpers(Size i) const;
+        /*! sets of curves bootstrapped together, in the order in
+            which they are calculated
+        */
+        const std::vector<std::vector<Size> >& blocks() const;
+        /*! number of levels; the blocks in each level only depend
+            on the ones in the previous levels
+        */
+        Size levels() const;
+        //! index in blocks() of the first block of the given level
+        Size levelStart(Size level) const;
+        //@}
+        //! \name Calculations
+        //@{
+        /*! bootstraps the curves invalidated since their last
+            calculation.  If any bootstrap fails, the others are
+            performed anyway, as far as they don't depend on the
+            failed ones, and an exception is raised at the end.
+        */
+        void calculate() const;
+        /*! sets the given quotes to the given values and
+            bootstraps the affected curves.
+        */
+        void setQuotes(const std::vector<ext::shared_ptr<SimpleQuote> >& quotes,
+                       const std::vector<Real>& values);
+        //@}
+      private:
+        void build() const;
+        void solve(const std::vector<Size>& block) const;
+        Real maxError(const std::vector<Size>& block) const;
+        Real accuracy_;
+        Size maxIterations_;
+        Size threads_;
+        std::vector<ext::shared_ptr<YieldTermStructure> > curves_;
+        std::vector<LazyObject*> lazy_;
+        std::vector<std::vector<ext::shared_ptr<RateHelper> > > helpers_;
+        mutable bool built_ = false;
+        mutable std::vector<std::vector<Size> > blocks_;
+        // blocks each block depends upon
+        mutable std::vector<std::vector<Size> > blockDependencies_;
+        // lazy objects outside the set each block depends upon
+        mutable std::vector<std::vector<LazyObject*> > blockExternals_;
+        mutable std::vector<Size> levelStart_;
+    };
+
+}
+
+
+#endif
@@ -170,6 +170,14 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Bootstrap inspectors
+        //@{
+        /*! sensitivities of the curve data to the quotes of the
+            instruments, for bootstrappers calculating them (see
+            IterativeBootstrap::jacobian())
+        */
+        const Matrix& jacobian() const;
+        //@}
         //! \name Observer interface
         //@{
         void update() override;
@@ -181,6 +189,9 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const override;
+        void discountsImpl(const Time* t,
+                           DiscountFactor* d,
+                           Size n) const override;
         // data members
         std::vector<ext::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
@@ -230,6 +241,12 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline const Matrix& PiecewiseYieldCurve<C,I,B>::jacobian() const {
+        calculate();
+        return bootstrap_.jacobian();
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
@@ -251,6 +268,14 @@ namespace QuantLib {
         return base_curve::discountImpl(t);
     }
 
+    template <class C, class I, template <class> class B>
+    void PiecewiseYieldCurve<C,I,B>::discountsImpl(const Time* t,
+                                                   DiscountFactor* d,
+                                                   Size n) const {
+        calculate();
+        base_curve::discountsImpl(t, d, n);
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::performCalculations() const {
         // just delegate to the bootstrapper
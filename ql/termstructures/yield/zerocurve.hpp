@@ -115,6 +115,12 @@ namespace QuantLib {
         //@{
         Rate zeroYieldImpl(Time t) const override;
         //@}
+        //! \name YieldTermStructure implementation
+        //@{
+        void discountsImpl(const Time* t,
+                           DiscountFactor* d,
+                           Size n) const override;
+        //@}
         mutable std::vector<Date> dates_;
       private:
         void initialize(const Compounding& compounding, const Frequency& frequency);
@@ -181,6 +187,22 @@ namespace QuantLib {
         return (zMax * tMax + instFwdMax * (t-tMax)) / t;
     }
 
+    template <class T>
+    void InterpolatedZeroCurve<T>::discountsImpl(const Time* t,
+                                                 DiscountFactor* d,
+                                                 Size n) const {
+        this->interpolation_.values(t, d, n, true);
+        for (Size i=0; i<n; ++i) {
+            if (t[i] == 0.0) {
+                d[i] = 1.0;
+            } else {
+                Rate r = t[i] <= this->times_.back() ?
+                    d[i] : InterpolatedZeroCurve<T>::zeroYieldImpl(t[i]);
+                d[i] = std::exp(-r*t[i]);
+            }
+        }
+    }
+
     template <class T>
     InterpolatedZeroCurve<T>::InterpolatedZeroCurve(
                                     const DayCounter& dayCounter,
@@ -70,6 +70,10 @@ namespace QuantLib {
         //! returns the spreaded forward rate
         /* This method must disappear should the spread become a curve */
         Rate forwardImpl(Time) const;
+        //! returns the spreaded discount factors
+        void discountsImpl(const Time* t,
+                           DiscountFactor* d,
+                           Size n) const override;
       private:
         Handle<YieldTermStructure> originalCurve_;
         Handle<Quote> spread_;
@@ -140,6 +144,30 @@ namespace QuantLib {
         return spreadedRate.equivalentRate(Continuous, NoFrequency, t);
     }
 
+    inline void ZeroSpreadedTermStructure::discountsImpl(const Time* t,
+                                                         DiscountFactor* d,
+                                                         Size n) const {
+        // same as zeroYieldImpl, with the original discount factors
+        // calculated in a single batch
+        originalCurve_->discount(t, d, n, true);
+        Spread spread = spread_->value();
+        DayCounter dayCounter = originalCurve_->dayCounter();
+        for (Size i=0; i<n; ++i) {
+            if (t[i] == 0.0) {
+                d[i] = 1.0;
+            } else {
+                InterestRate zeroRate =
+                    InterestRate::impliedRate(1.0/d[i], dayCounter,
+                                              comp_, freq_, t[i]);
+                InterestRate spreadedRate(zeroRate + spread, dayCounter,
+                                          comp_, freq_);
+                Rate r = spreadedRate.equivalentRate(Continuous, NoFrequency,
+                                                     t[i]);
+                d[i] = std::exp(-r*t[i]);
+            }
+        }
+    }
+
     inline Rate ZeroSpreadedTermStructure::forwardImpl(Time t) const {
         return originalCurve_->forwardRate(t, t, comp_, freq_, true)
             + spread_->value();
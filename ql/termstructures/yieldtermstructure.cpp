@@ -21,6 +21,7 @@
 
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -124,6 +125,47 @@ namespace QuantLib {
         return jumpEffect * discountImpl(t);
     }
 
+    void YieldTermStructure::discount(const Time* t,
+                                      DiscountFactor* d,
+                                      Size n,
+                                      bool extrapolate) const {
+        if (n == 0)
+            return;
+        Time tMin = t[0], tMax = t[0];
+        for (Size i=1; i<n; ++i) {
+            tMin = std::min(tMin, t[i]);
+            tMax = std::max(tMax, t[i]);
+        }
+        checkRange(tMin, extrapolate);
+        checkRange(tMax, extrapolate);
+
+        if (jumps_.empty()) {
+            discountsImpl(t, d, n);
+        } else {
+            for (Size i=0; i<n; ++i)
+                d[i] = discount(t[i], true);
+        }
+    }
+
+    void YieldTermStructure::discount(const Date* d,
+                                      DiscountFactor* discounts,
+                                      Size n,
+                                      bool extrapolate) const {
+        if (n == 0)
+            return;
+        std::vector<Time> times(n);
+        for (Size i=0; i<n; ++i)
+            times[i] = timeFromReference(d[i]);
+        discount(&times[0], discounts, n, extrapolate);
+    }
+
+    void YieldTermStructure::discountsImpl(const Time* t,
+                                           DiscountFactor* d,
+                                           Size n) const {
+        for (Size i=0; i<n; ++i)
+            d[i] = discountImpl(t[i]);
+    }
+
     InterestRate YieldTermStructure::zeroRate(const Date& d,
                                               const DayCounter& dayCounter,
                                               Compounding comp,
@@ -199,6 +241,65 @@ namespace QuantLib {
                                          t2-t1);
     }
 	
+    void YieldTermStructure::forwardRate(const Date* d1,
+                                         const Date* d2,
+                                         Rate* rates,
+                                         Size n,
+                                         const DayCounter& dayCounter,
+                                         Compounding comp,
+                                         Frequency freq,
+                                         bool extrapolate) const {
+        if (n == 0)
+            return;
+        // discount factors at the start and end dates
+        std::vector<Time> times(2*n);
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(d1[i] <= d2[i], d1[i] << " later than " << d2[i]);
+            times[i] = timeFromReference(d1[i]);
+            times[n+i] = timeFromReference(d2[i]);
+        }
+        std::vector<DiscountFactor> discounts(2*n);
+        discount(&times[0], &discounts[0], 2*n, extrapolate);
+        for (Size i=0; i<n; ++i) {
+            if (d1[i] == d2[i])
+                rates[i] = forwardRate(d1[i], d2[i], dayCounter, comp, freq,
+                                       extrapolate).rate();
+            else
+                rates[i] = InterestRate::impliedRate(discounts[i]/discounts[n+i],
+                                                     dayCounter, comp, freq,
+                                                     d1[i], d2[i]).rate();
+        }
+    }
+
+    void YieldTermStructure::forwardRate(const Time* t1,
+                                         const Time* t2,
+                                         Rate* rates,
+                                         Size n,
+                                         Compounding comp,
+                                         Frequency freq,
+                                         bool extrapolate) const {
+        if (n == 0)
+            return;
+        std::vector<Time> times(2*n);
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(t2[i] >= t1[i],
+                       "t2 (" << t2[i] << ") < t1 (" << t1[i] << ")");
+            times[i] = t1[i];
+            times[n+i] = t2[i];
+        }
+        std::vector<DiscountFactor> discounts(2*n);
+        discount(&times[0], &discounts[0], 2*n, extrapolate);
+        for (Size i=0; i<n; ++i) {
+            if (t1[i] == t2[i])
+                rates[i] = forwardRate(t1[i], t2[i], comp, freq,
+                                       extrapolate).rate();
+            else
+                rates[i] = InterestRate::impliedRate(discounts[i]/discounts[n+i],
+                                                     dayCounter(), comp, freq,
+                                                     t2[i]-t1[i]).rate();
+        }
+    }
+
     void YieldTermStructure::setTransientJumps( bool b ) {
         transientJumps_ = b;
     }
@@ -84,6 +84,19 @@ namespace QuantLib {
         */
         DiscountFactor discount(Time t,
                                 bool extrapolate = false) const;
+        /*! Discount factors at the \f$ n \f$ times t, written in d.
+            Curves based on interpolations calculate them in a single
+            pass, which is fastest if the times are sorted.
+        */
+        void discount(const Time* t,
+                      DiscountFactor* d,
+                      Size n,
+                      bool extrapolate = false) const;
+        //! discount factors at the \f$ n \f$ dates d, written in discounts
+        void discount(const Date* d,
+                      DiscountFactor* discounts,
+                      Size n,
+                      bool extrapolate = false) const;
         //@}
 
         /*! \name Zero-yield rates
@@ -151,6 +164,29 @@ namespace QuantLib {
                                  Compounding comp,
                                  Frequency freq = Annual,
                                  bool extrapolate = false) const;
+        /*! Forward rates between the \f$ n \f$ pairs of dates d1
+            and d2, written in rates.  The discount factors are
+            calculated in a single batch.
+        */
+        void forwardRate(const Date* d1,
+                         const Date* d2,
+                         Rate* rates,
+                         Size n,
+                         const DayCounter& resultDayCounter,
+                         Compounding comp,
+                         Frequency freq = Annual,
+                         bool extrapolate = false) const;
+        /*! Forward rates between the \f$ n \f$ pairs of times t1
+            and t2, written in rates.  The discount factors are
+            calculated in a single batch.
+        */
+        void forwardRate(const Time* t1,
+                         const Time* t2,
+                         Rate* rates,
+                         Size n,
+                         Compounding comp,
+                         Frequency freq = Annual,
+                         bool extrapolate = false) const;
         //@}
 
         //! \name Jump inspectors
@@ -180,6 +216,12 @@ namespace QuantLib {
         //@{
         //! discount factor calculation
         virtual DiscountFactor discountImpl(Time) const = 0;
+        /*! discount factors at several times; the default
+            implementation calls discountImpl(Time) for each of them.
+        */
+        virtual void discountsImpl(const Time* t,
+                                   DiscountFactor* d,
+                                   Size n) const;
         //@}
       private:
         // methods
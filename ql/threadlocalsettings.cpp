@@ -0,0 +1,43 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/threadlocalsettings.hpp>
+
+namespace QuantLib {
+
+    ThreadLocalSettings::ThreadLocalSettings()
+    : settings_(copyOfSettings()), indexManager_(viewOfIndexManager()) {}
+
+    ext::shared_ptr<Settings> ThreadLocalSettings::copyOfSettings() {
+        const Settings& current = Settings::instance();
+        ext::shared_ptr<Settings> settings(new Settings);
+        settings->evaluationDate_ = current.evaluationDate_.value();
+        settings->includeReferenceDateEvents_ =
+            current.includeReferenceDateEvents_;
+        settings->includeTodaysCashFlows_ = current.includeTodaysCashFlows_;
+        settings->enforcesTodaysHistoricFixings_ =
+            current.enforcesTodaysHistoricFixings_;
+        return settings;
+    }
+
+    ext::shared_ptr<IndexManager> ThreadLocalSettings::viewOfIndexManager() {
+        ext::shared_ptr<IndexManager> manager(new IndexManager);
+        manager->base_ = &IndexManager::instance();
+        return manager;
+    }
+
+}
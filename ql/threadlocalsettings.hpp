@@ -0,0 +1,116 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file threadlocalsettings.hpp
+    \brief settings and fixings owned by the current thread
+*/
+
+#ifndef quantlib_thread_local_settings_hpp
+#define quantlib_thread_local_settings_hpp
+
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/settings.hpp>
+
+namespace QuantLib {
+
+    //! settings and fixings owned by the current thread
+    /*! While an instance of this class is alive, Settings::instance()
+        and IndexManager::instance() called from the thread that
+        created it return objects owned by the instance; thus,
+        scenarios at different evaluation dates can run concurrently
+        in different threads, e.g.:
+        \code
+        #pragma omp parallel for
+        for (long i=0; i<(long)dates.size(); ++i) {
+            ThreadLocalSettings local;
+            Settings::instance().evaluationDate() = dates[i];
+            // build and price instruments
+        }
+        \endcode
+        The new settings are a copy of the current ones; the new
+        index manager is a view of the current one, whose fixings
+        are copied when first accessed.  Changes are not propagated
+        back.  Other singletons are not affected.
+
+        Instances can be nested, and must be destroyed in the
+        thread that created them in reverse order of creation.
+
+        The parallel regions of the library (e.g., the workers of
+        MonteCarloModel, the Longstaff-Schwartz calibration, or the
+        concurrent bootstrap of MultiCurve) use SharedSettings to
+        propagate the current settings and fixings to their worker
+        threads.  Other parallel code must do the same if it uses
+        objects built in the scope of an instance.
+
+        \warning Term structures and other objects register with the
+                 evaluation date and the fixings current when they
+                 are built; therefore, they should only be used in
+                 the scope in which they were created.
+
+        \warning The viewed fixings must not be modified while
+                 a view is alive.
+    */
+    class ThreadLocalSettings {
+      public:
+        ThreadLocalSettings();
+        Settings& settings() const { return settings_.instance(); }
+        IndexManager& indexManager() const {
+            return indexManager_.instance();
+        }
+      private:
+        static ext::shared_ptr<Settings> copyOfSettings();
+        static ext::shared_ptr<IndexManager> viewOfIndexManager();
+        ThreadLocalInstance<Settings> settings_;
+        ThreadLocalInstance<IndexManager> indexManager_;
+    };
+
+    //! settings and fixings of a thread, shared with worker threads
+    /*! An instance records the settings and the index manager seen
+        by the thread that creates it, i.e., the ones of the
+        innermost ThreadLocalSettings alive in that thread, if any.
+        While a Scope built on it is alive, they are also seen by
+        the thread that built the scope, e.g.:
+        \code
+        const SharedSettings shared;
+        #pragma omp parallel for
+        for (long i=0; i<n; ++i) {
+            const SharedSettings::Scope scope(shared);
+            // same evaluation date and fixings as outside the loop
+        }
+        \endcode
+        See SharedThreadInstance for the restrictions.
+    */
+    class SharedSettings {
+      public:
+        class Scope : private boost::noncopyable {
+          public:
+            explicit Scope(const SharedSettings& shared)
+            : settings_(shared.settings_),
+              indexManager_(shared.indexManager_) {}
+          private:
+            SharedThreadInstance<Settings>::Scope settings_;
+            SharedThreadInstance<IndexManager>::Scope indexManager_;
+        };
+      private:
+        SharedThreadInstance<Settings> settings_;
+        SharedThreadInstance<IndexManager> indexManager_;
+    };
+
+}
+
+
+#endif
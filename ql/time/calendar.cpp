@@ -24,9 +24,117 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        inline Integer bitCount(std::uint64_t x) {
+#if defined(__GNUC__)
+            return __builtin_popcountll(x);
+#else
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return Integer((x * 0x0101010101010101ULL) >> 56);
+#endif
+        }
+
+        // position of the lowest set bit; x must not be 0
+        inline Integer lowestBit(std::uint64_t x) {
+#if defined(__GNUC__)
+            return __builtin_ctzll(x);
+#else
+            Integer i = 0;
+            while ((x & 1) == 0) {
+                x >>= 1;
+                ++i;
+            }
+            return i;
+#endif
+        }
+
+    }
+
+    std::vector<Calendar> Calendar::Impl::underlyingCalendars() const {
+        return std::vector<Calendar>();
+    }
+
+    Calendar::BusinessDayCache::BusinessDayCache(const Calendar& calendar,
+                                                 const Date& from,
+                                                 const Date& to)
+    : first_(from.serialNumber()), last_(to.serialNumber()) {
+        QL_REQUIRE(first_ <= last_,
+                   "'from' date (" << from
+                   << ") must not be later than 'to' date (" << to << ")");
+
+        // the calendars this one depends upon, at any depth
+        std::vector<Calendar> calendars =
+            calendar.impl_->underlyingCalendars();
+        while (!calendars.empty()) {
+            Calendar c = calendars.back();
+            calendars.pop_back();
+            underlying_.emplace_back(c.impl_, c.impl_->holidaysVersion);
+            std::vector<Calendar> next = c.impl_->underlyingCalendars();
+            calendars.insert(calendars.end(), next.begin(), next.end());
+        }
+
+        const Date::serial_type n = last_ - first_ + 1;
+        const Size words = Size((n + 63) >> 6);
+        bits_.assign(words, 0);
+        ranks_.assign(words+1, 0);
+        for (Date::serial_type k=0; k<n; ++k) {
+            if (calendar.isBusinessDay(Date(first_ + k)))
+                bits_[k >> 6] |= std::uint64_t(1) << (k & 63);
+        }
+        for (Size w=0; w<words; ++w)
+            ranks_[w+1] = ranks_[w] + bitCount(bits_[w]);
+    }
+
+    void Calendar::BusinessDayCache::set(Date::serial_type s,
+                                         bool isBusinessDay) {
+        if (this->isBusinessDay(s) == isBusinessDay)
+            return;
+        Date::serial_type k = s - first_;
+        bits_[k >> 6] ^= std::uint64_t(1) << (k & 63);
+        Integer delta = isBusinessDay ? 1 : -1;
+        for (Size w = Size(k >> 6) + 1; w < ranks_.size(); ++w)
+            ranks_[w] += delta;
+    }
+
+    Date::serial_type
+    Calendar::BusinessDayCache::rank(Date::serial_type s) const {
+        Date::serial_type k = s - first_;
+        Date::serial_type result = ranks_[k >> 6];
+        if ((k & 63) != 0)
+            result += bitCount(bits_[k >> 6]
+                               & ((std::uint64_t(1) << (k & 63)) - 1));
+        return result;
+    }
+
+    Date::serial_type
+    Calendar::BusinessDayCache::count(Date::serial_type from,
+                                      Date::serial_type to) const {
+        return rank(to) - rank(from);
+    }
+
+    Date::serial_type
+    Calendar::BusinessDayCache::advance(Date::serial_type s,
+                                        Integer n) const {
+        // zero-based position of the wanted business day in the range
+        Date::serial_type r = n > 0 ? rank(s+1) + n - 1 : rank(s) + n;
+        if (r < 0 || r >= ranks_.back())
+            return Null<Date::serial_type>();
+        Size w = (std::upper_bound(ranks_.begin(), ranks_.end(), r)
+                  - ranks_.begin()) - 1;
+        std::uint64_t x = bits_[w];
+        for (Date::serial_type j = r - ranks_[w]; j > 0; --j)
+            x &= x - 1;
+        return first_ + Date::serial_type(w << 6) + lowestBit(x);
+    }
+
     void Calendar::addHoliday(const Date& d) {
         QL_REQUIRE(impl_, "no calendar implementation provided");
 
@@ -42,6 +150,11 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(_d))
             impl_->addedHolidays.insert(_d);
+
+        ++impl_->holidaysVersion;
+        BusinessDayCache* cache = impl_->businessDayCache.get();
+        if (cache != nullptr && cache->covers(_d.serialNumber()))
+            cache->set(_d.serialNumber(), false);
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -59,6 +172,31 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(_d))
             impl_->removedHolidays.insert(_d);
+
+        ++impl_->holidaysVersion;
+        BusinessDayCache* cache = impl_->businessDayCache.get();
+        if (cache != nullptr && cache->covers(_d.serialNumber()))
+            cache->set(_d.serialNumber(), true);
+    }
+
+    void Calendar::cacheBusinessDays(const Date& from, const Date& to) {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        QL_REQUIRE(from != Date() && to != Date(), "null date");
+        // the holidays must be taken from the rules
+        impl_->businessDayCache.reset();
+        impl_->businessDayCache =
+            ext::make_shared<BusinessDayCache>(*this, from, to);
+    }
+
+    void Calendar::clearBusinessDayCache() {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        impl_->businessDayCache.reset();
+    }
+
+    bool Calendar::hasBusinessDayCache(const Date& d) const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        const BusinessDayCache* cache = impl_->businessDayCache.get();
+        return cache != nullptr && cache->covers(d.serialNumber());
     }
 
     Date Calendar::adjust(const Date& d,
@@ -115,6 +253,13 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
+            QL_REQUIRE(impl_, "no calendar implementation provided");
+            const BusinessDayCache* cache = impl_->businessDayCache.get();
+            if (cache != nullptr && cache->covers(d.serialNumber())) {
+                Date::serial_type s = cache->advance(d.serialNumber(), n);
+                if (s != Null<Date::serial_type>())
+                    return d + (s - d.serialNumber());
+            }
             Date d1 = d;
             if (n > 0) {
                 while (n > 0) {
@@ -159,7 +304,15 @@ namespace QuantLib {
                                                     bool includeLast) const {
         Date::serial_type wd = 0;
         if (from != to) {
-            if (from < to) {
+            QL_REQUIRE(impl_, "no calendar implementation provided");
+            const Date& first = std::min(from, to);
+            const Date& last = std::max(from, to);
+            const BusinessDayCache* cache = impl_->businessDayCache.get();
+            if (cache != nullptr && cache->covers(first.serialNumber())
+                && cache->covers(last.serialNumber())) {
+                wd = cache->count(first.serialNumber(),
+                                  last.serialNumber() + 1);
+            } else if (from < to) {
                 // the last one is treated separately to avoid
                 // incrementing Date::maxDate()
                 for (Date d = from; d < to; ++d) {
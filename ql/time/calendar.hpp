@@ -32,9 +32,11 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <ql/shared_ptr.hpp>
+#include <cstdint>
 #include <set>
 #include <vector>
 #include <string>
+#include <utility>
 
 namespace QuantLib {
 
@@ -57,9 +59,13 @@ namespace QuantLib {
         \test the methods for adding and removing holidays are tested
               by inspecting the calendar before and after their
               invocation.
+
+        \test the results of the business-day cache are checked
+              against the holiday rules.
     */
     class Calendar {
       protected:
+        class BusinessDayCache;
         //! abstract base class for calendar implementations
         class Impl {
           public:
@@ -67,7 +73,43 @@ namespace QuantLib {
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
+            //! calendars whose holidays this one is built upon, if any
+            virtual std::vector<Calendar> underlyingCalendars() const;
             std::set<Date> addedHolidays, removedHolidays;
+            //! incremented when holidays are added or removed
+            unsigned long holidaysVersion = 0;
+            ext::shared_ptr<BusinessDayCache> businessDayCache;
+        };
+        //! business days of a calendar over a range of dates
+        /*! The business days are stored as a bitset, together with
+            the number of business days before each 64-bit word, so
+            that business days can be counted and found by rank in
+            constant time.
+        */
+        class BusinessDayCache {
+          public:
+            BusinessDayCache(const Calendar&, const Date& from, const Date& to);
+            //! whether the date is in the range and the cache up to date
+            bool covers(Date::serial_type) const;
+            bool isBusinessDay(Date::serial_type) const;
+            void set(Date::serial_type, bool isBusinessDay);
+            //! number of business days in [from, to)
+            Date::serial_type count(Date::serial_type from,
+                                    Date::serial_type to) const;
+            /*! serial number of the n-th business day after (n > 0)
+                or before (n < 0) the given date, or Null if it's not
+                in the range
+            */
+            Date::serial_type advance(Date::serial_type, Integer n) const;
+          private:
+            Date::serial_type rank(Date::serial_type) const;
+            Date::serial_type first_, last_;
+            std::vector<std::uint64_t> bits_;
+            // business days before each word
+            std::vector<Date::serial_type> ranks_;
+            // versions of the underlying calendars when cached
+            std::vector<std::pair<ext::shared_ptr<Impl>, unsigned long> >
+                underlying_;
         };
         ext::shared_ptr<Impl> impl_;
       public:
@@ -155,6 +197,30 @@ namespace QuantLib {
                                               bool includeFirst = true,
                                               bool includeLast = false) const;
         //@}
+        //! \name Business-day cache
+        //@{
+        /*! Evaluates the holiday rules, together with the added and
+            removed holidays, over the given range and stores the
+            results.  Afterwards, isBusinessDay() is a lookup for
+            dates in the range, and advance() by days and
+            businessDaysBetween() count the business days instead of
+            iterating over them; the rules are still used outside the
+            range.
+
+            As for added and removed holidays, the cache is shared by
+            all instances of the same calendar.  It is kept up to date
+            when holidays are added to or removed from the calendar.
+            The cache of a joint calendar is not used any more once
+            holidays are added to or removed from the underlying
+            calendars; it can be rebuilt by calling this method again.
+        */
+        void cacheBusinessDays(const Date& from = Date::minDate(),
+                               const Date& to = Date::maxDate());
+        //! discards the stored business days
+        void clearBusinessDayCache();
+        //! whether the date is in the range of an up-to-date cache
+        bool hasBusinessDayCache(const Date& d) const;
+        //@}
 
       protected:
         //! partial calendar implementation
@@ -226,6 +292,10 @@ namespace QuantLib {
         const Date& _d = d;
 #endif
 
+        const BusinessDayCache* cache = impl_->businessDayCache.get();
+        if (cache != nullptr && cache->covers(_d.serialNumber()))
+            return cache->isBusinessDay(_d.serialNumber());
+
         if (!impl_->addedHolidays.empty() &&
             impl_->addedHolidays.find(_d) != impl_->addedHolidays.end())
             return false;
@@ -237,6 +307,22 @@ namespace QuantLib {
         return impl_->isBusinessDay(_d);
     }
 
+    inline bool Calendar::BusinessDayCache::covers(Date::serial_type s) const {
+        if (s < first_ || s > last_)
+            return false;
+        for (const auto& u : underlying_) {
+            if (u.first->holidaysVersion != u.second)
+                return false;
+        }
+        return true;
+    }
+
+    inline bool
+    Calendar::BusinessDayCache::isBusinessDay(Date::serial_type s) const {
+        Date::serial_type k = s - first_;
+        return ((bits_[k >> 6] >> (k & 63)) & 1) != 0;
+    }
+
     inline bool Calendar::isEndOfMonth(const Date& d) const {
         return (d.month() != adjust(d+1).month());
     }
@@ -39,6 +39,10 @@ namespace QuantLib {
 
     void BespokeCalendar::Impl::addWeekend(Weekday w) {
         weekend_.insert(w);
+        // business days might have changed; invalidate the caches
+        // of this calendar and of those built upon it
+        ++holidaysVersion;
+        businessDayCache.reset();
     }
 
 
@@ -120,6 +120,10 @@ namespace QuantLib {
         }
     }
 
+    std::vector<Calendar> JointCalendar::Impl::underlyingCalendars() const {
+        return calendars_;
+    }
+
 
     JointCalendar::JointCalendar(const Calendar& c1,
                                  const Calendar& c2,
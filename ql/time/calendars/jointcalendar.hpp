@@ -67,6 +67,7 @@ namespace QuantLib {
             std::string name() const override;
             bool isWeekend(Weekday) const override;
             bool isBusinessDay(const Date&) const override;
+            std::vector<Calendar> underlyingCalendars() const override;
 
           private:
             JointCalendarRule rule_;
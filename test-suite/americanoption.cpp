@@ -22,10 +22,13 @@
 #include "americanoption.hpp"
 #include "utilities.hpp"
 #include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/baroneadesiwhaleyengine.hpp>
 #include <ql/pricingengines/vanilla/bjerksundstenslandengine.hpp>
 #include <ql/pricingengines/vanilla/juquadraticengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesbatchengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesshoutengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -902,6 +905,205 @@ void AmericanOptionTest::testTodayIsDividendDate() {
     }
 }
 
+void AmericanOptionTest::testFdBatchEngine() {
+    BOOST_TEST_MESSAGE("Testing batch finite-difference pricing "
+                       "of American and European options...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(22, March, 2021);
+    Settings::instance().evaluationDate() = today;
+
+    const ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)));
+
+    const Real strikes[] = { 80.0, 90.0, 95.0, 100.0, 105.0, 110.0, 120.0 };
+    const Period maturities[] = { Period(3, Months), Period(1, Years) };
+    const Option::Type types[] = { Option::Put, Option::Call };
+
+    std::vector<ext::shared_ptr<VanillaOption> > options;
+    for (Real strike : strikes) {
+        for (const Period& maturity : maturities) {
+            for (Option::Type type : types) {
+                const ext::shared_ptr<StrikedTypePayoff> payoff =
+                    ext::make_shared<PlainVanillaPayoff>(type, strike);
+                options.push_back(ext::make_shared<VanillaOption>(
+                    payoff, ext::make_shared<AmericanExercise>(
+                                              today, today + maturity)));
+                options.push_back(ext::make_shared<VanillaOption>(
+                    payoff, ext::make_shared<EuropeanExercise>(
+                                                       today + maturity)));
+            }
+        }
+    }
+
+    const Size tGrid = 200, xGrid = 400;
+    const std::vector<OneAssetOption::results> results =
+        FdBlackScholesBatchEngine(process, tGrid, xGrid).calculate(options);
+
+    BOOST_CHECK_EQUAL(results.size(), options.size());
+
+    const ext::shared_ptr<PricingEngine> fdEngine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(process, tGrid, xGrid);
+    const ext::shared_ptr<PricingEngine> analyticEngine =
+        ext::make_shared<AnalyticEuropeanEngine>(process);
+
+    std::map<std::string,Real> tolerance;
+    tolerance["value"] = 5.0e-3;
+    tolerance["delta"] = 5.0e-4;
+    tolerance["gamma"] = 5.0e-4;
+    tolerance["theta"] = 5.0e-3;
+
+    for (Size k=0; k < options.size(); ++k) {
+        VanillaOption& option = *options[k];
+
+        option.setPricingEngine(fdEngine);
+        std::map<std::string,Real> calculated, expected;
+        calculated["value"] = results[k].value;
+        calculated["delta"] = results[k].delta;
+        calculated["gamma"] = results[k].gamma;
+        calculated["theta"] = results[k].theta;
+        expected["value"] = option.NPV();
+        expected["delta"] = option.delta();
+        expected["gamma"] = option.gamma();
+        expected["theta"] = option.theta();
+
+        if (option.exercise()->type() == Exercise::European) {
+            option.setPricingEngine(analyticEngine);
+            const Real error = std::fabs(results[k].value - option.NPV());
+            if (error > 1e-2)
+                BOOST_ERROR("failed to reproduce European option value"
+                            << "\n    strike:     "
+                            << options[k]->payoff()->description()
+                            << "\n    calculated: " << results[k].value
+                            << "\n    expected:   " << option.NPV()
+                            << "\n    error:      " << error);
+        }
+
+        for (const auto& it : calculated) {
+            const std::string greek = it.first;
+            const Real error = std::fabs(it.second - expected[greek]);
+            if (error > tolerance[greek])
+                BOOST_ERROR("batch and single-option engines differ"
+                            << "\n    option:     "
+                            << options[k]->payoff()->description()
+                            << (options[k]->exercise()->type()
+                                == Exercise::American ?
+                                " American" : " European")
+                            << ", expiry "
+                            << options[k]->exercise()->lastDate()
+                            << "\n    " << greek << ":"
+                            << std::string(11-greek.size(), ' ')
+                            << it.second
+                            << "\n    expected:   " << expected[greek]
+                            << "\n    error:      " << error);
+        }
+    }
+}
+
+void AmericanOptionTest::testFdSolverCaching() {
+    BOOST_TEST_MESSAGE("Testing cached finite-difference solver "
+                       "for American options...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(22, March, 2021);
+    Settings::instance().evaluationDate() = today;
+
+    const ext::shared_ptr<SimpleQuote> spot =
+        ext::make_shared<SimpleQuote>(100.0);
+    const ext::shared_ptr<SimpleQuote> rRate =
+        ext::make_shared<SimpleQuote>(0.05);
+    const ext::shared_ptr<SimpleQuote> vol =
+        ext::make_shared<SimpleQuote>(0.25);
+
+    const ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(flatRate(0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(rRate, dc)),
+            Handle<BlackVolTermStructure>(flatVol(vol, dc)));
+
+    const ext::shared_ptr<FdBlackScholesVanillaEngine> cachingEngine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(process, 100, 200);
+    cachingEngine->enableSolverCaching();
+    const ext::shared_ptr<PricingEngine> fdEngine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(process, 100, 200);
+
+    const ext::shared_ptr<StrikedTypePayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 105.0);
+    const ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<AmericanExercise>(today, today + Period(1, Years));
+
+    VanillaOption cached(payoff, exercise), option(payoff, exercise);
+    cached.setPricingEngine(cachingEngine);
+    option.setPricingEngine(fdEngine);
+
+    const Real initialValue = cached.NPV();
+    if (std::fabs(initialValue - option.NPV()) > 1e-12)
+        BOOST_ERROR("failed to reproduce the value of the uncached engine"
+                    << "\n    cached:   " << initialValue
+                    << "\n    uncached: " << option.NPV());
+
+    // bumps of the market quotes keep the grid but update the
+    // operator; the values are close to the ones on a new grid
+    const ext::shared_ptr<SimpleQuote> quotes[] = { spot, rRate, vol };
+    const Real bumps[] = { 0.5, 0.001, 0.01 };
+    const std::string names[] = { "spot", "rate", "volatility" };
+
+    for (Size i=0; i < LENGTH(bumps); ++i) {
+        const Real value = quotes[i]->value();
+        quotes[i]->setValue(value + bumps[i]);
+
+        const Real calculated = cached.NPV();
+        const Real expected = option.NPV();
+        if (std::fabs(calculated - expected) > 2e-3)
+            BOOST_ERROR("failed to reproduce the value after a bump"
+                        << "\n    quote:      " << names[i]
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+        if (calculated == initialValue)
+            BOOST_ERROR("cached engine ignored a bump"
+                        << "\n    quote:  " << names[i]
+                        << "\n    before: " << initialValue
+                        << "\n    after:  " << calculated);
+
+        quotes[i]->setValue(value);
+        if (std::fabs(cached.NPV() - initialValue) > 1e-12)
+            BOOST_ERROR("failed to reproduce the initial value "
+                        "after undoing a bump"
+                        << "\n    quote:      " << names[i]
+                        << "\n    calculated: " << cached.NPV()
+                        << "\n    expected:   " << initialValue);
+    }
+
+    // a different option needs a new grid
+    const ext::shared_ptr<StrikedTypePayoff> callPayoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 95.0);
+    VanillaOption cachedCall(callPayoff, exercise), call(callPayoff, exercise);
+    cachedCall.setPricingEngine(cachingEngine);
+    call.setPricingEngine(fdEngine);
+    if (std::fabs(cachedCall.NPV() - call.NPV()) > 1e-12)
+        BOOST_ERROR("failed to reproduce the value of the uncached engine "
+                    "for a new option"
+                    << "\n    cached:   " << cachedCall.NPV()
+                    << "\n    uncached: " << call.NPV());
+
+    // as does a new evaluation date
+    Settings::instance().evaluationDate() = today + 1;
+    if (std::fabs(cachedCall.NPV() - call.NPV()) > 1e-12)
+        BOOST_ERROR("failed to reproduce the value of the uncached engine "
+                    "for a new evaluation date"
+                    << "\n    cached:   " << cachedCall.NPV()
+                    << "\n    uncached: " << call.NPV());
+}
+
 test_suite* AmericanOptionTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("American option tests");
 
@@ -915,6 +1117,8 @@ test_suite* AmericanOptionTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testLargeDividendShoutNPV));
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testEscrowedVsSpotAmericanOption));
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testTodayIsDividendDate));
+    suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdBatchEngine));
+    suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdSolverCaching));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdShoutGreeks));
@@ -41,6 +41,8 @@ class AmericanOptionTest {
     static void testLargeDividendShoutNPV();
     static void testEscrowedVsSpotAmericanOption();
     static void testTodayIsDividendDate();
+    static void testFdBatchEngine();
+    static void testFdSolverCaching();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
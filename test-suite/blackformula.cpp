@@ -24,7 +24,10 @@
 #include "blackformula.hpp"
 #include "utilities.hpp"
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/blackcalculator.hpp>
+#include <ql/pricingengines/batchblackformula.hpp>
 #include <cmath>
+#include <iomanip>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -434,6 +437,196 @@ void BlackFormulaTest::testBachelierBlackFormulaForwardDerivativeWithZeroVolatil
     assertBachelierBlackFormulaForwardDerivative(Option::Put, strikes, vol);
 }
 
+void BlackFormulaTest::testBatchBlackFormula() {
+
+    BOOST_TEST_MESSAGE("Testing the Black formula over arrays of options...");
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 0.0, 50.0, 80.0, 95.0, 99.9, 100.0, 100.1,
+                       105.0, 120.0, 150.0, 300.0 };
+    Real forwards[] = { 100.0, 10.0, 1000.0 };
+    Real vols[] = { 0.0, 0.01, 0.1, 0.25, 0.5, 1.0, 2.0 };
+    Time maturities[] = { 0.0, 1.0/365, 0.25, 1.0, 5.0, 30.0 };
+    Rate rate = 0.03;
+    Real spot = 95.0;
+
+    std::vector<Option::Type> type;
+    std::vector<Real> strike, forward, stdDev, discount, spots;
+    std::vector<Time> maturity;
+    for (auto t : types) {
+        for (Real k : strikes) {
+            for (Real f : forwards) {
+                for (Real v : vols) {
+                    for (Time m : maturities) {
+                        type.push_back(t);
+                        // strikes are scaled with the forward
+                        strike.push_back(k*f/100.0);
+                        forward.push_back(f);
+                        stdDev.push_back(v*std::sqrt(m));
+                        discount.push_back(std::exp(-rate*m));
+                        spots.push_back(spot*f/100.0);
+                        maturity.push_back(m);
+                    }
+                }
+            }
+        }
+    }
+    const Size n = type.size();
+
+    std::vector<Real> value(n), deltaForward(n), gammaForward(n),
+        strikeSensitivity(n), itmCash(n), itmAsset(n), delta(n), gamma(n),
+        theta(n), vega(n), rho(n), dividendRho(n), values(n);
+    BlackGreeks results;
+    results.value = &value[0];
+    results.deltaForward = &deltaForward[0];
+    results.gammaForward = &gammaForward[0];
+    results.strikeSensitivity = &strikeSensitivity[0];
+    results.itmCashProbability = &itmCash[0];
+    results.itmAssetProbability = &itmAsset[0];
+    results.delta = &delta[0];
+    results.gamma = &gamma[0];
+    results.theta = &theta[0];
+    results.vega = &vega[0];
+    results.rho = &rho[0];
+    results.dividendRho = &dividendRho[0];
+
+    blackFormulaGreeks(&type[0], &strike[0], &forward[0], &stdDev[0],
+                       &discount[0], &spots[0], &maturity[0], results, n);
+    // the values alone are also calculated over several threads
+    blackFormula(&type[0], &strike[0], &forward[0], &stdDev[0],
+                 &discount[0], &values[0], n, 4);
+
+    const Real tolerance = 1.0e-12;
+    auto check = [&](Size i, const std::string& greek,
+                     Real calculated, Real expected) {
+        // NaN results (e.g., vega for null volatilities) must match too
+        if (std::isnan(expected) && std::isnan(calculated))
+            return;
+        // deep in the tails, BlackCalculator loses a few digits by
+        // cancellation; errors are measured against the forward
+        if (!(std::fabs(calculated-expected)
+              <= tolerance*std::max(forward[i], std::fabs(expected))))
+            BOOST_ERROR("batch " << greek << " mismatch for "
+                        << (type[i] == Option::Call ? "call" : "put")
+                        << std::setprecision(16)
+                        << "\n    strike:     " << strike[i]
+                        << "\n    forward:    " << forward[i]
+                        << "\n    std. dev.:  " << stdDev[i]
+                        << "\n    maturity:   " << maturity[i]
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    };
+
+    for (Size i=0; i<n; ++i) {
+        BlackCalculator black(type[i], strike[i], forward[i],
+                              stdDev[i], discount[i]);
+        check(i, "value", value[i], black.value());
+        check(i, "value", values[i],
+              blackFormula(type[i], strike[i], forward[i],
+                           stdDev[i], discount[i]));
+        check(i, "forward delta", deltaForward[i], black.deltaForward());
+        check(i, "forward gamma", gammaForward[i], black.gammaForward());
+        check(i, "strike sensitivity", strikeSensitivity[i],
+              black.strikeSensitivity());
+        check(i, "itm cash probability", itmCash[i],
+              black.itmCashProbability());
+        check(i, "itm asset probability", itmAsset[i],
+              black.itmAssetProbability());
+        check(i, "delta", delta[i], black.delta(spots[i]));
+        check(i, "gamma", gamma[i], black.gamma(spots[i]));
+        check(i, "theta", theta[i], black.theta(spots[i], maturity[i]));
+        check(i, "vega", vega[i], black.vega(maturity[i]));
+        check(i, "rho", rho[i], black.rho(maturity[i]));
+        check(i, "dividend rho", dividendRho[i],
+              black.dividendRho(maturity[i]));
+    }
+}
+
+void BlackFormulaTest::testBatchImpliedStdDev() {
+
+    BOOST_TEST_MESSAGE("Testing the implied standard deviation over "
+                       "arrays of quotes...");
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real moneyness[] = { 0.5, 0.7, 0.9, 0.99, 1.0, 1.01, 1.1, 1.5, 2.0 };
+    Real vols[] = { 0.05, 0.1, 0.2, 0.4, 0.8 };
+    Time maturities[] = { 0.1, 0.5, 1.0, 3.0, 10.0 };
+    Real forward = 100.0;
+    Rate rate = 0.02;
+
+    std::vector<Option::Type> type;
+    std::vector<Real> strike, forwards, stdDev, discount, price;
+    for (auto t : types) {
+        for (Real m : moneyness) {
+            for (Real v : vols) {
+                for (Time T : maturities) {
+                    Real s = v*std::sqrt(T), D = std::exp(-rate*T);
+                    // skip prices too small to determine the volatility
+                    Real otmPrice = blackFormula(
+                        m < 1.0 ? Option::Put : Option::Call,
+                        m*forward, forward, s);
+                    if (otmPrice < 1.0e-8*forward)
+                        continue;
+                    type.push_back(t);
+                    strike.push_back(m*forward);
+                    forwards.push_back(forward);
+                    stdDev.push_back(s);
+                    discount.push_back(D);
+                    price.push_back(blackFormula(t, m*forward, forward, s, D));
+                }
+            }
+        }
+    }
+
+    // invalid or inconsistent quotes, and a null price
+    type.push_back(Option::Call);
+    strike.push_back(90.0); forwards.push_back(-100.0); price.push_back(10.0);
+    type.push_back(Option::Call);
+    strike.push_back(90.0); forwards.push_back(forward); price.push_back(9.0);
+    type.push_back(Option::Put);
+    strike.push_back(90.0); forwards.push_back(forward); price.push_back(90.0);
+    type.push_back(Option::Put);
+    strike.push_back(90.0); forwards.push_back(forward); price.push_back(0.0);
+    BlackImpliedStdDevStatus::Code expectedStatus[] = {
+        BlackImpliedStdDevStatus::InvalidInput,
+        BlackImpliedStdDevStatus::BelowIntrinsicValue,
+        BlackImpliedStdDevStatus::AboveMaximumValue,
+        BlackImpliedStdDevStatus::Success
+    };
+    const Size nValid = stdDev.size(), n = type.size();
+    stdDev.resize(n, Null<Real>());
+    stdDev.back() = 0.0;
+    discount.resize(n, 1.0);
+
+    std::vector<Real> implied(n);
+    std::vector<BlackImpliedStdDevStatus::Code> status(n);
+    blackFormulaImpliedStdDev(&type[0], &strike[0], &forwards[0], &price[0],
+                              &discount[0], &implied[0], &status[0], n);
+
+    const Real tolerance = 1.0e-10;
+    for (Size i=0; i<n; ++i) {
+        BlackImpliedStdDevStatus::Code expected =
+            i < nValid ? BlackImpliedStdDevStatus::Success
+                       : expectedStatus[i-nValid];
+        if (status[i] != expected)
+            BOOST_ERROR("unexpected status for quote #" << i
+                        << "\n    strike:   " << strike[i]
+                        << "\n    forward:  " << forwards[i]
+                        << "\n    price:    " << price[i]
+                        << "\n    status:   " << status[i]
+                        << "\n    expected: " << expected);
+        else if (stdDev[i] == Null<Real>() ? implied[i] != Null<Real>()
+                 : std::fabs(implied[i]-stdDev[i]) > tolerance)
+            BOOST_ERROR("failed to calculate implied std dev for "
+                        << (type[i] == Option::Call ? "call" : "put")
+                        << std::setprecision(16)
+                        << "\n    strike:     " << strike[i]
+                        << "\n    price:      " << price[i]
+                        << "\n    calculated: " << implied[i]
+                        << "\n    expected:   " << stdDev[i]);
+    }
+}
+
 test_suite* BlackFormulaTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Black formula tests");
 
@@ -457,6 +650,10 @@ test_suite* BlackFormulaTest::suite() {
         &BlackFormulaTest::testBachelierBlackFormulaForwardDerivative));
     suite->add(QUANTLIB_TEST_CASE(
         &BlackFormulaTest::testBachelierBlackFormulaForwardDerivativeWithZeroVolatility));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testBatchBlackFormula));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testBatchImpliedStdDev));
 
     return suite;
 }
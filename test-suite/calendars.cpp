@@ -2137,6 +2137,122 @@ void CalendarTest::testDayLists() {
     }
 }
 
+namespace calendars_test {
+
+    struct CalendarResults {
+        std::vector<bool> businessDays;
+        std::vector<Date> advanced;
+        std::vector<Date::serial_type> between;
+    };
+
+    CalendarResults calendarResults(const Calendar& c,
+                                    const Date& from, const Date& to) {
+        static const Integer steps[] = { -300, -40, -3, -1, 1, 2, 10, 300 };
+        CalendarResults results;
+        for (Date d = from; d <= to; ++d)
+            results.businessDays.push_back(c.isBusinessDay(d));
+        for (Date d = from; d <= to; d += 5) {
+            for (Integer n : steps) {
+                results.advanced.push_back(c.advance(d, n, Days));
+                results.between.push_back(
+                    c.businessDaysBetween(d, d + 7*n));
+                results.between.push_back(
+                    c.businessDaysBetween(d, d + n, false, true));
+            }
+        }
+        return results;
+    }
+
+    void checkCachedResults(const Calendar& c,
+                            const CalendarResults& expected,
+                            const CalendarResults& calculated) {
+        if (calculated.businessDays != expected.businessDays)
+            BOOST_ERROR("business days not reproduced with cache for "
+                        << c.name());
+        if (calculated.advanced != expected.advanced)
+            BOOST_ERROR("advanced dates not reproduced with cache for "
+                        << c.name());
+        if (calculated.between != expected.between)
+            BOOST_ERROR("business days between dates not reproduced "
+                        "with cache for " << c.name());
+    }
+
+}
+
+void CalendarTest::testBusinessDayCache() {
+
+    BOOST_TEST_MESSAGE("Testing business-day cache...");
+
+    using namespace calendars_test;
+
+    Calendar target = TARGET(), uk = UnitedKingdom(),
+             nyse = UnitedStates(UnitedStates::NYSE);
+    Calendar calendars[] = {
+        target, uk,
+        JointCalendar(target, nyse, JoinHolidays),
+        JointCalendar(target, uk, nyse, JoinBusinessDays)
+    };
+
+    // the results are also checked across the bounds of the cache
+    Date cacheStart(1, January, 2020), cacheEnd(31, December, 2024);
+    Date from(1, July, 2018), to(30, June, 2026);
+
+    for (auto& c : calendars) {
+        CalendarResults expected = calendarResults(c, from, to);
+        c.cacheBusinessDays(cacheStart, cacheEnd);
+        if (!c.hasBusinessDayCache(cacheStart)
+            || !c.hasBusinessDayCache(cacheEnd)
+            || c.hasBusinessDayCache(cacheEnd + 1))
+            BOOST_ERROR("wrong cache range for " << c.name());
+        checkCachedResults(c, expected, calendarResults(c, from, to));
+    }
+
+    // holidays added to or removed from a cached calendar
+    Date holiday(5, March, 2021), businessDay(1, May, 2023);
+    target.addHoliday(holiday);
+    target.removeHoliday(businessDay);
+    if (target.isBusinessDay(holiday) || target.isHoliday(businessDay))
+        BOOST_ERROR("cache not updated for added or removed holidays");
+    for (auto& c : calendars) {
+        CalendarResults calculated = calendarResults(c, from, to);
+        c.clearBusinessDayCache();
+        checkCachedResults(c, calendarResults(c, from, to), calculated);
+    }
+
+    // the caches of joint calendars are not used after their
+    // underlying calendars are modified
+    for (auto& c : calendars)
+        c.cacheBusinessDays(cacheStart, cacheEnd);
+    target.addHoliday(businessDay);
+    if (calendars[2].hasBusinessDayCache(holiday))
+        BOOST_ERROR("cache of " << calendars[2].name()
+                    << " used after changes to its underlying calendars");
+    for (auto& c : calendars) {
+        CalendarResults calculated = calendarResults(c, from, to);
+        c.clearBusinessDayCache();
+        checkCachedResults(c, calendarResults(c, from, to), calculated);
+    }
+
+    target.removeHoliday(holiday);
+
+    // weekend days added to a cached bespoke calendar
+    BespokeCalendar bespoke;
+    bespoke.addWeekend(Sunday);
+    Calendar joint = JointCalendar(bespoke, uk, JoinHolidays);
+    bespoke.cacheBusinessDays(cacheStart, cacheEnd);
+    joint.cacheBusinessDays(cacheStart, cacheEnd);
+    Date saturday(6, March, 2021);
+    if (!bespoke.isBusinessDay(saturday))
+        BOOST_ERROR("wrong cached result for bespoke calendar");
+    bespoke.addWeekend(Saturday);
+    if (bespoke.hasBusinessDayCache(saturday)
+        || joint.hasBusinessDayCache(saturday))
+        BOOST_ERROR("cache used after weekend days were added "
+                    "to a bespoke calendar");
+    if (bespoke.isBusinessDay(saturday))
+        BOOST_ERROR("added weekend day not used by bespoke calendar");
+}
+
 test_suite* CalendarTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Calendar tests");
 
@@ -2176,6 +2292,7 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testIntradayAddHolidays));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testDayLists));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDayCache));
 
     return suite;
 }
@@ -20,6 +20,7 @@
 #include "cashflows.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/flatleg.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
@@ -32,7 +33,16 @@
 #include <ql/time/schedule.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
+#include <ql/instruments/bond.hpp>
+#include <ql/instruments/swap.hpp>
+#include <ql/pricingengines/bond/discountingbondengine.hpp>
+#include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/settings.hpp>
+#include <iomanip>
 
 
 using namespace QuantLib;
@@ -504,6 +514,144 @@ void CashFlowsTest::testPartialScheduleLegConstruction() {
     BOOST_CHECK_EQUAL(lastCpnF3->referencePeriodEnd(), Date(30, Sep, 2020));
 }
 
+void CashFlowsTest::testFlatLeg() {
+
+    BOOST_TEST_MESSAGE("Testing compiled legs against cash-flow analysis...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Calendar calendar = TARGET();
+    Date today = calendar.adjust(Date::todaysDate());
+    Settings::instance().evaluationDate() = today;
+
+    Handle<YieldTermStructure> forwardingCurve(
+        ext::make_shared<FlatForward>(today, 0.03, Actual360()));
+    Handle<YieldTermStructure> discountCurve(
+        ext::make_shared<FlatForward>(today, 0.025, Actual365Fixed()));
+    ext::shared_ptr<IborIndex> index =
+        ext::make_shared<Euribor6M>(forwardingCurve);
+
+    // the first coupon was fixed in the past
+    Schedule schedule = MakeSchedule()
+                            .from(today - 3 * Months)
+                            .to(today + 10 * Years)
+                            .withFrequency(Semiannual)
+                            .withCalendar(calendar)
+                            .withConvention(ModifiedFollowing)
+                            .forwards();
+    Date firstFixing = index->fixingCalendar().advance(
+        schedule.startDate(), -static_cast<Integer>(index->fixingDays()),
+        Days, Preceding);
+    index->addFixing(firstFixing, 0.021);
+
+    Leg floatingLeg = IborLeg(schedule, index)
+                          .withNotionals(100.0)
+                          .withGearings(1.1)
+                          .withSpreads(0.001);
+    Leg fixedLeg = FixedRateLeg(schedule)
+                       .withNotionals(100.0)
+                       .withCouponRates(0.03, Thirty360(Thirty360::BondBasis));
+    fixedLeg.push_back(
+        ext::make_shared<Redemption>(100.0, fixedLeg.back()->date()));
+    Leg inArrearsLeg = IborLeg(schedule, index)
+                           .withNotionals(100.0)
+                           .inArrears();
+    Handle<OptionletVolatilityStructure> volatility(
+        ext::make_shared<ConstantOptionletVolatility>(
+            0, calendar, ModifiedFollowing, 0.2, Actual365Fixed()));
+    setCouponPricer(inArrearsLeg,
+                    ext::make_shared<BlackIborCouponPricer>(volatility));
+
+    struct test_case {
+        const char* name;
+        Leg leg;
+        Size compiled;
+    };
+    test_case cases[] = {
+        { "floating leg", floatingLeg, floatingLeg.size() },
+        { "fixed leg", fixedLeg, 0 },
+        { "in-arrears floating leg", inArrearsLeg, 0 }
+    };
+
+    Date settlementDates[] = { today, schedule[1], schedule[1] + 1 };
+    bool includeFlows[] = { true, false };
+
+    for (auto& c : cases) {
+        FlatLeg flatLeg(c.leg);
+        if (flatLeg.compiledCoupons() != c.compiled)
+            BOOST_ERROR("unexpected number of compiled coupons for "
+                        << c.name << ": " << flatLeg.compiledCoupons()
+                        << " (" << c.compiled << " expected)");
+        if (flatLeg.startDate() != CashFlows::startDate(c.leg)
+            || flatLeg.maturityDate() != CashFlows::maturityDate(c.leg))
+            BOOST_ERROR("failed to reproduce start and maturity dates for "
+                        << c.name);
+        for (auto settlementDate : settlementDates) {
+            for (auto include : includeFlows) {
+                Real npv, bps, expectedNPV, expectedBPS;
+                flatLeg.npvbps(**discountCurve, include,
+                               settlementDate, settlementDate, npv, bps);
+                expectedBPS = 0.0;
+                CashFlows::npvbps(c.leg, **discountCurve, include,
+                                  settlementDate, settlementDate,
+                                  expectedNPV, expectedBPS);
+                if (std::fabs(npv - expectedNPV) > 1.0e-10
+                    || std::fabs(bps - expectedBPS) > 1.0e-12)
+                    BOOST_ERROR("failed to reproduce npv and bps for "
+                                << c.name << std::setprecision(12)
+                                << "\n    settlement date: " << settlementDate
+                                << "\n    include flows:   " << include
+                                << "\n    npv:             " << npv
+                                << "\n    expected npv:    " << expectedNPV
+                                << "\n    bps:             " << bps
+                                << "\n    expected bps:    " << expectedBPS);
+            }
+        }
+    }
+
+    // a pricer requiring a convexity adjustment is detected
+    FlatLeg flatLeg(floatingLeg);
+    Real npv = flatLeg.npv(**discountCurve, false);
+    setCouponPricer(floatingLeg,
+                    ext::make_shared<BlackIborCouponPricer>(
+                        volatility, BlackIborCouponPricer::BivariateLognormal));
+    if (flatLeg.compiledCoupons() != 0)
+        BOOST_ERROR("coupons with convexity adjustment still compiled");
+    Real expected = CashFlows::npv(floatingLeg, **discountCurve, false);
+    if (std::fabs(flatLeg.npv(**discountCurve, false) - expected) > 1.0e-10)
+        BOOST_ERROR("failed to follow change of pricer"
+                    << std::setprecision(12)
+                    << "\n    npv:          " << flatLeg.npv(**discountCurve,
+                                                               false)
+                    << "\n    expected npv: " << expected
+                    << "\n    previous npv: " << npv);
+
+    // swaps and bonds use the compiled legs
+    Swap swap(fixedLeg, inArrearsLeg);
+    swap.setPricingEngine(
+        ext::make_shared<DiscountingSwapEngine>(discountCurve));
+    Real expectedSwapNPV =
+        CashFlows::npv(inArrearsLeg, **discountCurve, false)
+        - CashFlows::npv(fixedLeg, **discountCurve, false);
+    if (std::fabs(swap.NPV() - expectedSwapNPV) > 1.0e-10)
+        BOOST_ERROR("failed to reproduce swap npv"
+                    << std::setprecision(12)
+                    << "\n    npv:          " << swap.NPV()
+                    << "\n    expected npv: " << expectedSwapNPV);
+
+    Bond bond(0, calendar, schedule.startDate(), floatingLeg);
+    bond.setPricingEngine(
+        ext::make_shared<DiscountingBondEngine>(discountCurve));
+    Real expectedBondNPV = CashFlows::npv(bond.cashflows(), **discountCurve,
+                                          false, today, today);
+    if (std::fabs(bond.NPV() - expectedBondNPV) > 1.0e-10)
+        BOOST_ERROR("failed to reproduce bond npv"
+                    << std::setprecision(12)
+                    << "\n    npv:          " << bond.NPV()
+                    << "\n    expected npv: " << expectedBondNPV);
+}
+
 test_suite* CashFlowsTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
@@ -519,5 +667,6 @@ test_suite* CashFlowsTest::suite() {
                              &CashFlowsTest::testIrregularLastCouponReferenceDatesAtEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(
                              &CashFlowsTest::testPartialScheduleLegConstruction));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testFlatLeg));
     return suite;
 }
@@ -32,6 +32,7 @@ class CashFlowsTest {
     static void testIrregularFirstCouponReferenceDatesAtEndOfMonth();
     static void testIrregularLastCouponReferenceDatesAtEndOfMonth();
     static void testPartialScheduleLegConstruction();
+    static void testFlatLeg();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -753,6 +753,38 @@ void DistributionTest::testSankaranApproximation() {
     }
 }
 
+void DistributionTest::testInverseCumulativeNormalBatch() {
+    BOOST_TEST_MESSAGE("Testing batch inverse cumulative normal...");
+
+    // uneven size to exercise any vectorization remainder; the
+    // values cover both tails and the central region
+    const Size n = 1001;
+    std::vector<Real> x(n), y(n);
+    for (Size i=0; i<n; ++i)
+        x[i] = (i + 0.5)/n;
+    x[0] = 1.0e-12;
+    x[n-1] = 1.0 - 1.0e-12;
+
+    const Real averages[] = { 0.0, 1.5 };
+    const Real sigmas[] = { 1.0, 0.3 };
+    for (Size k=0; k<LENGTH(averages); ++k) {
+        const InverseCumulativeNormal invCum(averages[k], sigmas[k]);
+        invCum(&x[0], &y[0], n);
+        for (Size i=0; i<n; ++i) {
+            const Real expected = invCum(x[i]);
+            if (std::fabs(y[i] - expected) > 1.0e-14*(1.0+std::fabs(expected)))
+                BOOST_ERROR("batch inverse cumulative normal differs from "
+                            "scalar version:"
+                            << std::setprecision(16)
+                            << "\n    average:    " << averages[k]
+                            << "\n    sigma:      " << sigmas[k]
+                            << "\n    x:          " << x[i]
+                            << "\n    calculated: " << y[i]
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
 test_suite* DistributionTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Distribution tests");
 
@@ -764,6 +796,7 @@ test_suite* DistributionTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testBivariateCumulativeStudent));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testInvCDFviaStochasticCollocation));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testSankaranApproximation));
+    suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testInverseCumulativeNormalBatch));
 
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testBivariateCumulativeStudentVsBivariate));
@@ -31,6 +31,7 @@
 #include <ql/pricingengines/vanilla/binomialengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/experimental/variancegamma/fftvanillaengine.hpp>
+#include <ql/experimental/math/zigguratrng.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/integralengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -1744,6 +1745,106 @@ void EuropeanOptionTest::testDouglasVsCrankNicolson() {
     }
 }
 
+void EuropeanOptionTest::testMultithreadedMcEngine() {
+    BOOST_TEST_MESSAGE("Testing multithreaded Monte Carlo European engine...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(5, October, 2018);
+
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(ext::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    const Handle<BlackVolTermStructure> volTS(flatVol(today, 0.25, dc));
+
+    const ext::shared_ptr<BlackScholesMertonProcess> process =
+        ext::make_shared<BlackScholesMertonProcess>(
+            spot, qTS, rTS, volTS);
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 105.0),
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    option.setPricingEngine(
+        ext::make_shared<AnalyticEuropeanEngine>(process));
+    const Real expected = option.NPV();
+
+    const Size samples = 20001;
+    const BigNatural seed = 42;
+
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(4)
+                            .withAntitheticVariate()
+                            .withSamples(samples)
+                            .withSeed(seed));
+    const Real serial = option.NPV();
+
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(4)
+                            .withAntitheticVariate()
+                            .withSamples(samples)
+                            .withSeed(seed)
+                            .withThreads(1));
+    const Real singleThread = option.NPV();
+
+    if (singleThread != serial)
+        BOOST_FAIL("single-threaded engine does not reproduce "
+                   "the serial result"
+                   << std::fixed << std::setprecision(12)
+                   << "\n    serial:          " << serial
+                   << "\n    single-threaded: " << singleThread);
+
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(4)
+                            .withAntitheticVariate()
+                            .withSamples(samples)
+                            .withSeed(seed)
+                            .withThreads(4));
+    const Real parallel = option.NPV();
+    const Real error = option.errorEstimate();
+
+    option.recalculate();
+    const Real repeated = option.NPV();
+
+    if (repeated != parallel)
+        BOOST_FAIL("multithreaded engine is not reproducible"
+                   << std::fixed << std::setprecision(12)
+                   << "\n    first run:  " << parallel
+                   << "\n    second run: " << repeated);
+
+    if (std::fabs(parallel - expected) > 3.0*error)
+        BOOST_FAIL("multithreaded engine failed to reproduce "
+                   "analytic value"
+                   << std::fixed << std::setprecision(6)
+                   << "\n    analytic:       " << expected
+                   << "\n    calculated:     " << parallel
+                   << "\n    error estimate: " << error);
+
+    // traits without independent streams fall back to serial sampling
+    option.setPricingEngine(MakeMCEuropeanEngine<Ziggurat>(process)
+                            .withSteps(4)
+                            .withSamples(samples)
+                            .withSeed(seed));
+    const Real zigguratSerial = option.NPV();
+
+    option.setPricingEngine(MakeMCEuropeanEngine<Ziggurat>(process)
+                            .withSteps(4)
+                            .withSamples(samples)
+                            .withSeed(seed)
+                            .withThreads(4));
+    const Real zigguratParallel = option.NPV();
+
+    if (zigguratParallel != zigguratSerial)
+        BOOST_FAIL("engine without independent streams does not "
+                   "reproduce the serial result"
+                   << std::fixed << std::setprecision(12)
+                   << "\n    serial:          " << zigguratSerial
+                   << "\n    multithreaded:   " << zigguratParallel);
+}
+
 test_suite* EuropeanOptionTest::suite() {
     auto* suite = BOOST_TEST_SUITE("European option tests");
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testValues));
@@ -1765,6 +1866,8 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testFdEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
+    suite->add(QUANTLIB_TEST_CASE(
+        &EuropeanOptionTest::testMultithreadedMcEngine));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
 
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
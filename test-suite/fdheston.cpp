@@ -979,6 +979,144 @@ void FdHestonTest::testSpuriousOscillations() {
     }
 }
 
+void FdHestonTest::testMultithreadedAdiSchemes() {
+    BOOST_TEST_MESSAGE("Testing multithreaded ADI schemes "
+                       "for the Heston PDE...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(7, June, 2018);
+
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(ext::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+
+    const ext::shared_ptr<HestonProcess> process =
+        ext::make_shared<HestonProcess>(
+            rTS, qTS, spot, 0.04, 2.5, 0.04, 0.66, -0.8);
+
+    const ext::shared_ptr<FdHestonVanillaEngine> hestonEngine(
+        ext::make_shared<FdHestonVanillaEngine>(
+            ext::make_shared<HestonModel>(process), 20, 50, 25, 0));
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        ext::make_shared<AmericanExercise>(today + Period(1, Years)));
+
+    option.setupArguments(hestonEngine->getArguments());
+
+    const ext::tuple<FdmSchemeDesc, std::string> descs[] = {
+        ext::make_tuple(FdmSchemeDesc::Douglas(), "Douglas"),
+        ext::make_tuple(FdmSchemeDesc::CraigSneyd(), "Craig-Sneyd"),
+        ext::make_tuple(
+            FdmSchemeDesc::ModifiedCraigSneyd(), "Mod. Craig-Sneyd"),
+        ext::make_tuple(FdmSchemeDesc::Hundsdorfer(), "Hundsdorfer"),
+        ext::make_tuple(FdmSchemeDesc::TrBDF2(), "TR-BDF2")
+    };
+
+    for (const auto& desc : descs) {
+        const FdmSchemeDesc& serialDesc = ext::get<0>(desc);
+        const FdmSchemeDesc parallelDesc = serialDesc.withThreads(4);
+
+        const FdmHestonSolver serial(Handle<HestonProcess>(process),
+            hestonEngine->getSolverDesc(1.0), serialDesc);
+        const FdmHestonSolver parallel(Handle<HestonProcess>(process),
+            hestonEngine->getSolverDesc(1.0), parallelDesc);
+
+        for (Real s=80.0; s < 120.001; s+=10.0) {
+            const Real expected[] = { serial.valueAt(s, 0.04),
+                                      serial.deltaAt(s, 0.04),
+                                      serial.gammaAt(s, 0.04) };
+            const Real calculated[] = { parallel.valueAt(s, 0.04),
+                                        parallel.deltaAt(s, 0.04),
+                                        parallel.gammaAt(s, 0.04) };
+            for (Size i=0; i < 3; ++i) {
+                // the grid lines are solved as in the serial case
+                if (calculated[i] != expected[i]) {
+                    BOOST_ERROR("multithreaded result differs from "
+                                "serial one"
+                                << "\n   scheme    : " << ext::get<1>(desc)
+                                << "\n   spot      : " << s
+                                << std::setprecision(16)
+                                << "\n   serial    : " << expected[i]
+                                << "\n   threads   : " << calculated[i]);
+                }
+            }
+        }
+    }
+}
+
+void FdHestonTest::testSolverCaching() {
+    BOOST_TEST_MESSAGE("Testing cached FDM solver "
+                       "for changes of the Heston parameters...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(7, June, 2018);
+
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(ext::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+
+    const ext::shared_ptr<HestonModel> model =
+        ext::make_shared<HestonModel>(ext::make_shared<HestonProcess>(
+            rTS, qTS, spot, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    const ext::shared_ptr<FdHestonVanillaEngine> cachingEngine =
+        ext::make_shared<FdHestonVanillaEngine>(model, 50, 100, 50);
+    cachingEngine->enableSolverCaching();
+
+    const ext::shared_ptr<StrikedTypePayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0);
+    const ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<AmericanExercise>(today + Period(1, Years));
+
+    VanillaOption cached(payoff, exercise), option(payoff, exercise);
+    cached.setPricingEngine(cachingEngine);
+    option.setPricingEngine(
+        ext::make_shared<FdHestonVanillaEngine>(model, 50, 100, 50));
+
+    const Real initialValue = cached.NPV();
+    if (std::fabs(initialValue - option.NPV()) > 1e-12)
+        BOOST_ERROR("failed to reproduce the value of the uncached engine"
+                    << "\n    cached:   " << initialValue
+                    << "\n    uncached: " << option.NPV());
+
+    // parameters are theta, kappa, sigma, rho and v0; the grid is
+    // kept while the operator is built for the new parameters
+    const Array params = model->params();
+    for (Size i=0; i < params.size(); ++i) {
+        Array bumped = params;
+        bumped[i] += 0.01;
+        model->setParams(bumped);
+
+        const Real calculated = cached.NPV();
+        const Real expected = option.NPV();
+        if (std::fabs(calculated - expected) > 1e-2
+            || calculated == initialValue)
+            BOOST_ERROR("failed to reproduce the value after a change "
+                        "of the model parameters"
+                        << "\n    parameter:  " << i
+                        << "\n    initial:    " << initialValue
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+
+        model->setParams(params);
+        if (std::fabs(cached.NPV() - initialValue) > 1e-12)
+            BOOST_ERROR("failed to reproduce the initial value "
+                        "after undoing a change of the model parameters"
+                        << "\n    parameter:  " << i
+                        << "\n    calculated: " << cached.NPV()
+                        << "\n    expected:   " << initialValue);
+    }
+}
+
 test_suite* FdHestonTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Finite Difference Heston tests");
 
@@ -992,6 +1130,9 @@ test_suite* FdHestonTest::suite(SpeedLevel speed) {
         &FdHestonTest::testFdmHestonIntradayPricing));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testMethodOfLinesAndCN));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testSpuriousOscillations));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdHestonTest::testMultithreadedAdiSchemes));
+    suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testSolverCaching));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -40,6 +40,8 @@ public:
     static void testFdmHestonIntradayPricing();
     static void testMethodOfLinesAndCN();
     static void testSpuriousOscillations();
+    static void testMultithreadedAdiSchemes();
+    static void testSolverCaching();
 
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
@@ -44,6 +44,7 @@
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/meshers/uniformgridmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/uniform1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
@@ -52,11 +53,13 @@
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmmesherintegral.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmkrylovsolver.hpp>
 #include <ql/methods/finitedifferences/operators/numericaldifferentiation.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/operators/fdmhestonhullwhiteop.hpp>
+#include <ql/methods/finitedifferences/operators/fdm2dblackscholesop.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmhestonvariancemesher.hpp>
 #include <ql/methods/finitedifferences/operators/fdmhestonop.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
@@ -69,6 +72,7 @@
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
+#include <ql/experimental/finitedifferences/modtriplebandlinearop.hpp>
 #include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
 #include <ql/functional.hpp>
 
@@ -736,6 +740,76 @@ void FdmLinearOpTest::testTripleBandMapSolve() {
 }
 
 
+void FdmLinearOpTest::testTripleBandMapOnMultiDimLayout() {
+
+    BOOST_TEST_MESSAGE("Testing triple-band map in all directions "
+                       "of a three-dimensional layout...");
+
+    // the strides of the last two directions are smaller and
+    // larger than the number of lines solved together
+    const std::vector<Size> dim = {7, 45, 6};
+
+    const ext::shared_ptr<FdmLinearOpLayout> layout(
+        new FdmLinearOpLayout(dim));
+    const ext::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, {{0, 1.0}, {0, 1.0}, {0, 1.0}}));
+
+    Array u(layout->size());
+    for (Size i=0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    const Real tol = 1e-12;
+    const FdmLinearOpIterator endIter = layout->end();
+
+    for (Size d=0; d < dim.size(); ++d) {
+        ModTripleBandLinearOp op(d, mesher);
+        for (Size i=0; i < layout->size(); ++i) {
+            op.lower(i) = std::cos(0.3*i);
+            op.diag(i)  = 3.0 + std::sin(0.7*i);
+            op.upper(i) = std::sin(0.2*i) - 0.5;
+        }
+
+        // the neighbours of the points on the boundaries are reflected
+        const Array t = op.apply(u);
+        for (FdmLinearOpIterator iter = layout->begin();
+             iter != endIter; ++iter) {
+            const Size i = iter.index();
+            const Real expected =
+                  op.lower(i)*u[layout->neighbourhood(iter, d, -1)]
+                + op.diag(i)*u[i]
+                + op.upper(i)*u[layout->neighbourhood(iter, d, 1)];
+            if (std::fabs(t[i] - expected) > tol) {
+                BOOST_FAIL("failed to apply the triple-band map"
+                           << "\n direction     : " << d
+                           << "\n index         : " << i
+                           << "\n expected      : " << expected
+                           << "\n calculated    : " << t[i]);
+            }
+        }
+
+        for (FdmLinearOpIterator iter = layout->begin();
+             iter != endIter; ++iter) {
+            if (iter.coordinates()[d] == 0)
+                op.lower(iter.index()) = 0.0;
+            if (iter.coordinates()[d] == dim[d]-1)
+                op.upper(iter.index()) = 0.0;
+        }
+
+        const Real a = 0.75, b = 2.0;
+        const Array x = op.solve_splitting(u, a, b);
+        const Array r = b*x + a*op.apply(x);
+        for (Size i=0; i < u.size(); ++i) {
+            if (std::fabs(u[i] - r[i]) > tol) {
+                BOOST_FAIL("solve and apply are not consistent "
+                           << "\n direction     : " << d
+                           << "\n index         : " << i
+                           << "\n expected      : " << u[i]
+                           << "\n calculated    : " << r[i]);
+            }
+        }
+    }
+}
+
 void FdmLinearOpTest::testFdmHestonBarrier() {
 
     BOOST_TEST_MESSAGE("Testing FDM with barrier option in Heston model...");
@@ -1715,6 +1789,248 @@ void FdmLinearOpTest::testLowVolatilityHighDiscreteDividendBlackScholesMesher()
     }
 }
 
+void FdmLinearOpTest::testOutParameterOperators() {
+    BOOST_TEST_MESSAGE("Testing out-parameter versions of FDM operators...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const Time maturity = 2.0;
+    const std::vector<Size> dim = {21, 11, 11};
+
+    ext::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    const ext::shared_ptr<FdmMesher> mesher
+        = createSolverDesc(dim, jointProcess).mesher;
+
+    ext::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    ext::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    const ext::shared_ptr<FdmMesher> hestonMesher(
+        new UniformGridMesher(
+            ext::make_shared<FdmLinearOpLayout>(std::vector<Size>{30, 20}),
+            std::vector<std::pair<Real, Real> >{{3.8, 5.4}, {0.0, 1.0}}));
+
+    const std::vector<std::pair<ext::shared_ptr<FdmLinearOpComposite>,
+                                ext::shared_ptr<FdmMesher> > > ops = {
+        {ext::make_shared<FdmHestonOp>(hestonMesher,
+                                       jointProcess->hestonProcess()),
+         hestonMesher},
+        {ext::make_shared<FdmHestonHullWhiteOp>(mesher,
+                                                jointProcess->hestonProcess(),
+                                                hwProcess, jointProcess->eta()),
+         mesher}
+    };
+
+    const Real tol = 1e-10;
+    const Real a = -0.01;
+
+    for (const auto& p : ops) {
+        const ext::shared_ptr<FdmLinearOpComposite>& op = p.first;
+        op->setTime(0.5, 0.6);
+
+        const Size n = p.second->layout()->size();
+        Array r(n);
+        for (Size i=0; i < n; ++i)
+            r[i] = std::sin(0.1*i) + 1.5;
+
+        // a wrongly sized and filled buffer must be overwritten
+        Array out(3, 42.0);
+
+        op->applyTo(r, out);
+        Array expected = op->apply_mixed(r);
+        for (Size d=0; d < op->size(); ++d)
+            expected += op->apply_direction(d, r);
+        Real diff = Norm2(out - expected)/Norm2(expected);
+        if (diff > tol)
+            BOOST_FAIL("apply differs from the sum of its parts"
+                       << "\n    dimensions: " << op->size()
+                       << "\n    difference: " << diff
+                       << "\n    tolerance:  " << tol);
+
+        op->apply_mixedTo(r, out);
+        if (out != op->apply_mixed(r))
+            BOOST_FAIL("out-parameter apply_mixed differs"
+                       << "\n    dimensions: " << op->size());
+
+        for (Size d=0; d < op->size(); ++d) {
+            out = Array(5, -1.0);
+            op->apply_directionTo(d, r, out);
+            if (out != op->apply_direction(d, r))
+                BOOST_FAIL("out-parameter apply_direction differs"
+                           << "\n    dimensions: " << op->size()
+                           << "\n    direction:  " << d);
+
+            out = Array(7, 13.0);
+            op->solve_splittingTo(d, r, a, out);
+            if (out != op->solve_splitting(d, r, a))
+                BOOST_FAIL("out-parameter solve_splitting differs"
+                           << "\n    dimensions: " << op->size()
+                           << "\n    direction:  " << d);
+
+            // solve_splitting inverts 1 + a*L_d
+            const Array rr = out + a*op->apply_direction(d, out);
+            diff = Norm2(rr - r)/Norm2(r);
+            if (diff > tol)
+                BOOST_FAIL("solve_splitting doesn't invert the operator"
+                           << "\n    dimensions: " << op->size()
+                           << "\n    direction:  " << d
+                           << "\n    difference: " << diff
+                           << "\n    tolerance:  " << tol);
+        }
+    }
+}
+
+void FdmLinearOpTest::testKrylovSolverWithIlu() {
+    BOOST_TEST_MESSAGE("Testing ILU-preconditioned Krylov solver "
+                       "for implicit FDM steps...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const Time maturity = 1.0;
+    const Size steps = 10;
+
+    // Heston Hull-White operator, whose coefficients depend on time
+    const std::vector<Size> dim = {21, 11, 11};
+
+    ext::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    const FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    const ext::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    ext::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    ext::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    const ext::shared_ptr<FdmLinearOpComposite> hhwOp =
+        ext::make_shared<FdmHestonHullWhiteOp>(mesher,
+                                               jointProcess->hestonProcess(),
+                                               hwProcess, jointProcess->eta());
+
+    Array initialValues(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter)
+        initialValues[iter.index()]
+            = desc.calculator->avgInnerValue(iter, maturity);
+
+    Size solves = 0;
+    Real maxError = 0.0;
+    const ext::shared_ptr<FdmKrylovSolver> hhwSolver =
+        ext::make_shared<FdmKrylovSolver>(
+            hhwOp, false, 1e-8, FdmKrylovSolver::BiCGstab, 1,
+            [&](Size, Real error) {
+                ++solves;
+                maxError = std::max(maxError, error);
+            });
+
+    Array expected = initialValues;
+    ImplicitEulerScheme splittingScheme(hhwOp);
+    FiniteDifferenceModel<ImplicitEulerScheme>(splittingScheme)
+        .rollback(expected, maturity, 0.0, steps);
+
+    Array calculated = initialValues;
+    ImplicitEulerScheme iluScheme(hhwSolver);
+    FiniteDifferenceModel<ImplicitEulerScheme>(iluScheme)
+        .rollback(calculated, maturity, 0.0, steps);
+
+    const Real tol = 1e-6;
+    Real diff = Norm2(calculated - expected)/Norm2(expected);
+    if (diff > tol)
+        BOOST_ERROR("ILU-preconditioned and operator-splitting "
+                    "preconditioned solutions differ"
+                    << "\n    operator:   Heston Hull-White"
+                    << "\n    difference: " << diff
+                    << "\n    tolerance:  " << tol);
+
+    if (solves != steps || maxError >= 1e-8)
+        BOOST_ERROR("unexpected solver statistics"
+                    << "\n    solves:         " << solves
+                    << "\n    expected:       " << steps
+                    << "\n    max. residual:  " << maxError);
+    if (hhwSolver->numberOfFactorizations() != steps)
+        BOOST_ERROR("time-dependent operator factorized "
+                    << hhwSolver->numberOfFactorizations()
+                    << " times instead of " << steps);
+    if (iluScheme.numberOfIterations() != hhwSolver->numberOfIterations())
+        BOOST_ERROR("scheme and solver report different iterations"
+                    << "\n    scheme: " << iluScheme.numberOfIterations()
+                    << "\n    solver: " << hhwSolver->numberOfIterations());
+
+    // two-dimensional Black-Scholes operator on flat term structures,
+    // whose coefficients don't depend on time
+    const DayCounter dc = Actual365Fixed();
+    const ext::shared_ptr<GeneralizedBlackScholesProcess> p1 =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)));
+    const ext::shared_ptr<GeneralizedBlackScholesProcess> p2 =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.01, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.35, dc)));
+
+    const ext::shared_ptr<FdmMesher> bsMesher(
+        new UniformGridMesher(
+            ext::make_shared<FdmLinearOpLayout>(std::vector<Size>{40, 30}),
+            std::vector<std::pair<Real, Real> >{{3.0, 6.2}, {2.8, 6.4}}));
+    const ext::shared_ptr<FdmLinearOpComposite> bsOp =
+        ext::make_shared<Fdm2dBlackScholesOp>(bsMesher, p1, p2, 0.6,
+                                              maturity);
+
+    Array bsInitialValues(bsMesher->layout()->size());
+    const FdmLinearOpIterator bsEndIter = bsMesher->layout()->end();
+    for (FdmLinearOpIterator iter = bsMesher->layout()->begin();
+         iter != bsEndIter; ++iter)
+        bsInitialValues[iter.index()] =
+            std::max(std::exp(bsMesher->location(iter, 0))
+                     - std::exp(bsMesher->location(iter, 1)), 0.0);
+
+    expected = bsInitialValues;
+    ImplicitEulerScheme bsSplittingScheme(bsOp);
+    FiniteDifferenceModel<ImplicitEulerScheme>(bsSplittingScheme)
+        .rollback(expected, maturity, 0.0, steps);
+
+    for (Size threads=1; threads <= 2; ++threads) {
+        const ext::shared_ptr<FdmKrylovSolver> bsSolver =
+            ext::make_shared<FdmKrylovSolver>(
+                bsOp, true, 1e-8, FdmKrylovSolver::GMRES, threads);
+
+        calculated = bsInitialValues;
+        ImplicitEulerScheme bsIluScheme(bsSolver);
+        FiniteDifferenceModel<ImplicitEulerScheme>(bsIluScheme)
+            .rollback(calculated, maturity, 0.0, steps);
+
+        diff = Norm2(calculated - expected)/Norm2(expected);
+        if (diff > tol)
+            BOOST_ERROR("ILU-preconditioned and operator-splitting "
+                        "preconditioned solutions differ"
+                        << "\n    operator:   2d Black-Scholes"
+                        << "\n    threads:    " << threads
+                        << "\n    difference: " << diff
+                        << "\n    tolerance:  " << tol);
+
+        // the factorization is kept across the steps
+        if (bsSolver->numberOfFactorizations() != 1)
+            BOOST_ERROR("time-homogeneous operator factorized "
+                        << bsSolver->numberOfFactorizations()
+                        << " times instead of once");
+    }
+}
+
 test_suite* FdmLinearOpTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("linear operator tests");
 
@@ -1725,6 +2041,7 @@ test_suite* FdmLinearOpTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testDerivativeWeightsOnNonUniformGrids));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSecondOrderMixedDerivativesMapApply));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapSolve));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapOnMultiDimLayout));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonBarrier));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonExpress));
@@ -1736,6 +2053,8 @@ test_suite* FdmLinearOpTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmMesherIntegral));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testHighInterestRateBlackScholesMesher));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testLowVolatilityHighDiscreteDividendBlackScholesMesher));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testOutParameterOperators));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testKrylovSolverWithIlu));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonHullWhiteOp));
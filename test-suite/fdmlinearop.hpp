@@ -37,6 +37,7 @@ public:
     static void testDerivativeWeightsOnNonUniformGrids();
     static void testSecondOrderMixedDerivativesMapApply();
     static void testTripleBandMapSolve();
+    static void testTripleBandMapOnMultiDimLayout();
     static void testFdmHestonBarrier();
     static void testFdmHestonAmerican();
     static void testFdmHestonExpress();
@@ -49,6 +50,8 @@ public:
     static void testFdmMesherIntegral();
     static void testHighInterestRateBlackScholesMesher();
     static void testLowVolatilityHighDiscreteDividendBlackScholesMesher();
+    static void testOutParameterOperators();
+    static void testKrylovSolverWithIlu();
 
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
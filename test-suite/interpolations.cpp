@@ -36,6 +36,7 @@
 #include <ql/math/interpolations/kernelinterpolation2d.hpp>
 #include <ql/math/interpolations/lagrangeinterpolation.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
 #include <ql/math/interpolations/multicubicspline.hpp>
 #include <ql/math/interpolations/sabrinterpolation.hpp>
 #include <ql/math/kernelfunctions.hpp>
@@ -45,7 +46,9 @@
 #include <ql/tuple.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/utilities/null.hpp>
+#include <algorithm>
 #include <cmath>
+#include <iomanip>
 #include <utility>
 
 using namespace QuantLib;
@@ -2397,6 +2400,64 @@ void InterpolationTest::testBackwardFlatOnSinglePoint() {
     }
 }
 
+void InterpolationTest::testBatchValues() {
+    BOOST_TEST_MESSAGE("Testing interpolated values over arrays of points...");
+
+    const Real xs[] = { 0.1, 0.35, 0.5, 1.0, 2.0, 3.3, 5.0, 7.0, 10.0, 20.0, 30.0 };
+    const Real ys[] = { 0.99, 0.97, 0.96, 0.93, 0.87, 0.80, 0.71, 0.62, 0.50, 0.25, 0.12 };
+    std::vector<Real> x(std::begin(xs), std::end(xs)), y(std::begin(ys), std::end(ys));
+
+    std::vector<std::pair<std::string, Interpolation> > interpolations = {
+        { "linear", Linear().interpolate(x.begin(), x.end(), y.begin()) },
+        { "log-linear", LogLinear().interpolate(x.begin(), x.end(), y.begin()) },
+        { "cubic", Cubic().interpolate(x.begin(), x.end(), y.begin()) },
+        { "forward-flat", ForwardFlat().interpolate(x.begin(), x.end(), y.begin()) }
+    };
+
+    // increasing, decreasing and scattered points, also outside the range
+    std::vector<Real> points;
+    for (Real t=-0.5; t<35.0; t+=0.0137)
+        points.push_back(t);
+    for (Real t=35.0; t>-0.5; t-=0.173)
+        points.push_back(t);
+    for (Size k=0; k<500; ++k)
+        points.push_back(std::fmod(k*7.31, 35.5) - 0.5);
+
+    std::vector<Real> values(points.size());
+    for (auto& interpolation : interpolations) {
+        const Interpolation& f = interpolation.second;
+        f.values(&points[0], &values[0], points.size(), true);
+        for (Size i=0; i<points.size(); ++i) {
+            Real expected = f(points[i], true);
+            if (std::fabs(values[i] - expected) > 1.0e-14 * std::fabs(expected))
+                BOOST_ERROR("failed to reproduce " << interpolation.first
+                            << " interpolation over an array"
+                            << std::setprecision(16)
+                            << "\n    x:          " << points[i]
+                            << "\n    calculated: " << values[i]
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    // the intervals located by hunting are the ones found by bisection
+    for (Real point : points) {
+        Size j = std::upper_bound(x.begin(), x.end()-1, point) - x.begin();
+        j = j == 0 ? 0 : j-1;
+        Real expected = y[j] + (point - x[j]) * (y[j+1] - y[j]) / (x[j+1] - x[j]);
+        Real calculated = interpolations[0].second(point, true);
+        if (std::fabs(calculated - expected) > 1.0e-14)
+            BOOST_ERROR("wrong interval located"
+                        << std::setprecision(16)
+                        << "\n    x:          " << point
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+
+    BOOST_CHECK_THROW(interpolations[0].second.values(&points[0], &values[0],
+                                                      points.size()),
+                      Error);
+}
+
 test_suite* InterpolationTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Interpolation tests");
 
@@ -2429,6 +2490,7 @@ test_suite* InterpolationTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testLagrangeInterpolationOnChebyshevPoints));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBSplines));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBackwardFlatOnSinglePoint));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBatchValues));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testNoArbSabrInterpolation));
@@ -63,6 +63,7 @@ class InterpolationTest {
     static void testLagrangeInterpolationOnChebyshevPoints();
     static void testBSplines();
     static void testBackwardFlatOnSinglePoint();
+    static void testBatchValues();
 
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
@@ -19,8 +19,13 @@
 
 #include "lazyobject.hpp"
 #include "utilities.hpp"
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
 #include <ql/instruments/stock.hpp>
+#include <ql/patterns/calculationgraph.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <boost/atomic.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -79,6 +84,180 @@ void LazyObjectTest::testForwardingNotifications() {
         BOOST_FAIL("Observer was not notified of second change");
 }
 
+namespace {
+
+    // a non-lazy observer which is not safe to use concurrently,
+    // such as a pricing engine
+    class SharedResource : public Observable, public Observer {
+      public:
+        SharedResource() : busy_(false), overlaps_(0) {}
+        void update() override { notifyObservers(); }
+        void acquire() {
+            if (busy_.exchange(true))
+                ++overlaps_;
+        }
+        void release() { busy_ = false; }
+        Size overlaps() const { return overlaps_; }
+      private:
+        boost::atomic<bool> busy_;
+        boost::atomic<Size> overlaps_;
+    };
+
+    class Node : public LazyObject {
+      public:
+        Node(std::vector<ext::shared_ptr<Observable> > dependencies,
+             ext::shared_ptr<SharedResource> resource =
+                                       ext::shared_ptr<SharedResource>())
+        : resource_(std::move(resource)) {
+            for (const auto& d : dependencies) {
+                registerWith(d);
+                auto quote = ext::dynamic_pointer_cast<SimpleQuote>(d);
+                if (quote)
+                    quotes_.push_back(quote);
+                auto node = ext::dynamic_pointer_cast<Node>(d);
+                if (node)
+                    nodes_.push_back(node);
+            }
+            if (resource_)
+                registerWith(resource_);
+        }
+        Real value() const {
+            calculate();
+            return value_;
+        }
+        Size calculations() const { return calculations_; }
+      private:
+        void performCalculations() const override {
+            ++calculations_;
+            if (resource_)
+                resource_->acquire();
+            value_ = 0.0;
+            for (const auto& q : quotes_)
+                value_ += q->value();
+            for (const auto& n : nodes_)
+                value_ += n->value();
+            if (resource_)
+                resource_->release();
+        }
+        std::vector<ext::shared_ptr<SimpleQuote> > quotes_;
+        std::vector<ext::shared_ptr<Node> > nodes_;
+        ext::shared_ptr<SharedResource> resource_;
+        mutable Real value_;
+        mutable Size calculations_ = 0;
+    };
+
+}
+
+void LazyObjectTest::testCalculationGraph() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing calculation of lazy objects through their dependencies...");
+
+    typedef std::vector<ext::shared_ptr<Observable> > deps;
+
+    auto q1 = ext::make_shared<SimpleQuote>(1.0);
+    auto q2 = ext::make_shared<SimpleQuote>(2.0);
+    auto curve1 = ext::make_shared<Node>(deps{q1});
+    auto curve2 = ext::make_shared<Node>(deps{q2});
+    auto engine = ext::make_shared<SharedResource>();
+    engine->registerWith(curve1);
+
+    const Size n = 50;
+    std::vector<ext::shared_ptr<Node> > instruments;
+    for (Size i=0; i<n; ++i) {
+        if (i % 2 == 0)
+            instruments.push_back(
+                ext::make_shared<Node>(deps{curve1}, engine));
+        else
+            instruments.push_back(ext::make_shared<Node>(deps{curve2}));
+    }
+    deps all(instruments.begin(), instruments.end());
+    auto portfolio = ext::make_shared<Node>(all);
+
+    std::vector<ext::shared_ptr<Node> > targets(instruments);
+    targets.push_back(portfolio);
+    CalculationGraph graph(targets.begin(), targets.end());
+
+    if (graph.size() != n+3)
+        BOOST_FAIL("unexpected number of objects in graph: "
+                   << graph.size() << " instead of " << n+3);
+    // the instruments sharing the engine are calculated together
+    if (graph.tasks() != n/2 + 4)
+        BOOST_FAIL("unexpected number of tasks: "
+                   << graph.tasks() << " instead of " << n/2 + 4);
+    if (graph.objects().back() != portfolio.get())
+        BOOST_FAIL("objects not sorted topologically");
+
+    graph.calculate(4);
+
+    const Real expected = n/2 * 1.0 + n/2 * 2.0;
+    BOOST_CHECK_EQUAL(portfolio->value(), expected);
+    if (curve1->calculations() != 1 || curve2->calculations() != 1
+        || portfolio->calculations() != 1)
+        BOOST_FAIL("objects not calculated exactly once");
+    for (Size i=0; i<n; ++i) {
+        if (instruments[i]->calculations() != 1)
+            BOOST_FAIL("instrument #" << i << " calculated "
+                       << instruments[i]->calculations() << " times");
+    }
+
+    q1->setValue(3.0);
+    graph.calculate();
+
+    BOOST_CHECK_EQUAL(portfolio->value(), n/2 * 3.0 + n/2 * 2.0);
+    if (curve1->calculations() != 2 || curve2->calculations() != 1
+        || portfolio->calculations() != 2)
+        BOOST_FAIL("objects not recalculated exactly once");
+    for (Size i=0; i<n; ++i) {
+        if (instruments[i]->calculations() != (i % 2 == 0 ? 2 : 1))
+            BOOST_FAIL("instrument #" << i << " calculated "
+                       << instruments[i]->calculations() << " times");
+    }
+
+    if (engine->overlaps() != 0)
+        BOOST_FAIL("shared engine used concurrently");
+}
+
+void LazyObjectTest::testCalculationGraphWithCouponPricers() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing grouping of lazy objects using the same coupon pricer...");
+
+    typedef std::vector<ext::shared_ptr<Observable> > deps;
+
+    auto index = ext::make_shared<Euribor6M>();
+    auto pricer = ext::make_shared<BlackIborCouponPricer>();
+    auto otherPricer = ext::make_shared<BlackIborCouponPricer>();
+
+    const Date start(15, January, 2021), end(15, July, 2021);
+    std::vector<ext::shared_ptr<Node> > instruments;
+    for (Size i=0; i<4; ++i) {
+        auto coupon = ext::make_shared<IborCoupon>(end, 100.0, start, end,
+                                                   2, index);
+        coupon->setPricer(i < 3 ? pricer : otherPricer);
+        instruments.push_back(ext::make_shared<Node>(deps{coupon}));
+    }
+
+    CalculationGraph graph(instruments.begin(), instruments.end());
+
+    if (graph.size() != 4)
+        BOOST_FAIL("unexpected number of objects in graph: "
+                   << graph.size() << " instead of 4");
+    // the instruments whose coupons share a pricer are calculated
+    // together; the last one has a pricer of its own
+    if (graph.tasks() != 2)
+        BOOST_FAIL("unexpected number of tasks: "
+                   << graph.tasks() << " instead of 2");
+
+    graph.calculate(2);
+
+    for (Size i=0; i<4; ++i) {
+        if (instruments[i]->calculations() != 1)
+            BOOST_FAIL("instrument #" << i << " calculated "
+                       << instruments[i]->calculations() << " times");
+    }
+}
+
 
 test_suite* LazyObjectTest::suite() {
     auto* suite = BOOST_TEST_SUITE("LazyObject tests");
@@ -86,6 +265,9 @@ test_suite* LazyObjectTest::suite() {
         QUANTLIB_TEST_CASE(&LazyObjectTest::testDiscardingNotifications));
     suite->add(
         QUANTLIB_TEST_CASE(&LazyObjectTest::testForwardingNotifications));
+    suite->add(QUANTLIB_TEST_CASE(&LazyObjectTest::testCalculationGraph));
+    suite->add(QUANTLIB_TEST_CASE(
+        &LazyObjectTest::testCalculationGraphWithCouponPricers));
     return suite;
 }
 
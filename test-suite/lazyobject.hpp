@@ -29,6 +29,8 @@ class LazyObjectTest {
   public:
     static void testDiscardingNotifications();
     static void testForwardingNotifications();
+    static void testCalculationGraph();
+    static void testCalculationGraphWithCouponPricers();
     static boost::unit_test_framework::test_suite* suite();
 };
 
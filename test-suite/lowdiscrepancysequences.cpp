@@ -1070,10 +1070,22 @@ void LowDiscrepancyTest::testSobolSkipping() {
                 SobolRsg rsg2(j, seed, integer);
                 rsg2.skipTo(k);
 
+                // skip n samples relative to the current position,
+                // both before and after the first draw
+                SobolRsg rsg3(j, seed, integer);
+                rsg3.skip(k);
+                SobolRsg rsg4(j, seed, integer);
+                if (k > 0) {
+                    rsg4.nextInt32Sequence();
+                    rsg4.skip(k - 1);
+                }
+
                 // compare next 100 samples
                 for (Size m = 0; m < 100; m++) {
                     std::vector<boost::uint_least32_t> s1 = rsg1.nextInt32Sequence();
                     std::vector<boost::uint_least32_t> s2 = rsg2.nextInt32Sequence();
+                    std::vector<boost::uint_least32_t> s3 = rsg3.nextInt32Sequence();
+                    std::vector<boost::uint_least32_t> s4 = rsg4.nextInt32Sequence();
                     for (Size n = 0; n < s1.size(); n++) {
                         if (s1[n] != s2[n]) {
                             BOOST_ERROR("Mismatch after skipping:"
@@ -1081,6 +1093,13 @@ void LowDiscrepancyTest::testSobolSkipping() {
                                         << "\n  skipped:  " << k << "\n  at index: " << n
                                         << "\n  expected: " << s1[n] << "\n  found:    " << s2[n]);
                         }
+                        if (s1[n] != s3[n] || s1[n] != s4[n]) {
+                            BOOST_ERROR("Mismatch after relative skipping:"
+                                        << "\n  size:     " << j << "\n  integers: " << integer
+                                        << "\n  skipped:  " << k << "\n  at index: " << n
+                                        << "\n  expected: " << s1[n] << "\n  found:    " << s3[n]
+                                        << ", " << s4[n]);
+                        }
                     }
                 }
             }
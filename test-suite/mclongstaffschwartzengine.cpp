@@ -313,10 +313,82 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testMultithreadedCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing multithreaded Longstaff-Schwartz "
+                       "calibration and pricing...");
+
+    SavedSettings backup;
+
+    const Date todaysDate(15, May, 1998);
+    const Date settlementDate(17, May, 1998);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Date maturity(17, May, 1999);
+    const DayCounter dayCounter = Actual365Fixed();
+
+    Handle<YieldTermStructure> flatTermStructure(
+        ext::make_shared<FlatForward>(settlementDate, 0.06, dayCounter));
+    Handle<YieldTermStructure> flatDividendTS(
+        ext::make_shared<FlatForward>(settlementDate, 0.0, dayCounter));
+    Handle<BlackVolTermStructure> flatVolTS(
+        ext::make_shared<BlackConstantVol>(settlementDate, NullCalendar(),
+                                           0.30, dayCounter));
+    Handle<Quote> underlyingH(ext::make_shared<SimpleQuote>(36.0));
+
+    ext::shared_ptr<GeneralizedBlackScholesProcess> stochasticProcess =
+        ext::make_shared<GeneralizedBlackScholesProcess>(
+            underlyingH, flatDividendTS, flatTermStructure, flatVolTS);
+
+    VanillaOption americanOption(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 40.0),
+        ext::make_shared<AmericanExercise>(settlementDate, maturity));
+
+    americanOption.setPricingEngine(
+        ext::make_shared<FdBlackScholesVanillaEngine>(stochasticProcess,
+                                                      401, 200));
+    const Real expected = americanOption.NPV();
+
+    Real calculated[2];
+    for (Size k=0; k<2; ++k) {
+        americanOption.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(stochasticProcess)
+            .withSteps(50)
+            .withAntitheticVariate()
+            .withSamples(8191)
+            .withCalibrationSamples(4095)
+            .withSeed(42)
+            .withPolynomOrder(3)
+            .withThreads(4));
+
+        calculated[k] = americanOption.NPV();
+        const Real errorEstimate = americanOption.errorEstimate();
+
+        if (std::fabs(calculated[k] - expected) > 2.34*errorEstimate) {
+            BOOST_ERROR("Failed to reproduce american option price "
+                        "with multithreaded calibration"
+                        << "\n    expected:   " << expected
+                        << "\n    calculated: " << calculated[k]
+                        << " +/- " << errorEstimate);
+        }
+    }
+
+    // a new engine with the same seed must give the same result
+    if (calculated[0] != calculated[1]) {
+        BOOST_ERROR("multithreaded Longstaff-Schwartz results "
+                    "are not reproducible"
+                    << std::setprecision(16)
+                    << "\n    first run:  " << calculated[0]
+                    << "\n    second run: " << calculated[1]);
+    }
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
 
     suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &MCLongstaffSchwartzEngineTest::testMultithreadedCalibration));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testAmericanOption));
@@ -30,6 +30,7 @@ class MCLongstaffSchwartzEngineTest {
   public:
     static void testAmericanOption();
     static void testAmericanMaxOption();
+    static void testMultithreadedCalibration();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -482,9 +482,42 @@ void MersenneTwisterTest::testValues() {
 }
 
 
+void MersenneTwisterTest::testSkip() {
+
+    BOOST_TEST_MESSAGE("Testing Mersenne twister jump-ahead...");
+
+    // both below and above the threshold for jumping ahead, and
+    // starting at different positions within the state array
+    const boost::uint_least64_t skips[] = {
+        0, 1, 623, 624, 1000, 4194303, 4194304, 10000019
+    };
+    const Size offsets[] = { 0, 1, 700 };
+
+    for (unsigned long long skip : skips) {
+        for (Size offset : offsets) {
+            MersenneTwisterUniformRng rng1(42), rng2(42);
+            for (Size i=0; i<offset; ++i) {
+                rng1.nextInt32();
+                rng2.nextInt32();
+            }
+            for (boost::uint_least64_t i=0; i<skip; ++i)
+                rng1.nextInt32();
+            rng2.skip(skip);
+            for (Size i=0; i<1000; ++i) {
+                if (rng1.nextInt32() != rng2.nextInt32())
+                    BOOST_FAIL("skipping " << skip << " draws after "
+                               << offset << " draws differs from "
+                               "drawing them (index " << i << ")");
+            }
+        }
+    }
+}
+
+
 test_suite* MersenneTwisterTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Mersenne twister tests");
     suite->add(QUANTLIB_TEST_CASE(&MersenneTwisterTest::testValues));
+    suite->add(QUANTLIB_TEST_CASE(&MersenneTwisterTest::testSkip));
     return suite;
 }
 
@@ -28,6 +28,7 @@
 class MersenneTwisterTest {
   public:
     static void testValues();
+    static void testSkip();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -21,6 +21,8 @@
 #include "utilities.hpp"
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/patterns/observable.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/quotes/marketdatatransaction.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/volatility/capfloor/capfloortermvolsurface.hpp>
 #include <ql/termstructures/volatility/optionlet/strippedoptionletadapter.hpp>
@@ -114,6 +116,8 @@ void ObservableTest::testObservableSettings() {
 #include <boost/thread/thread.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 
+#include <chrono>
+#include <iomanip>
 #include <list>
 
 namespace {
@@ -262,6 +266,117 @@ void ObservableTest::testMultiThreadingGlobalSettings() {
         }
     }
 }
+
+namespace {
+
+    // counts without synchronization and records whether two
+    // updates ever overlapped
+    class SerialUpdateCounter : public Observer {
+      public:
+        SerialUpdateCounter() : counter_(0), running_(false),
+                                overlapped_(false) {}
+        void update() {
+            if (running_.exchange(true))
+                overlapped_ = true;
+            ++counter_;
+            boost::this_thread::yield();
+            running_ = false;
+        }
+        Size counter() const { return counter_; }
+        bool overlapped() const { return overlapped_; }
+      private:
+        Size counter_;
+        boost::atomic<bool> running_, overlapped_;
+    };
+
+}
+
+void ObservableTest::testConcurrentNotifications() {
+    BOOST_TEST_MESSAGE("Testing concurrent notifications of an observer...");
+
+    // each thread updates its own quote, while a single observer
+    // (e.g., a curve) listens to all of them
+    const Size notifications = 5000;
+    const Size nThreads = 8;
+
+    const ext::shared_ptr<SerialUpdateCounter> observer =
+        ext::make_shared<SerialUpdateCounter>();
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes(nThreads);
+    for (Size i=0; i<nThreads; ++i) {
+        quotes[i] = ext::make_shared<SimpleQuote>(0.0);
+        observer->registerWith(quotes[i]);
+    }
+
+    boost::thread_group threads;
+    for (Size i=0; i<nThreads; ++i) {
+        const ext::shared_ptr<SimpleQuote> quote = quotes[i];
+        threads.create_thread([quote, notifications]() {
+            for (Size j=0; j<notifications; ++j)
+                quote->setValue(Real(j+1));
+        });
+    }
+    threads.join_all();
+
+    if (observer->overlapped())
+        BOOST_FAIL("observer updated by two threads at once");
+    if (observer->counter() != nThreads*notifications) {
+        BOOST_FAIL("notifications lost:"
+                   << "\n    expected: " << nThreads*notifications
+                   << "\n    received: " << observer->counter());
+    }
+}
+void ObservableTest::testNotificationThroughput() {
+    BOOST_TEST_MESSAGE("Testing concurrent notification throughput...");
+
+    // each thread updates its own quote, observed by its own observer
+    // (e.g., an instrument) and by a common one (e.g., a curve)
+    const Size notifications = 20000;
+    const Size threadNumbers[] = { 1, 8, 32 };
+
+    for (Size nThreads : threadNumbers) {
+        const ext::shared_ptr<MTUpdateCounter> common =
+            ext::make_shared<MTUpdateCounter>();
+        std::vector<ext::shared_ptr<SimpleQuote> > quotes(nThreads);
+        std::vector<ext::shared_ptr<MTUpdateCounter> > observers(nThreads);
+        for (Size i=0; i<nThreads; ++i) {
+            quotes[i] = ext::make_shared<SimpleQuote>(0.0);
+            observers[i] = ext::make_shared<MTUpdateCounter>();
+            observers[i]->registerWith(quotes[i]);
+            common->registerWith(quotes[i]);
+        }
+
+        boost::thread_group threads;
+        const auto start = std::chrono::steady_clock::now();
+        for (Size i=0; i<nThreads; ++i) {
+            const ext::shared_ptr<SimpleQuote> quote = quotes[i];
+            threads.create_thread([quote, notifications]() {
+                for (Size j=0; j<notifications; ++j)
+                    quote->setValue(Real(j+1));
+            });
+        }
+        threads.join_all();
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        BOOST_TEST_MESSAGE("    " << std::setw(2) << nThreads
+                           << " thread(s): " << std::fixed
+                           << std::setprecision(2)
+                           << nThreads*notifications/elapsed.count()/1.0e6
+                           << " million notifications per second");
+
+        if (common->counter() != int(nThreads*notifications))
+            BOOST_FAIL("notifications lost with " << nThreads << " threads:"
+                       << "\n    expected: " << nThreads*notifications
+                       << "\n    received: " << common->counter());
+        for (Size i=0; i<nThreads; ++i) {
+            if (observers[i]->counter() != int(notifications))
+                BOOST_FAIL("notifications lost by observer #" << i
+                           << " with " << nThreads << " threads:"
+                           << "\n    expected: " << notifications
+                           << "\n    received: " << observers[i]->counter());
+        }
+    }
+}
 #endif
 
 void ObservableTest::testDeepUpdate() {
@@ -319,6 +434,135 @@ void ObservableTest::testEmptyObserverList() {
     dummyObserver->unregisterWith(ext::make_shared<SimpleQuote>(10.0));
 }
 
+namespace {
+
+    class SumOfQuotes : public LazyObject {
+      public:
+        SumOfQuotes(std::string name,
+                    std::vector<ext::shared_ptr<SimpleQuote> > quotes,
+                    std::vector<ext::shared_ptr<SumOfQuotes> > sums,
+                    std::vector<std::string>* log)
+        : name_(std::move(name)), quotes_(std::move(quotes)),
+          sums_(std::move(sums)), log_(log) {
+            for (const auto& quote : quotes_)
+                registerWith(quote);
+            for (const auto& sum : sums_)
+                registerWith(sum);
+        }
+        void update() override {
+            ++updates_;
+            log_->push_back(name_);
+            LazyObject::update();
+        }
+        Real value() const {
+            calculate();
+            return value_;
+        }
+        Size updates() const { return updates_; }
+        Size calculations() const { return calculations_; }
+      private:
+        void performCalculations() const override {
+            ++calculations_;
+            value_ = 0.0;
+            for (const auto& quote : quotes_)
+                value_ += quote->value();
+            for (const auto& sum : sums_)
+                value_ += sum->value();
+        }
+        std::string name_;
+        std::vector<ext::shared_ptr<SimpleQuote> > quotes_;
+        std::vector<ext::shared_ptr<SumOfQuotes> > sums_;
+        std::vector<std::string>* log_;
+        Size updates_ = 0;
+        mutable Size calculations_ = 0;
+        mutable Real value_;
+    };
+
+}
+
+void ObservableTest::testMarketDataTransaction() {
+
+    BOOST_TEST_MESSAGE("Testing market data transactions...");
+
+    std::vector<ext::shared_ptr<SimpleQuote> > q(5);
+    for (Size i=0; i<q.size(); ++i)
+        q[i] = ext::make_shared<SimpleQuote>(Real(i+1));
+
+    std::vector<std::string> log;
+    typedef std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+    typedef std::vector<ext::shared_ptr<SumOfQuotes> > sums;
+    auto a = ext::make_shared<SumOfQuotes>(
+        "a", quotes{q[0], q[1], q[2]}, sums(), &log);
+    auto b = ext::make_shared<SumOfQuotes>(
+        "b", quotes{q[2], q[3], q[4]}, sums(), &log);
+    auto c = ext::make_shared<SumOfQuotes>(
+        "c", quotes{q[0]}, sums{a, b}, &log);
+
+    BOOST_CHECK_EQUAL(c->value(), 1.0 + 6.0 + 12.0);
+
+    MarketDataTransaction transaction;
+    transaction.setValue(q[0], 10.0);
+    transaction.setValue(q[2], 20.0);
+    transaction.setValue(q[2], 30.0);
+    transaction.setValue(q[4], 5.0);
+    BOOST_CHECK_EQUAL(transaction.size(), 3U);
+
+    ObserverGraph graph = transaction.commit(true);
+
+    if (!transaction.empty())
+        BOOST_FAIL("transaction not cleared after commit");
+    if (graph.size() != 3 || graph.levels() != 2)
+        BOOST_FAIL("unexpected observer graph:"
+                   << "\n    observers: " << graph.size()
+                   << "\n    levels:    " << graph.levels());
+    if (graph.levelEnd(0) != 2 || graph.observers().back() != c.get())
+        BOOST_FAIL("observers not sorted by level");
+
+    if (a->updates() != 1 || b->updates() != 1 || c->updates() != 1)
+        BOOST_FAIL("observers not notified exactly once:"
+                   << "\n    a: " << a->updates()
+                   << "\n    b: " << b->updates()
+                   << "\n    c: " << c->updates());
+    if (log.size() != 3 || log.back() != "c")
+        BOOST_FAIL("observers not notified in topological order");
+    if (c->calculations() != 2)
+        BOOST_FAIL("objects not recalculated on commit");
+
+    BOOST_CHECK_EQUAL(a->value(), 10.0 + 2.0 + 30.0);
+    BOOST_CHECK_EQUAL(b->value(), 30.0 + 4.0 + 5.0);
+    BOOST_CHECK_EQUAL(c->value(), 10.0 + 42.0 + 39.0);
+    BOOST_CHECK_EQUAL(c->calculations(), 2U);
+
+    // unchanged values don't notify anyone
+    transaction.setValue(q[1], 2.0);
+    graph = transaction.commit();
+    if (graph.size() != 0 || c->updates() != 1)
+        BOOST_FAIL("observers notified of unchanged quotes");
+
+    // notifications are not forwarded by frozen objects
+    a->freeze();
+    transaction.setValue(q[1], 3.0);
+    graph = transaction.commit();
+    if (graph.size() != 1 || a->updates() != 2 || c->updates() != 1)
+        BOOST_FAIL("notifications forwarded by frozen object");
+    BOOST_CHECK_EQUAL(a->value(), 42.0);
+
+    // the graph can't be used after an observer is destroyed
+    auto d = ext::make_shared<SumOfQuotes>(
+        "d", quotes{q[3]}, sums(), &log);
+    transaction.setValue(q[3], 7.0);
+    graph = transaction.commit();
+    if (graph.size() != 3)
+        BOOST_FAIL("unexpected observer graph:"
+                   << "\n    observers: " << graph.size());
+    graph.recalculate();
+    d.reset();
+    BOOST_CHECK_THROW(graph.recalculate(), Error);
+
+    if (!ObservableSettings::instance().updatesEnabled())
+        BOOST_FAIL("updates not enabled after commit");
+}
+
 test_suite* ObservableTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Observer tests");
 
@@ -328,10 +572,13 @@ test_suite* ObservableTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testAsyncGarbagCollector));
     suite->add(QUANTLIB_TEST_CASE(
         &ObservableTest::testMultiThreadingGlobalSettings));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testConcurrentNotifications));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testNotificationThroughput));
 #endif
 
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testDeepUpdate));
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testEmptyObserverList));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testMarketDataTransaction));
     return suite;
 }
 
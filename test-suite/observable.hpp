@@ -30,8 +30,11 @@ class ObservableTest {
     static void testObservableSettings();
     static void testAsyncGarbagCollector();
     static void testMultiThreadingGlobalSettings();
+    static void testConcurrentNotifications();
+    static void testNotificationThroughput();
     static void testDeepUpdate();
     static void testEmptyObserverList();
+    static void testMarketDataTransaction();
 
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -39,6 +39,7 @@
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/oicouponds.hpp>
 #include <ql/currencies/europe.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
@@ -507,6 +508,115 @@ void OvernightIndexedSwapTest::testBootstrapRegression() {
 }
 
 
+namespace overnight_indexed_swap_test {
+
+    // exact calculation, with one fixing per overnight period
+    Rate dailyLoopRate(const OiCouponDS& coupon) {
+        ext::shared_ptr<IborIndex> index =
+            ext::dynamic_pointer_cast<IborIndex>(coupon.index());
+        const TimeSeries<Real>& history =
+            IndexManager::instance().getHistory(index->name());
+        Date today = Settings::instance().evaluationDate();
+        const std::vector<Date>& fixingDates = coupon.fixingDates();
+        const std::vector<Time>& dt = coupon.dt();
+        Size n = dt.size(), nMax = n - coupon.rateCutoff() - 1;
+        bool isComp = coupon.typeOI() == OiSwapIndexDS::CompoundingOI;
+        Real compoundFactor = 1.0, sum = 0.0;
+        for (Size i=0; i<n; ++i) {
+            Date d = fixingDates[std::min(i, nMax)];
+            Rate fixing = history[d];
+            if (fixing == Null<Real>() && d >= today)
+                fixing = index->forecastFixing(d);
+            if (isComp)
+                compoundFactor *= 1.0 + fixing*dt[i];
+            else
+                sum += fixing*dt[i];
+        }
+        Rate rate = (isComp ? compoundFactor - 1.0 : sum)
+                  / coupon.accrualPeriod();
+        return coupon.gearing() * rate + coupon.spread();
+    }
+
+}
+
+void OvernightIndexedSwapTest::testOiCouponDSPricer() {
+
+    BOOST_TEST_MESSAGE("Testing OiCouponDS pricer against daily loop...");
+
+    using namespace overnight_indexed_swap_test;
+
+    CommonVars vars;
+    IndexHistoryCleaner cleaner;
+    IndexManager::instance().clearHistory(vars.eoniaIndex->name());
+
+    Date startDate(5, January, 2009), endDate(6, April, 2009);
+    for (Date d = startDate; d < vars.today; ++d) {
+        if (vars.calendar.isBusinessDay(d))
+            vars.eoniaIndex->addFixing(d, 0.02 + 0.0001*(d - startDate));
+    }
+
+    struct Case {
+        OiSwapIndexDS::TypeOI type;
+        Natural rateCutoff;
+    };
+    // with a rate cutoff, the telescoping calculation of compounded
+    // coupons is an approximation; therefore, it's not tested here
+    Case cases[] = {
+        { OiSwapIndexDS::CompoundingOI, 0 },
+        { OiSwapIndexDS::AveragingOI, 0 },
+        { OiSwapIndexDS::AveragingOI, 2 }
+    };
+
+    std::vector<ext::shared_ptr<OiCouponDS> > coupons;
+    for (auto& c : cases) {
+        coupons.push_back(ext::make_shared<OiCouponDS>(
+            endDate, 100.0, startDate, endDate, vars.eoniaIndex,
+            1.5, 0.001, Date(), Date(), DayCounter(),
+            c.rateCutoff, c.type, OiSwapIndexDS::NoneOI));
+    }
+
+    Real tolerance = 1.0e-12;
+    auto check = [&](const std::string& step) {
+        for (Size k=0; k<coupons.size(); ++k) {
+            Rate calculated = coupons[k]->rate();
+            Rate expected = dailyLoopRate(*coupons[k]);
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce daily-loop rate " << step
+                            << ":\n    type:        " << cases[k].type
+                            << "\n    rate cutoff: " << cases[k].rateCutoff
+                            << std::setprecision(12)
+                            << "\n    calculated:  " << calculated
+                            << "\n    expected:    " << expected);
+        }
+    };
+
+    check("");
+
+    // only the forecast part is affected
+    vars.eoniaTermStructure.linkTo(flatRate(vars.today, 0.03,
+                                            Actual365Fixed()));
+    check("after curve change");
+
+    // the cached fixed part must include the new fixing
+    vars.eoniaIndex->addFixing(vars.today, 0.035);
+    check("after today's fixing was added");
+
+    // ...and the replaced ones
+    vars.eoniaIndex->addFixing(Date(6, January, 2009), 0.04, true);
+    check("after past fixing was replaced");
+
+    // ...and the horizon
+    Settings::instance().evaluationDate() = Date(10, February, 2009);
+    vars.eoniaTermStructure.linkTo(flatRate(Date(10, February, 2009),
+                                            0.03, Actual365Fixed()));
+    for (Date d = vars.today + 1; d < Date(10, February, 2009); ++d) {
+        if (vars.calendar.isBusinessDay(d))
+            vars.eoniaIndex->addFixing(d, 0.025);
+    }
+    check("after evaluation date change");
+}
+
+
 test_suite* OvernightIndexedSwapTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Overnight-indexed swap tests");
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairRate));
@@ -520,5 +630,6 @@ test_suite* OvernightIndexedSwapTest::suite() {
         &OvernightIndexedSwapTest::testBootstrapWithTelescopicDatesAndArithmeticAverage));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testSeasonedSwaps));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testBootstrapRegression));
+    suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testOiCouponDSPricer));
     return suite;
 }
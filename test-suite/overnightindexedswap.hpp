@@ -37,6 +37,7 @@ class OvernightIndexedSwapTest {
     static void testBootstrapWithTelescopicDatesAndArithmeticAverage();
     static void testSeasonedSwaps();
     static void testBootstrapRegression();
+    static void testOiCouponDSPricer();
     static boost::unit_test_framework::test_suite* suite();
 };
 
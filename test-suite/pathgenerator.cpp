@@ -19,9 +19,12 @@
 
 #include "pathgenerator.hpp"
 #include "utilities.hpp"
+#include <ql/methods/montecarlo/batchmontecarlomodel.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/montecarlomodel.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
@@ -138,6 +141,86 @@ namespace {
         }
     }
 
+
+    void testBatch(const ext::shared_ptr<StochasticProcess>& process,
+                   const std::string& tag) {
+        typedef PseudoRandom::rsg_type rsg_type;
+
+        BigNatural seed = 42;
+        TimeGrid grid(10.0, 12);
+        Size dimension = process->factors()*(grid.size()-1);
+        Size batchSize = 7, batches = 3;
+
+        MultiPathGenerator<rsg_type> generator(
+            process, grid,
+            PseudoRandom::make_sequence_generator(dimension, seed));
+        MultiPathBatchGenerator<rsg_type> batchGenerator(
+            process, grid,
+            PseudoRandom::make_sequence_generator(dimension, seed),
+            batchSize);
+
+        Real tolerance = 1.0e-12;
+        for (Size b=0; b<batches; ++b) {
+            // the batch must be copied, since the antithetic one
+            // overwrites it
+            MultiPathBatch paths = batchGenerator.next();
+            const MultiPathBatch& antiPaths = batchGenerator.antithetic();
+            for (Size k=0; k<batchSize; ++k) {
+                const MultiPath& path = generator.next().value;
+                for (Size j=0; j<process->size(); ++j) {
+                    for (Size i=0; i<grid.size(); ++i) {
+                        Real expected = path[j][i];
+                        Real calculated = paths(i,j,k);
+                        if (std::fabs(calculated-expected) >
+                            tolerance*std::max(1.0, std::fabs(expected)))
+                            BOOST_FAIL("using " << tag << " process:"
+                                       << "\n    batch:      " << b
+                                       << "\n    path:       " << k
+                                       << "\n    asset:      " << j
+                                       << "\n    step:       " << i
+                                       << std::setprecision(13)
+                                       << "\n    calculated: " << calculated
+                                       << "\n    expected:   " << expected);
+                    }
+                }
+                const MultiPath& antiPath = generator.antithetic().value;
+                for (Size j=0; j<process->size(); ++j) {
+                    for (Size i=0; i<grid.size(); ++i) {
+                        Real expected = antiPath[j][i];
+                        Real calculated = antiPaths(i,j,k);
+                        if (std::fabs(calculated-expected) >
+                            tolerance*std::max(1.0, std::fabs(expected)))
+                            BOOST_FAIL("using " << tag << " process "
+                                       << "(antithetic sample):"
+                                       << "\n    batch:      " << b
+                                       << "\n    path:       " << k
+                                       << "\n    asset:      " << j
+                                       << "\n    step:       " << i
+                                       << std::setprecision(13)
+                                       << "\n    calculated: " << calculated
+                                       << "\n    expected:   " << expected);
+                    }
+                }
+            }
+        }
+    }
+
+    class LastValuePricer : public PathPricer<MultiPath> {
+      public:
+        Real operator()(const MultiPath& path) const override {
+            return path[0].back();
+        }
+    };
+
+    class LastValueBatchPricer : public BatchPathPricer {
+      public:
+        void operator()(const MultiPathBatch& paths,
+                        Real* values) const override {
+            const Real* last = paths.values(paths.pathSize()-1, 0);
+            std::copy(last, last+paths.pathNumber(), values);
+        }
+    };
+
 }
 
 
@@ -290,11 +373,114 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+void PathGeneratorTest::testMultiPathBatchGenerator() {
+
+    BOOST_TEST_MESSAGE("Testing batch path generation against n-D paths...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(ext::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    ext::shared_ptr<StochasticProcess1D> bsProcess(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    testBatch(bsProcess, "Black-Scholes");
+
+    testBatch(ext::make_shared<SquareRootProcess>(0.1, 0.1, 0.20, 10.0),
+              "square-root");
+
+    Matrix correlation(3,3);
+    correlation[0][0] = 1.0; correlation[0][1] = 0.9; correlation[0][2] = 0.7;
+    correlation[1][0] = 0.9; correlation[1][1] = 1.0; correlation[1][2] = 0.4;
+    correlation[2][0] = 0.7; correlation[2][1] = 0.4; correlation[2][2] = 1.0;
+
+    std::vector<ext::shared_ptr<StochasticProcess1D> > processes(3);
+    processes[0] = bsProcess;
+    processes[1] = ext::shared_ptr<StochasticProcess1D>(
+                       new GeometricBrownianMotionProcess(100.0, 0.03, 0.20));
+    processes[2] = ext::shared_ptr<StochasticProcess1D>(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    testBatch(ext::make_shared<StochasticProcessArray>(processes,
+                                                       correlation),
+              "process-array");
+
+    const HestonProcess::Discretization schemes[] = {
+        HestonProcess::PartialTruncation,
+        HestonProcess::FullTruncation,
+        HestonProcess::Reflection,
+        HestonProcess::QuadraticExponentialMartingale };
+    for (auto scheme : schemes) {
+        testBatch(ext::make_shared<HestonProcess>(r, q, x0, 0.04, 1.5, 0.04,
+                                                  0.5, -0.7, scheme),
+                  "Heston");
+    }
+}
+
+
+void PathGeneratorTest::testBatchMonteCarloModel() {
+
+    BOOST_TEST_MESSAGE("Testing batch Monte Carlo model...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(ext::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    ext::shared_ptr<StochasticProcess> process =
+        ext::make_shared<HestonProcess>(r, q, x0, 0.04, 1.5, 0.04, 0.5, -0.7);
+
+    typedef PseudoRandom::rsg_type rsg_type;
+    BigNatural seed = 42;
+    TimeGrid grid(1.0, 10);
+    Size dimension = process->factors()*(grid.size()-1);
+
+    MonteCarloModel<MultiVariate, PseudoRandom> model(
+        ext::make_shared<MultiPathGenerator<rsg_type> >(
+            process, grid,
+            PseudoRandom::make_sequence_generator(dimension, seed)),
+        ext::make_shared<LastValuePricer>(), Statistics(), true);
+
+    // the batch size doesn't divide the number of samples, so that
+    // the leftover paths of a batch are used by the next call
+    BatchMonteCarloModel<rsg_type> batchModel(
+        ext::make_shared<MultiPathBatchGenerator<rsg_type> >(
+            process, grid,
+            PseudoRandom::make_sequence_generator(dimension, seed), 16),
+        ext::make_shared<LastValueBatchPricer>(), Statistics(), true);
+
+    Size samples[] = { 10, 37, 100 };
+    for (Size n : samples) {
+        model.addSamples(n);
+        batchModel.addSamples(n);
+
+        Real expected = model.sampleAccumulator().mean();
+        Real calculated = batchModel.sampleAccumulator().mean();
+        Size count = batchModel.sampleAccumulator().samples();
+        if (count != model.sampleAccumulator().samples()
+            || std::fabs(calculated-expected) > 1.0e-12*expected)
+            BOOST_ERROR("failed to reproduce Monte Carlo results:"
+                        << std::setprecision(13)
+                        << "\n    samples:    " << count
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+}
+
+
 test_suite* PathGeneratorTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &PathGeneratorTest::testMultiPathBatchGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testBatchMonteCarloModel));
     return suite;
 }
 
@@ -29,6 +29,8 @@ class PathGeneratorTest {
   public:
     static void testPathGenerator();
     static void testMultiPathGenerator();
+    static void testMultiPathBatchGenerator();
+    static void testBatchMonteCarloModel();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -21,6 +21,7 @@
 #include "utilities.hpp"
 #include <ql/cashflows/iborcoupon.hpp>
 #include <ql/indexes/bmaindex.hpp>
+#include <ql/indexes/ibor/eonia.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/indexes/ibor/jpylibor.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
@@ -39,6 +40,8 @@
 #include <ql/termstructures/globalbootstrap.hpp>
 #include <ql/termstructures/yield/bondhelpers.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/multicurve.hpp>
+#include <ql/termstructures/yield/oisratehelper.hpp>
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
 #include <ql/termstructures/yield/ratehelpers.hpp>
 #include <ql/time/asx.hpp>
@@ -656,6 +659,35 @@ namespace piecewise_yield_curve_test {
         string expMsg;
     };
 
+    // forwards to another helper, counting its repricings
+    class CountingHelper : public RateHelper {
+      public:
+        explicit CountingHelper(const ext::shared_ptr<RateHelper>& helper)
+        : RateHelper(helper->quote()), helper_(helper), repricings_(0) {
+            registerWith(helper_);
+        }
+        Real impliedQuote() const override {
+            ++repricings_;
+            return helper_->impliedQuote();
+        }
+        void setTermStructure(YieldTermStructure* t) override {
+            RateHelper::setTermStructure(t);
+            helper_->setTermStructure(t);
+        }
+        Date earliestDate() const override { return helper_->earliestDate(); }
+        Date maturityDate() const override { return helper_->maturityDate(); }
+        Date latestRelevantDate() const override {
+            return helper_->latestRelevantDate();
+        }
+        Date pillarDate() const override { return helper_->pillarDate(); }
+        Date latestDate() const override { return helper_->latestDate(); }
+        Size repricings() const { return repricings_; }
+        void reset() { repricings_ = 0; }
+      private:
+        ext::shared_ptr<RateHelper> helper_;
+        mutable Size repricings_;
+    };
+
 }
 
 
@@ -1499,6 +1531,308 @@ void PiecewiseYieldCurveTest::testIterativeBootstrapRetries() {
     BOOST_CHECK_SMALL(calcFwd - expFwd, 1e-10);
 }
 
+void PiecewiseYieldCurveTest::testIncrementalBootstrap() {
+
+    BOOST_TEST_MESSAGE("Testing incremental bootstrap and quote Jacobian...");
+
+    using namespace piecewise_yield_curve_test;
+
+    CommonVars vars;
+
+    typedef PiecewiseYieldCurve<Discount, LogLinear> Curve;
+    Curve::bootstrap_type incremental(Null<Real>(), Null<Real>(), Null<Real>(),
+                                      1, 2.0, 2.0, false, 10, true, true);
+    auto curve = ext::make_shared<Curve>(vars.today, vars.instruments,
+                                         Actual360(), incremental);
+
+    vector<Real> data = curve->data();
+    const Matrix jacobian = curve->jacobian();
+    const Size n = vars.instruments.size();
+    if (jacobian.rows() != n || jacobian.columns() != n)
+        BOOST_FAIL("wrong Jacobian size: " << jacobian.rows() << "x"
+                   << jacobian.columns() << ", " << n << "x" << n
+                   << " expected");
+
+    // sensitivities by full bootstraps of a bumped curve
+    Real bump = 1.0e-5, tolerance = 1.0e-6;
+    for (Size j=0; j<n; j+=3) {
+        Real rate = vars.rates[j]->value();
+        vars.rates[j]->setValue(rate + bump);
+        vector<Real> up = Curve(vars.today, vars.instruments,
+                                Actual360()).data();
+        vars.rates[j]->setValue(rate - bump);
+        vector<Real> down = Curve(vars.today, vars.instruments,
+                                  Actual360()).data();
+        vars.rates[j]->setValue(rate);
+        for (Size i=0; i<n; ++i) {
+            Real expected = (up[i+1] - down[i+1]) / (2.0*bump);
+            if (std::fabs(jacobian[i][j] - expected) > tolerance)
+                BOOST_ERROR("wrong sensitivity of node #" << i+1
+                            << " to quote #" << j+1
+                            << "\n    calculated: " << jacobian[i][j]
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    // the later quotes are changed; the earlier nodes are kept and
+    // the result equals a full bootstrap
+    Size k = vars.deposits + 2;
+    vars.rates[k]->setValue(vars.rates[k]->value() + 0.0010);
+    vars.rates[n-1]->setValue(vars.rates[n-1]->value() - 0.0005);
+    vector<Real> updated = curve->data();
+    Matrix updatedJacobian = curve->jacobian();
+    Curve full(vars.today, vars.instruments, Actual360(),
+               Curve::bootstrap_type(Null<Real>(), Null<Real>(), Null<Real>(),
+                                     1, 2.0, 2.0, false, 10, false, true));
+    vector<Real> expected = full.data();
+    Matrix expectedJacobian = full.jacobian();
+
+    for (Size i=0; i<=n; ++i) {
+        if (i <= k && updated[i] != data[i])
+            BOOST_ERROR("node #" << i << " solved again");
+        if (std::fabs(updated[i] - expected[i]) > 1.0e-10)
+            BOOST_ERROR("wrong incremental bootstrap for node #" << i
+                        << std::setprecision(12)
+                        << "\n    calculated: " << updated[i]
+                        << "\n    expected:   " << expected[i]);
+    }
+    for (Size i=0; i<n; ++i) {
+        for (Size j=0; j<n; ++j) {
+            if (std::fabs(updatedJacobian[i][j] - expectedJacobian[i][j]) > 1.0e-8)
+                BOOST_ERROR("wrong incremental Jacobian for node #" << i+1
+                            << " and quote #" << j+1
+                            << "\n    calculated: " << updatedJacobian[i][j]
+                            << "\n    expected:   " << expectedJacobian[i][j]);
+        }
+    }
+
+    // an exogenous discount curve changing together with a quote
+    // causes all the nodes to be solved again
+    RelinkableHandle<YieldTermStructure> discountCurve(
+                                 flatRate(vars.today, 0.02, Actual360()));
+    std::vector<ext::shared_ptr<RateHelper> > helpers(
+        vars.instruments.begin(), vars.instruments.begin() + vars.deposits);
+    auto euribor6m = ext::make_shared<Euribor6M>();
+    for (Size i=0; i<vars.swaps; ++i)
+        helpers.push_back(ext::make_shared<SwapRateHelper>(
+            Handle<Quote>(vars.rates[i+vars.deposits]),
+            swapData[i].n*swapData[i].units, vars.calendar,
+            vars.fixedLegFrequency, vars.fixedLegConvention,
+            vars.fixedLegDayCounter, euribor6m, Handle<Quote>(),
+            0*Days, discountCurve));
+    Curve exogenous(vars.today, helpers, Actual360(), incremental);
+    exogenous.data();
+
+    discountCurve.linkTo(flatRate(vars.today, 0.03, Actual360()));
+    vars.rates[n-1]->setValue(vars.rates[n-1]->value() + 0.0005);
+    updated = exogenous.data();
+    expected = Curve(vars.today, helpers, Actual360()).data();
+    for (Size i=0; i<=n; ++i) {
+        if (std::fabs(updated[i] - expected[i]) > 1.0e-10)
+            BOOST_ERROR("wrong incremental bootstrap for node #" << i
+                        << " after change of exogenous curve"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << updated[i]
+                        << "\n    expected:   " << expected[i]);
+    }
+}
+
+void PiecewiseYieldCurveTest::testGlobalBootstrapSparseJacobian() {
+
+    BOOST_TEST_MESSAGE("Testing global bootstrap with sparse Jacobian...");
+
+    using namespace piecewise_yield_curve_test;
+
+    CommonVars vars;
+
+    typedef PiecewiseYieldCurve<Discount, LogLinear, GlobalBootstrap> Curve;
+    Curve dense(vars.today, vars.instruments, Actual360(),
+                Curve::bootstrap_type(Null<Real>(), false));
+    Curve sparse(vars.today, vars.instruments, Actual360(),
+                 Curve::bootstrap_type(Null<Real>(), true));
+
+    // the dependencies are detected again at each bootstrap
+    for (Size k=0; k<2; ++k) {
+        vector<Real> expected = dense.data();
+        vector<Real> calculated = sparse.data();
+        for (Size i=0; i<expected.size(); ++i) {
+            if (std::fabs(calculated[i] - expected[i]) > 1.0e-9)
+                BOOST_ERROR("failed to reproduce node #" << i
+                            << " with sparse Jacobian"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated[i]
+                            << "\n    expected:   " << expected[i]);
+        }
+        for (Size i=0; i<vars.instruments.size(); ++i) {
+            Real error = vars.instruments[i]->quote()->value() -
+                         vars.instruments[i]->impliedQuote();
+            if (std::fabs(error) > 1.0e-10)
+                BOOST_ERROR("failed to reprice helper #" << i+1
+                            << "\n    error: " << error);
+        }
+        vars.rates[vars.deposits+3]->setValue(
+                                    vars.rates[vars.deposits+3]->value() + 0.0010);
+    }
+}
+
+void PiecewiseYieldCurveTest::testGlobalBootstrapSparseRepricings() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing helper repricings of global bootstrap with sparse Jacobian...");
+
+    using namespace piecewise_yield_curve_test;
+
+    CommonVars vars;
+
+    vector<ext::shared_ptr<CountingHelper> > denseHelpers, sparseHelpers;
+    vector<ext::shared_ptr<RateHelper> > denseInstruments, sparseInstruments;
+    for (const auto& helper : vars.instruments) {
+        denseHelpers.push_back(ext::make_shared<CountingHelper>(helper));
+        denseInstruments.push_back(denseHelpers.back());
+        sparseHelpers.push_back(ext::make_shared<CountingHelper>(helper));
+        sparseInstruments.push_back(sparseHelpers.back());
+    }
+
+    typedef PiecewiseYieldCurve<Discount, LogLinear, GlobalBootstrap> Curve;
+    Curve dense(vars.today, denseInstruments, Actual360(),
+                Curve::bootstrap_type(Null<Real>(), false));
+    Curve sparse(vars.today, sparseInstruments, Actual360(),
+                 Curve::bootstrap_type(Null<Real>(), true));
+
+    // each bootstrap detects the dependencies with a full calculation
+    // of the Jacobian, and then only reprices the affected helpers
+    for (Size k=0; k<2; ++k) {
+        for (Size i=0; i<vars.instruments.size(); ++i) {
+            denseHelpers[i]->reset();
+            sparseHelpers[i]->reset();
+        }
+        dense.recalculate();
+        sparse.recalculate();
+
+        Size denseRepricings = 0, sparseRepricings = 0;
+        for (Size i=0; i<vars.instruments.size(); ++i) {
+            denseRepricings += denseHelpers[i]->repricings();
+            sparseRepricings += sparseHelpers[i]->repricings();
+        }
+        BOOST_TEST_MESSAGE("    bootstrap #" << k+1 << ": "
+                           << denseRepricings << " repricings with dense, "
+                           << sparseRepricings << " with sparse Jacobian");
+        if (sparseRepricings == 0 || sparseRepricings >= denseRepricings)
+            BOOST_ERROR("sparse Jacobian failed to save repricings in "
+                        "bootstrap #" << k+1
+                        << "\n    dense:  " << denseRepricings
+                        << "\n    sparse: " << sparseRepricings);
+
+        // the short-dated helpers are not affected by later nodes
+        const Size last = vars.instruments.size()-1;
+        if (sparseHelpers[0]->repricings() >= sparseHelpers[last]->repricings())
+            BOOST_ERROR("first helper repriced as often as the last one "
+                        "in bootstrap #" << k+1
+                        << "\n    first: " << sparseHelpers[0]->repricings()
+                        << "\n    last:  " << sparseHelpers[last]->repricings());
+
+        vars.rates[vars.deposits+3]->setValue(
+                                    vars.rates[vars.deposits+3]->value() + 0.0010);
+    }
+}
+
+void PiecewiseYieldCurveTest::testMultiCurve() {
+
+    BOOST_TEST_MESSAGE("Testing bootstrap of a set of interdependent curves...");
+
+    using namespace piecewise_yield_curve_test;
+
+    CommonVars vars;
+
+    typedef PiecewiseYieldCurve<Discount, LogLinear> Curve;
+
+    // the overnight curve is discounted on the 6M curve and the 6M
+    // curve on the overnight one, so that they must be solved
+    // together; the 3M curve depends on them, the deposit curve is
+    // independent
+    RelinkableHandle<YieldTermStructure> overnightCurve, euribor6MCurve;
+    Period tenors[] = { 1*Years, 2*Years, 3*Years, 5*Years, 7*Years, 10*Years };
+    Size n = LENGTH(tenors);
+
+    vector<ext::shared_ptr<SimpleQuote> > overnightQuotes, euribor6MQuotes,
+                                          euribor3MQuotes, depositQuotes;
+    vector<ext::shared_ptr<RateHelper> > overnightHelpers, euribor6MHelpers,
+                                         euribor3MHelpers, depositHelpers;
+    for (Size i=0; i<n; ++i) {
+        overnightQuotes.push_back(
+            ext::make_shared<SimpleQuote>(0.010 + 0.0010*i));
+        overnightHelpers.push_back(ext::make_shared<OISRateHelper>(
+            2, tenors[i], Handle<Quote>(overnightQuotes.back()),
+            ext::make_shared<Eonia>(), euribor6MCurve));
+        euribor6MQuotes.push_back(
+            ext::make_shared<SimpleQuote>(0.013 + 0.0010*i));
+        euribor6MHelpers.push_back(ext::make_shared<SwapRateHelper>(
+            Handle<Quote>(euribor6MQuotes.back()), tenors[i], vars.calendar,
+            Annual, Unadjusted, Thirty360(Thirty360::BondBasis),
+            ext::make_shared<Euribor6M>(), Handle<Quote>(), 0*Days,
+            overnightCurve));
+        euribor3MQuotes.push_back(
+            ext::make_shared<SimpleQuote>(0.012 + 0.0010*i));
+        euribor3MHelpers.push_back(ext::make_shared<SwapRateHelper>(
+            Handle<Quote>(euribor3MQuotes.back()), tenors[i], vars.calendar,
+            Annual, Unadjusted, Thirty360(Thirty360::BondBasis),
+            ext::make_shared<Euribor3M>(), Handle<Quote>(), 0*Days,
+            overnightCurve));
+        depositQuotes.push_back(
+            ext::make_shared<SimpleQuote>(0.011 + 0.0005*i));
+        depositHelpers.push_back(ext::make_shared<DepositRateHelper>(
+            Handle<Quote>(depositQuotes.back()), (2*i+1)*Months,
+            vars.settlementDays, vars.calendar, ModifiedFollowing, false,
+            Actual360()));
+    }
+
+    MultiCurve curves;
+    ext::shared_ptr<YieldTermStructure> overnight =
+        ext::make_shared<Curve>(vars.today, overnightHelpers, Actual360());
+    ext::shared_ptr<YieldTermStructure> euribor6M =
+        ext::make_shared<Curve>(vars.today, euribor6MHelpers, Actual360());
+    overnightCurve.linkTo(overnight);
+    euribor6MCurve.linkTo(euribor6M);
+    curves.add(overnight, overnightHelpers);
+    curves.add(euribor6M, euribor6MHelpers);
+    curves.add(ext::make_shared<Curve>(vars.today, euribor3MHelpers,
+                                       Actual360()),
+               euribor3MHelpers);
+    curves.add(ext::make_shared<Curve>(vars.today, depositHelpers,
+                                       Actual360()),
+               depositHelpers);
+
+    if (curves.levels() != 2)
+        BOOST_FAIL("wrong number of levels: " << curves.levels()
+                   << ", 2 expected");
+    const vector<vector<Size> >& blocks = curves.blocks();
+    if (blocks.size() != 3 || curves.levelStart(1) != 2
+        || blocks[0] != vector<Size>({0, 1})
+        || blocks[1] != vector<Size>({3})
+        || blocks[2] != vector<Size>({2}))
+        BOOST_FAIL("wrong dependencies between curves");
+
+    auto checkHelpers = [&](const std::string& when) {
+        for (Size i=0; i<curves.size(); ++i) {
+            for (Size j=0; j<curves.helpers(i).size(); ++j) {
+                Real error = curves.helpers(i)[j]->quoteError();
+                if (std::fabs(error) > 1.0e-9)
+                    BOOST_ERROR("failed to reprice helper #" << j+1
+                                << " of curve #" << i << " " << when
+                                << "\n    error: " << error);
+            }
+        }
+    };
+
+    curves.calculate();
+    checkHelpers("after first bootstrap");
+
+    curves.setQuotes({ overnightQuotes[3], euribor6MQuotes[4] },
+                     { overnightQuotes[3]->value() + 0.0010,
+                       euribor6MQuotes[4]->value() - 0.0005 });
+    checkHelpers("after quote changes");
+}
+
 test_suite* PiecewiseYieldCurveTest::suite() {
 
     auto* suite = BOOST_TEST_SUITE("Piecewise yield curve tests");
@@ -1555,8 +1889,13 @@ test_suite* PiecewiseYieldCurveTest::suite() {
 #ifndef QL_USE_INDEXED_COUPON
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testGlobalBootstrap));
 #endif
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testGlobalBootstrapSparseJacobian));
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testGlobalBootstrapSparseRepricings));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testIterativeBootstrapRetries));
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testIncrementalBootstrap));
+
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testMultiCurve));
 
     return suite;
 }
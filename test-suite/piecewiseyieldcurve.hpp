@@ -59,8 +59,13 @@ class PiecewiseYieldCurveTest {
     static void testLargeRates();
 
     static void testGlobalBootstrap();
+    static void testGlobalBootstrapSparseJacobian();
+    static void testGlobalBootstrapSparseRepricings();
 
     static void testIterativeBootstrapRetries();
+    static void testIncrementalBootstrap();
+
+    static void testMultiCurve();
 
     static boost::unit_test_framework::test_suite* suite();
 };
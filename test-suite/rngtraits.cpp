@@ -92,11 +92,108 @@ void RngTraitsTest::testCustomPoisson() {
 }
 
 
+void RngTraitsTest::testPhilox() {
+
+    BOOST_TEST_MESSAGE("Testing Philox counter-based random number generation...");
+
+    // known-answer test from the Random123 distribution:
+    // key (0xa4093822, 0x299f31d0), counter (0x243f6a88,
+    // 0x85a308d3, 0x13198a2e, 0x03707344)
+    const boost::uint_least64_t block = 0x85a308d3243f6a88ULL;
+    const boost::uint_least64_t stream = 0x0370734413198a2eULL;
+    PhiloxUniformRng philox(0x299f31d0a4093822ULL, stream);
+    // each draw consumes a quarter of a block
+    for (Size i=0; i<4; ++i)
+        philox.skip(block);
+
+    const unsigned long expected[] = {
+        0xd16cfe09UL, 0x94fdccebUL, 0x5001e420UL, 0x24126ea1UL
+    };
+    for (Size i=0; i<4; ++i) {
+        unsigned long calculated = philox.nextInt32();
+        if (calculated != expected[i])
+            BOOST_FAIL("Philox test failed at index " << i << "\n"
+                       << std::hex
+                       << "    calculated: " << calculated << "\n"
+                       << "    expected:   " << expected[i]);
+    }
+
+    // skipping must be equivalent to drawing
+    for (Size skip=0; skip<10; ++skip) {
+        PhiloxUniformRng rng1(42, 7), rng2(42, 7);
+        rng1.nextInt32();
+        rng2.nextInt32();
+        for (Size i=0; i<skip; ++i)
+            rng1.nextInt32();
+        rng2.skip(skip);
+        for (Size i=0; i<10; ++i) {
+            if (rng1.nextInt32() != rng2.nextInt32())
+                BOOST_FAIL("skipping " << skip << " draws "
+                           "differs from drawing them");
+        }
+    }
+}
+
+
+void RngTraitsTest::testStreams() {
+
+    BOOST_TEST_MESSAGE("Testing random-number streams...");
+
+    const Size dimension = 10, samples = 100;
+    const BigNatural seed = 1234;
+
+    // stream 0 is the default sequence
+    PseudoRandom::rsg_type rsg1 =
+        PseudoRandom::make_sequence_generator(dimension, seed);
+    PseudoRandom::rsg_type rsg2 =
+        PseudoRandom::make_sequence_generator(dimension, seed, 0);
+    for (Size i=0; i<samples; ++i) {
+        if (rsg1.nextSequence().value != rsg2.nextSequence().value)
+            BOOST_FAIL("stream 0 differs from default sequence "
+                       "at sample " << i);
+    }
+
+    // skipping samples is equivalent to drawing them
+    PseudoRandom::rsg_type rsg3 =
+        PseudoRandom::make_sequence_generator(dimension, seed);
+    rsg3.skip(samples);
+    if (rsg1.nextSequence().value != rsg3.nextSequence().value)
+        BOOST_FAIL("skipping Mersenne-twister samples "
+                   "differs from drawing them");
+
+    // Philox streams are its native substreams
+    for (Size stream=0; stream<4; ++stream) {
+        PhiloxPseudoRandom::rsg_type rsg =
+            PhiloxPseudoRandom::make_sequence_generator(dimension, seed,
+                                                        stream);
+        PhiloxUniformRng philox(seed, stream);
+        InverseCumulativeNormal icn;
+        for (Size i=0; i<samples; ++i) {
+            const std::vector<Real>& x = rsg.nextSequence().value;
+            for (Size j=0; j<dimension; ++j) {
+                if (x[j] != icn(philox.nextReal()))
+                    BOOST_FAIL("Philox stream " << stream << " differs "
+                               "from native substream at sample " << i);
+            }
+        }
+
+        PhiloxPseudoRandom::rsg_type skipped =
+            PhiloxPseudoRandom::make_sequence_generator(dimension, seed,
+                                                        stream);
+        skipped.skip(samples);
+        if (skipped.nextSequence().value != rsg.nextSequence().value)
+            BOOST_FAIL("skipping Philox samples differs from drawing them");
+    }
+}
+
+
 test_suite* RngTraitsTest::suite() {
     auto* suite = BOOST_TEST_SUITE("RNG traits tests");
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testGaussian));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testDefaultPoisson));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCustomPoisson));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testPhilox));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testStreams));
     return suite;
 }
 
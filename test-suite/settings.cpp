@@ -20,6 +20,10 @@
 #include "settings.hpp"
 #include "utilities.hpp"
 #include <ql/settings.hpp>
+#include <ql/threadlocalsettings.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/daycounters/actual360.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -60,8 +64,166 @@ void SettingsTest::testNotificationsOnDateChange() {
         BOOST_ERROR("missing notification");
 }
 
+void SettingsTest::testThreadLocalSettings() {
+    BOOST_TEST_MESSAGE("Testing thread-local settings...");
+
+    SavedSettings rollback;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, March, 2021);
+    Settings::instance().evaluationDate() = today;
+    Settings::instance().includeReferenceDateEvents() = true;
+
+    TimeSeries<Real> history;
+    history[today - 1] = 0.01;
+    IndexManager::instance().setHistory("Foo", history);
+
+    const Size n = 8;
+    std::vector<Date> referenceDates(n);
+    std::vector<char> fixingSeen(n, 0), flagCopied(n, 0);
+    #pragma omp parallel for
+    for (long i=0; i<(long)n; ++i) {
+        ThreadLocalSettings local;
+        flagCopied[i] = Settings::instance().includeReferenceDateEvents();
+        Settings::instance().evaluationDate() = today + i;
+
+        FlatForward curve(0, NullCalendar(), 0.01, Actual360());
+        referenceDates[i] = curve.referenceDate();
+
+        fixingSeen[i] =
+            IndexManager::instance().hasHistoricalFixing("FOO", today - 1);
+        TimeSeries<Real> h = IndexManager::instance().getHistory("foo");
+        h[today + i] = 0.02;
+        IndexManager::instance().setHistory("foo", h);
+        IndexManager::instance().setHistory("Bar", h);
+    }
+
+    for (Size i=0; i<n; ++i) {
+        if (referenceDates[i] != today + i)
+            BOOST_ERROR("wrong reference date in scenario #" << i
+                        << "\n    calculated: " << referenceDates[i]
+                        << "\n    expected:   " << today + i);
+        if (fixingSeen[i] == 0)
+            BOOST_ERROR("global fixing not seen in scenario #" << i);
+        if (flagCopied[i] == 0)
+            BOOST_ERROR("settings not copied in scenario #" << i);
+    }
+
+    if (Settings::instance().evaluationDate() != today)
+        BOOST_ERROR("global evaluation date modified");
+    if (IndexManager::instance().getHistory("Foo").size() != 1
+        || IndexManager::instance().hasHistory("Bar"))
+        BOOST_ERROR("global fixings modified");
+
+    // nested instances and cleared histories
+    {
+        ThreadLocalSettings outer;
+        Settings::instance().evaluationDate() = today + 10;
+        IndexManager::instance().clearHistory("foo");
+        {
+            ThreadLocalSettings inner;
+            if (Settings::instance().evaluationDate() != today + 10)
+                BOOST_ERROR("outer evaluation date not copied");
+            if (IndexManager::instance().hasHistory("Foo"))
+                BOOST_ERROR("cleared history seen by inner view");
+            Settings::instance().evaluationDate() = today + 20;
+        }
+        if (Settings::instance().evaluationDate() != today + 10)
+            BOOST_ERROR("outer evaluation date not restored");
+    }
+    if (Settings::instance().evaluationDate() != today
+        || !IndexManager::instance().hasHistory("Foo"))
+        BOOST_ERROR("global settings not restored");
+}
+
+void SettingsTest::testSharedSettings() {
+    BOOST_TEST_MESSAGE("Testing propagation of thread-local settings...");
+
+    SavedSettings rollback;
+
+    Date today(15, March, 2021);
+    Settings::instance().evaluationDate() = today;
+
+    ThreadLocalSettings local;
+    Settings::instance().evaluationDate() = today + 3;
+    const SharedSettings shared;
+
+    // worker threads see the settings of the calling thread
+    const Size n = 8;
+    std::vector<Date> seen(n);
+    #pragma omp parallel for
+    for (long i=0; i<(long)n; ++i) {
+        const SharedSettings::Scope scope(shared);
+        seen[i] = Settings::instance().evaluationDate();
+    }
+    for (Size i=0; i<n; ++i) {
+        if (seen[i] != today + 3)
+            BOOST_ERROR("wrong evaluation date seen by worker #" << i
+                        << "\n    seen:     " << seen[i]
+                        << "\n    expected: " << today + 3);
+    }
+
+    // scopes replace other settings and restore them on exit
+    {
+        ThreadLocalSettings other;
+        Settings::instance().evaluationDate() = today + 5;
+        {
+            const SharedSettings::Scope scope(shared);
+            if (Settings::instance().evaluationDate() != today + 3)
+                BOOST_ERROR("shared settings not seen in scope");
+        }
+        if (Settings::instance().evaluationDate() != today + 5)
+            BOOST_ERROR("settings not restored after scope");
+    }
+}
+
+void SettingsTest::testSharedFixings() {
+    BOOST_TEST_MESSAGE("Testing fixings read through shared settings...");
+
+    SavedSettings rollback;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, March, 2021);
+    Settings::instance().evaluationDate() = today;
+
+    const Size names = 16;
+    for (Size k=0; k<names; ++k) {
+        TimeSeries<Real> history;
+        history[today - 1] = 0.01 * (k+1);
+        IndexManager::instance().setHistory("Foo" + std::to_string(k),
+                                            history);
+    }
+
+    // the fixings of the view are copied concurrently by the workers
+    ThreadLocalSettings local;
+    const SharedSettings shared;
+
+    const Size n = 1024;
+    std::vector<Real> seen(n, Null<Real>());
+    std::vector<char> found(n, 0);
+    #pragma omp parallel for
+    for (long i=0; i<(long)n; ++i) {
+        const SharedSettings::Scope scope(shared);
+        std::string name = "FOO" + std::to_string(i % names);
+        found[i] =
+            IndexManager::instance().hasHistoricalFixing(name, today - 1);
+        seen[i] = IndexManager::instance().getHistory(name)[today - 1];
+        IndexManager::instance().notifier("Bar" + std::to_string(i % names));
+    }
+    for (Size i=0; i<n; ++i) {
+        Real expected = 0.01 * (i % names + 1);
+        if (found[i] == 0 || seen[i] != expected)
+            BOOST_ERROR("wrong fixing seen by worker #" << i
+                        << "\n    seen:     " << seen[i]
+                        << "\n    expected: " << expected);
+    }
+}
+
 test_suite* SettingsTest::suite() {
     auto* suite = BOOST_TEST_SUITE("SettingsTest tests");
     suite->add(QUANTLIB_TEST_CASE(&SettingsTest::testNotificationsOnDateChange));
+    suite->add(QUANTLIB_TEST_CASE(&SettingsTest::testThreadLocalSettings));
+    suite->add(QUANTLIB_TEST_CASE(&SettingsTest::testSharedSettings));
+    suite->add(QUANTLIB_TEST_CASE(&SettingsTest::testSharedFixings));
     return suite;
 }
@@ -28,6 +28,9 @@
 class SettingsTest {
   public:
     static void testNotificationsOnDateChange();
+    static void testThreadLocalSettings();
+    static void testSharedSettings();
+    static void testSharedFixings();
     static boost::unit_test_framework::test_suite* suite();
 };
 
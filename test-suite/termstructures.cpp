@@ -19,7 +19,14 @@
 
 #include "termstructures.hpp"
 #include "utilities.hpp"
+#include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/simplecashflow.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/yield/compositezeroyieldstructure.hpp>
+#include <ql/termstructures/yield/discountcurve.hpp>
+#include <ql/termstructures/yield/forwardcurve.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/termstructures/yield/ratehelpers.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
@@ -34,6 +41,7 @@
 #include <ql/indexes/iborindex.hpp>
 #include <ql/currency.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <iomanip>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -420,6 +428,198 @@ void TermStructureTest::testCompositeZeroYieldStructures() {
     }
 }
 
+void TermStructureTest::testBatchDiscount() {
+
+    BOOST_TEST_MESSAGE("Testing discount factors over arrays of times...");
+
+    SavedSettings backup;
+
+    Calendar calendar = TARGET();
+    Date today = calendar.adjust(Date::todaysDate());
+    Settings::instance().evaluationDate() = today;
+    DayCounter dayCounter = Actual360();
+
+    std::vector<Date> dates;
+    std::vector<DiscountFactor> discounts;
+    Integer days[] = { 0, 30, 91, 182, 365, 730, 1826, 3652, 7305 };
+    for (Size i=0; i<LENGTH(days); ++i) {
+        dates.push_back(today + days[i]);
+        discounts.push_back(std::exp(-0.03*days[i]/360.0 - 1.0e-6*i*i));
+    }
+    std::vector<Rate> rates;
+    for (Size i=0; i<LENGTH(days); ++i)
+        rates.push_back(0.02 + 0.001*i);
+    std::vector<Handle<Quote> > jumps(1,
+        Handle<Quote>(ext::make_shared<SimpleQuote>(0.999)));
+    std::vector<Date> jumpDates(1, today + 400);
+
+    std::vector<ext::shared_ptr<RateHelper> > helpers;
+    for (Integer m=1; m<=12; ++m)
+        helpers.push_back(ext::make_shared<DepositRateHelper>(
+            0.03 + 0.0005*m, m*Months, 0, calendar, ModifiedFollowing,
+            false, dayCounter));
+
+    std::vector<std::pair<std::string, ext::shared_ptr<YieldTermStructure> > >
+        curves = {
+            { "log-linear discount curve",
+              ext::make_shared<DiscountCurve>(dates, discounts, dayCounter) },
+            { "cubic discount curve",
+              ext::make_shared<InterpolatedDiscountCurve<Cubic> >(
+                  dates, discounts, dayCounter, Cubic()) },
+            { "discount curve with jumps",
+              ext::make_shared<DiscountCurve>(dates, discounts, dayCounter,
+                                              calendar, jumps, jumpDates) },
+            { "piecewise discount curve",
+              ext::make_shared<PiecewiseYieldCurve<Discount, LogLinear> >(
+                  today, helpers, dayCounter) },
+            { "linear zero curve",
+              ext::make_shared<ZeroCurve>(dates, rates, dayCounter) },
+            { "cubic zero curve",
+              ext::make_shared<InterpolatedZeroCurve<Cubic> >(
+                  dates, rates, dayCounter, Cubic()) },
+            { "backward-flat forward curve",
+              ext::make_shared<ForwardCurve>(dates, rates, dayCounter) },
+            { "flat forward curve",
+              ext::make_shared<FlatForward>(today, 0.03, dayCounter) }
+        };
+    Handle<YieldTermStructure> original(curves.front().second);
+    Handle<Quote> spread(ext::make_shared<SimpleQuote>(0.001));
+    curves.emplace_back("implied curve",
+        ext::make_shared<ImpliedTermStructure>(original, today + 180));
+    curves.emplace_back("forward-spreaded curve",
+        ext::make_shared<ForwardSpreadedTermStructure>(original, spread));
+    curves.emplace_back("zero-spreaded curve",
+        ext::make_shared<ZeroSpreadedTermStructure>(original, spread,
+                                                    Compounded, Semiannual));
+
+    // sorted and unsorted times, beyond the last node as well
+    std::vector<Time> times;
+    for (Time t=0.0; t<25.0; t+=0.05)
+        times.push_back(t);
+    for (Size k=0; k<100; ++k)
+        times.push_back(std::fmod(k*3.17, 25.0));
+    std::vector<DiscountFactor> calculated(times.size());
+
+    for (auto& curve : curves) {
+        curve.second->discount(&times[0], &calculated[0], times.size(), true);
+        for (Size i=0; i<times.size(); ++i) {
+            DiscountFactor expected = curve.second->discount(times[i], true);
+            if (std::fabs(calculated[i] - expected) > 1.0e-14)
+                BOOST_ERROR("failed to reproduce discount factor for "
+                            << curve.first
+                            << std::setprecision(16)
+                            << "\n    time:       " << times[i]
+                            << "\n    calculated: " << calculated[i]
+                            << "\n    expected:   " << expected);
+        }
+        if (curve.second->maxTime() < 25.0)
+            BOOST_CHECK_THROW(curve.second->discount(&times[0],
+                                                     &calculated[0],
+                                                     times.size()),
+                              Error);
+    }
+}
+
+void TermStructureTest::testBatchForwardRates() {
+
+    BOOST_TEST_MESSAGE("Testing discount factors and forward rates "
+                       "over arrays of dates...");
+
+    SavedSettings backup;
+
+    Calendar calendar = TARGET();
+    Date today = calendar.adjust(Date::todaysDate());
+    Settings::instance().evaluationDate() = today;
+    DayCounter dayCounter = Actual360();
+
+    std::vector<Date> dates;
+    std::vector<Rate> rates;
+    Integer days[] = { 0, 30, 91, 182, 365, 730, 1826, 3652, 7305 };
+    for (Size i=0; i<LENGTH(days); ++i) {
+        dates.push_back(today + days[i]);
+        rates.push_back(0.02 + 0.001*i);
+    }
+    ext::shared_ptr<YieldTermStructure> curve =
+        ext::make_shared<ZeroCurve>(dates, rates, dayCounter);
+
+    // consecutive periods of a schedule, plus an empty one
+    std::vector<Date> start, end;
+    for (Size i=0; i<40; ++i) {
+        start.push_back(calendar.advance(today, 3*i, Months));
+        end.push_back(calendar.advance(today, 3*(i+1), Months));
+    }
+    start.push_back(today + 100);
+    end.push_back(today + 100);
+    const Size n = start.size();
+
+    std::vector<DiscountFactor> discounts(n);
+    curve->discount(&end[0], &discounts[0], n);
+    for (Size i=0; i<n; ++i) {
+        DiscountFactor expected = curve->discount(end[i]);
+        if (std::fabs(discounts[i] - expected) > 1.0e-15)
+            BOOST_ERROR("failed to reproduce discount factor"
+                        << std::setprecision(16)
+                        << "\n    date:       " << end[i]
+                        << "\n    calculated: " << discounts[i]
+                        << "\n    expected:   " << expected);
+    }
+
+    DayCounter resultDayCounter = Thirty360(Thirty360::BondBasis);
+    Compounding compounding[] = { Simple, Compounded, Continuous };
+    std::vector<Rate> calculated(n);
+    for (auto comp : compounding) {
+        curve->forwardRate(&start[0], &end[0], &calculated[0], n,
+                           resultDayCounter, comp, Quarterly);
+        for (Size i=0; i<n; ++i) {
+            Rate expected = curve->forwardRate(start[i], end[i],
+                                               resultDayCounter,
+                                               comp, Quarterly);
+            if (std::fabs(calculated[i] - expected) > 1.0e-12)
+                BOOST_ERROR("failed to reproduce forward rate"
+                            << std::setprecision(16)
+                            << "\n    compounding: " << comp
+                            << "\n    start:       " << start[i]
+                            << "\n    end:         " << end[i]
+                            << "\n    calculated:  " << calculated[i]
+                            << "\n    expected:    " << expected);
+        }
+
+        std::vector<Time> t1(n), t2(n);
+        for (Size i=0; i<n; ++i) {
+            t1[i] = curve->timeFromReference(start[i]);
+            t2[i] = curve->timeFromReference(end[i]);
+        }
+        curve->forwardRate(&t1[0], &t2[0], &calculated[0], n,
+                           comp, Quarterly);
+        for (Size i=0; i<n; ++i) {
+            Rate expected = curve->forwardRate(t1[i], t2[i],
+                                               comp, Quarterly);
+            if (std::fabs(calculated[i] - expected) > 1.0e-12)
+                BOOST_ERROR("failed to reproduce forward rate"
+                            << std::setprecision(16)
+                            << "\n    compounding: " << comp
+                            << "\n    start time:  " << t1[i]
+                            << "\n    end time:    " << t2[i]
+                            << "\n    calculated:  " << calculated[i]
+                            << "\n    expected:    " << expected);
+        }
+    }
+
+    // the discount factors are retrieved in a single batch
+    Leg leg;
+    for (Size i=0; i<40; ++i)
+        leg.push_back(ext::make_shared<SimpleCashFlow>(100.0 + i, end[i]));
+    Real expected = 0.0;
+    for (const auto& cf : leg)
+        expected += cf->amount() * curve->discount(cf->date());
+    Real calculatedNPV = CashFlows::npv(leg, *curve, false, today, today);
+    if (std::fabs(calculatedNPV - expected) > 1.0e-10)
+        BOOST_ERROR("failed to reproduce leg NPV"
+                    << std::setprecision(16)
+                    << "\n    calculated: " << calculatedNPV
+                    << "\n    expected:   " << expected);
+}
+
 test_suite* TermStructureTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Term structure tests");
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testReferenceChange));
@@ -435,6 +635,8 @@ test_suite* TermStructureTest::suite() {
                              &TermStructureTest::testLinkToNullUnderlying));
     suite->add(QUANTLIB_TEST_CASE(
                     &TermStructureTest::testCompositeZeroYieldStructures));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testBatchDiscount));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testBatchForwardRates));
     return suite;
 }
 
@@ -37,6 +37,8 @@ class TermStructureTest {
     static void testCreateWithNullUnderlying();
     static void testLinkToNullUnderlying();
     static void testCompositeZeroYieldStructures();
+    static void testBatchDiscount();
+    static void testBatchForwardRates();
     static boost::unit_test_framework::test_suite* suite();
 };
 